@@ -0,0 +1,8 @@
+#pragma once
+
+/* Loopback UART'ta (native_sim / qemu_cortex_m0 için uart-emul) uçtan uca
+ * ölçüm: ilk porttan CONFIG_APP_UART_LOOPBACK_BENCH_FRAMES tam boy frame
+ * gönderilir, aynı porttan geri okunur. Sonuç "BENCH PASS/FAIL" satırıyla
+ * loglanır. Tüm frame'ler sırayla ve eksiksiz geldiyse ve hız
+ * CONFIG_APP_UART_LOOPBACK_BENCH_MIN_FPS'in üstündeyse 0 döner. */
+int loopback_bench_run(void);
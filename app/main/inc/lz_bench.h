@@ -0,0 +1,8 @@
+#pragma once
+
+/* CONFIG_CUSTOM_UART_LZ ölçümü, UART gerekmez: örnek transferler (config
+ * metni, log satırları, sinüs tablosu, rastgele) uart_io_ctx_send_large() gibi
+ * parça parça sıkıştırılıp geri çözülür. Oran, KB başına CPU süresi ve
+ * 115200/921600 baud'da ham gönderime göre etkin hız loglanır. Tüm parçalar
+ * birebir geri çözüldüyse 0, aksi halde -EIO döner. */
+int lz_bench_run(void);
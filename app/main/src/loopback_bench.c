@@ -0,0 +1,138 @@
+#include <zephyr/kernel.h>
+
+#if IS_ENABLED(CONFIG_APP_UART_LOOPBACK_BENCH)
+#include <errno.h>
+#include <zephyr/sys/byteorder.h>
+
+#define APP_LOG_MODULE BENCH
+#include "logger.h"
+LOG_MODULE_REGISTER(APP_LOG_MODULE, APP_LOG_LEVEL);
+
+#include "loopback_bench.h"
+#include "uart_io.h"
+
+#define BENCH_FRAMES CONFIG_APP_UART_LOOPBACK_BENCH_FRAMES
+#define BENCH_SLEEP_MS CONFIG_APP_UART_LOOPBACK_BENCH_CB_SLEEP_MS
+
+/* Yavaş tüketici: callback uyur, gönderici cevapsız en çok BENCH_WINDOW frame
+ * tutar. Pencere havuzdan bir eksik: callback'i biten frame'in bloğu,
+ * kredisi verildikten hemen sonra boşalır. */
+#define BENCH_WINDOW (UART_MSGQ_DEPTH - 1)
+BUILD_ASSERT(BENCH_SLEEP_MS == 0 || BENCH_WINDOW >= 1, "slow-consumer bench needs a frame pool of 2+");
+
+/* DATA: seq(BE32) | gönderim zamanı (BE32 cycle) | seq'ten türeyen desen */
+#define BENCH_HDR 8
+BUILD_ASSERT(UART_MAX_PACKET_SIZE > BENCH_HDR, "frame too small for bench header");
+
+static K_SEM_DEFINE(bench_done, 0, 1);
+static K_SEM_DEFINE(bench_credit, 0, K_SEM_MAX_LIMIT);
+static uint32_t rx_cnt;
+static uint32_t rx_next;    /* beklenen seq */
+static uint32_t rx_bad;     /* sıra dışı, kısa veya desen hatalı frame */
+static uint32_t lat_max;    /* cycle */
+static uint64_t lat_sum;
+
+static void bench_fill(uint8_t *buf, uint32_t seq)
+{
+    sys_put_be32(seq, &buf[0]);
+    sys_put_be32(k_cycle_get_32(), &buf[4]);
+    for (size_t i = BENCH_HDR; i < UART_MAX_PACKET_SIZE; i++)
+        buf[i] = (uint8_t)(seq + i);
+}
+
+static bool bench_check(const uart_frame_t *f, uint32_t seq)
+{
+    if (f->len != UART_MAX_PACKET_SIZE || sys_get_be32(&f->data[0]) != seq)
+        return false;
+    for (size_t i = BENCH_HDR; i < UART_MAX_PACKET_SIZE; i++)
+        if (f->data[i] != (uint8_t)(seq + i))
+            return false;
+    return true;
+}
+
+static void bench_rx_frame(const uart_frame_t *frame)
+{
+    rx_cnt++;
+    if (!bench_check(frame, rx_next))
+    {
+        rx_bad++;
+        if (frame->len < BENCH_HDR)
+            return;
+    }
+    /* Kayıptan sonra sırayı gelen frame'den sürdür */
+    rx_next = sys_get_be32(&frame->data[0]) + 1;
+
+    uint32_t lat = k_cycle_get_32() - sys_get_be32(&frame->data[4]);
+    lat_sum += lat;
+    lat_max = MAX(lat_max, lat);
+    if (rx_next == BENCH_FRAMES)
+        k_sem_give(&bench_done);
+}
+
+/* uart_io_cb kuyruğunda çalışır; uyku yalnız bu kuyruğu durdurur */
+static void bench_rx_cb(uart_frame_t *frame)
+{
+    bench_rx_frame(frame);
+    if (BENCH_SLEEP_MS > 0)
+    {
+        k_msleep(BENCH_SLEEP_MS);
+        k_sem_give(&bench_credit);
+    }
+}
+
+int loopback_bench_run(void)
+{
+    static uint8_t buf[UART_MAX_PACKET_SIZE];
+    static uart_io_stats_t st;
+    uart_io_ctx_t *ctx = uart_io_ctx_get(0);
+    uint32_t tx_err = 0;
+
+    if (!ctx)
+        return -ENODEV;
+    uart_io_ctx_reset_stats(ctx);
+    k_sem_init(&bench_credit, BENCH_WINDOW, K_SEM_MAX_LIMIT);
+    uart_io_ctx_register_rx_cb(ctx, bench_rx_cb);
+
+    int64_t t0 = k_uptime_get();
+    for (uint32_t seq = 0; seq < BENCH_FRAMES; seq++)
+    {
+        /* Kayıp frame'in kredisi gelmez: pencere kapanınca gönderim biter */
+        if (BENCH_SLEEP_MS > 0 &&
+            k_sem_take(&bench_credit, K_SECONDS(CONFIG_APP_UART_LOOPBACK_BENCH_TIMEOUT_S)) != 0)
+        {
+            tx_err += BENCH_FRAMES - seq;
+            break;
+        }
+        bench_fill(buf, seq);
+        /* Slot boşalana kadar bekler: TX kuyruğu doluyken gönderici yavaşlar */
+        if (uart_io_ctx_send_frame_async(ctx, buf, sizeof(buf), NULL, NULL, K_MSEC(100)) != 0)
+            tx_err++;
+    }
+    bool timed_out = k_sem_take(&bench_done, K_SECONDS(CONFIG_APP_UART_LOOPBACK_BENCH_TIMEOUT_S)) != 0;
+    int64_t ms = MAX(k_uptime_get() - t0, 1);
+
+    uart_io_ctx_register_rx_cb(ctx, NULL);
+    (void)uart_io_ctx_get_stats(ctx, &st);
+
+    uint32_t rx = rx_cnt;
+    uint32_t fps = (uint32_t)((uint64_t)rx * 1000u / ms);
+    uint32_t us_per_cyc_div = MAX(st.cyc_per_sec / 1000000u, 1u);
+    uint32_t drops = BENCH_FRAMES - MIN(rx, BENCH_FRAMES);
+    uint32_t errs = st.cnt[UART_STAT_RX_CRC_ERR] + st.cnt[UART_STAT_RX_LEN_ERR] +
+                    st.cnt[UART_STAT_RX_DROP_BYTES] + st.cnt[UART_STAT_RX_POOL_EMPTY] +
+                    st.cnt[UART_STAT_RX_Q_FULL];
+
+    LOG_INFO("%s: %u/%u frames in %u ms, %u frames/s, %u B/s payload", uart_io_ctx_name(ctx),
+             rx, BENCH_FRAMES, (uint32_t)ms, fps, fps * UART_MAX_PACKET_SIZE);
+    LOG_INFO("latency avg %u us, max %u us; tx_err %u, bad %u, drops %u, rx errors %u",
+             (uint32_t)(lat_sum / MAX(rx, 1u) / us_per_cyc_div), lat_max / us_per_cyc_div,
+             tx_err, rx_bad, drops, errs);
+
+    bool pass = !timed_out && !tx_err && !rx_bad && !drops && !errs &&
+                fps >= CONFIG_APP_UART_LOOPBACK_BENCH_MIN_FPS;
+    if (!pass)
+        uart_io_ctx_dump_stats(ctx);
+    LOG_INFO("BENCH %s", pass ? "PASS" : "FAIL");
+    return pass ? 0 : -EIO;
+}
+#endif
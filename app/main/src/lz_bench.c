@@ -0,0 +1,188 @@
+#include <zephyr/kernel.h>
+
+#if IS_ENABLED(CONFIG_APP_UART_LZ_BENCH)
+#include <errno.h>
+#include <string.h>
+#include <zephyr/sys/printk.h>
+
+#define APP_LOG_MODULE LZBENCH
+#include "logger.h"
+LOG_MODULE_REGISTER(APP_LOG_MODULE, APP_LOG_LEVEL);
+
+#include "lz_bench.h"
+#include "uart_cfg.h"
+#include "lz.h"
+
+/* Örnek transfer boyu; küçük RAM'li kartlarda da sığsın diye 2 KB */
+#define LZ_BENCH_LEN  2048u
+#define LZ_BENCH_REPS 8u
+
+typedef enum { SAMPLE_CONFIG, SAMPLE_LOG, SAMPLE_LUT, SAMPLE_RANDOM, SAMPLE_COUNT } sample_id_t;
+
+static const char *const sample_names[SAMPLE_COUNT] = {"config", "log", "lut", "random"};
+static const uint32_t bench_bauds[] = {115200u, 921600u};
+
+static uint8_t src[LZ_BENCH_LEN];
+static uint8_t dec[LZ_BENCH_LEN];
+static uint8_t out[MAX(PAYLOAD_MAX, PAYLOAD_JUMBO_MAX)];
+static lz_enc_t enc;
+
+static size_t sample_fill(sample_id_t id, uint8_t *b, size_t cap)
+{
+    size_t n = 0;
+    uint32_t x = 1;
+
+    switch (id)
+    {
+    case SAMPLE_CONFIG:
+        for (int i = 0; n + 96 < cap; i++)
+            n += snprintk((char *)&b[n], cap - n,
+                          "sensor.%d.period_ms=%d\nsensor.%d.enabled=%s\nsensor.%d.name=\"ch%02d\"\n",
+                          i, 100 * (i % 7 + 1), i, (i % 3) ? "true" : "false", i, i);
+        return n;
+    case SAMPLE_LOG:
+        for (int i = 0; n + 96 < cap; i++)
+        {
+            x += 37u + (uint32_t)i % 13u;
+            n += snprintk((char *)&b[n], cap - n, "[%08u] <inf> uart_io: rx frame len=%d crc=%04X q=%d\n",
+                          x, 8 + i % 57, (i * 7919) & 0xFFFF, i % 4);
+        }
+        return n;
+    case SAMPLE_LUT:
+        /* 512 örnekli periyot, BE16; sinüs yerine parabol yaklaşımı (libm yok) */
+        for (uint32_t i = 0; n + 2 <= cap; i++)
+        {
+            int32_t p = (int32_t)(i % 256u);
+            int32_t v = 4 * p * (256 - p) * 32767 / 65536;
+            sys_put_be16((uint16_t)((i % 512u) < 256u ? v : -v), &b[n]);
+            n += 2;
+        }
+        return n;
+    case SAMPLE_RANDOM:
+        for (; n < cap; n++)
+        {
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+            b[n] = (uint8_t)x;
+        }
+        return n;
+    default:
+        return 0;
+    }
+}
+
+/* Parçanın kablodaki boyu: frame çerçevesi + seg header + taşınan bayt */
+static uint32_t wire_len(uint8_t typ, size_t plen)
+{
+    size_t data = seg_hdr_size(typ) + plen;
+#if IS_ENABLED(CONFIG_CUSTOM_UART_JUMBO)
+    if (data > UART_MAX_PACKET_SIZE)
+        return (uint32_t)(FRAME_JUMBO_OVERHEAD_BYTES + data);
+#endif
+    return (uint32_t)(FRAME_OVERHEAD_BYTES + data);
+}
+
+typedef struct
+{
+    uint32_t raw_wire, lz_wire;
+    uint64_t enc_cyc, dec_cyc;
+} bench_res_t;
+
+/* uart_send_large ile aynı kesim ve geri dönüş; dec'e alıcı gibi yerinde çözer */
+static int bench_one(const uint8_t *b, size_t n, uint8_t typ, bench_res_t *res)
+{
+    uint16_t seg = seg_payload_max(typ);
+
+    memset(res, 0, sizeof(*res));
+    for (uint32_t rep = 0; rep < LZ_BENCH_REPS; rep++)
+    {
+        uint32_t raw_wire = 0, lz_wire = 0;
+
+        lz_enc_begin(&enc, b);
+        for (size_t off = 0; off < n; off += seg)
+        {
+            size_t u = MIN((size_t)seg, n - off);
+
+            uint32_t t0 = k_cycle_get_32();
+            size_t c = lz_enc_block(&enc, off, u, out, u - 1u);
+            uint32_t t1 = k_cycle_get_32();
+
+            if (c)
+            {
+                if (lz_decompress(out, c, &dec[off], off, u) != (int)u)
+                    return -EIO;
+            }
+            else
+            {
+                memcpy(&dec[off], &b[off], u);
+            }
+            res->enc_cyc += t1 - t0;
+            res->dec_cyc += k_cycle_get_32() - t1;
+            raw_wire += wire_len(typ, u);
+            lz_wire += wire_len(c ? (typ | SEG_F_LZ) : typ, c ? c : u);
+        }
+        if (memcmp(dec, b, n) != 0)
+            return -EIO;
+        res->raw_wire = raw_wire;
+        res->lz_wire = lz_wire;
+    }
+    res->enc_cyc /= LZ_BENCH_REPS;
+    res->dec_cyc /= LZ_BENCH_REPS;
+    return 0;
+}
+
+static void bench_log(const char *name, size_t n, uint16_t seg, const bench_res_t *res)
+{
+    uint64_t hz = MAX(sys_clock_hw_cycles_per_sec(), 1u);
+    uint32_t enc_us = (uint32_t)(res->enc_cyc * 1000000u / hz);
+    uint32_t ratio = (uint32_t)((uint64_t)res->raw_wire * 100u / MAX(res->lz_wire, 1u));
+
+    LOG_INFO("%-6s seg %4u: %u B, wire %u -> %u (x%u.%02u), enc %u us/KB, dec %u us/KB", name, seg,
+             (uint32_t)n, res->raw_wire, res->lz_wire, ratio / 100u, ratio % 100u,
+             (uint32_t)(res->enc_cyc * 1000000u * 1024u / hz / n),
+             (uint32_t)(res->dec_cyc * 1000000u * 1024u / hz / n));
+
+    for (size_t i = 0; i < ARRAY_SIZE(bench_bauds); i++)
+    {
+        /* 8N1: bayt başına 10 bit. Kodlama DMA gönderimiyle örtüşür: darboğaz uzun olan */
+        uint64_t raw_us = (uint64_t)res->raw_wire * 10u * 1000000u / bench_bauds[i];
+        uint64_t lz_us = (uint64_t)res->lz_wire * 10u * 1000000u / bench_bauds[i];
+        uint64_t eff_us = MAX(MAX(lz_us, (uint64_t)enc_us), 1u);
+
+        LOG_INFO("  %6u baud: raw %u B/s, lz %u B/s, cpu %u%%", bench_bauds[i],
+                 (uint32_t)(n * 1000000u / MAX(raw_us, 1u)), (uint32_t)(n * 1000000u / eff_us),
+                 (uint32_t)((uint64_t)enc_us * 100u / MAX(lz_us, 1u)));
+    }
+}
+
+int lz_bench_run(void)
+{
+    static const uint8_t typs[] = {
+        SEG_TYP_DATA,
+#if IS_ENABLED(CONFIG_CUSTOM_UART_JUMBO)
+        SEG_TYP_DATA | SEG_F_JUMBO,
+#endif
+    };
+    bench_res_t res;
+    int ret = 0;
+
+    for (sample_id_t s = 0; s < SAMPLE_COUNT; s++)
+    {
+        size_t n = sample_fill(s, src, sizeof(src));
+
+        for (size_t k = 0; k < ARRAY_SIZE(typs); k++)
+        {
+            if (bench_one(src, n, typs[k], &res) != 0)
+            {
+                LOG_INFO("%s seg %u: roundtrip mismatch", sample_names[s], seg_payload_max(typs[k]));
+                ret = -EIO;
+                continue;
+            }
+            bench_log(sample_names[s], n, seg_payload_max(typs[k]), &res);
+        }
+    }
+    LOG_INFO("LZ BENCH %s", ret ? "FAIL" : "PASS");
+    return ret;
+}
+#endif
@@ -6,22 +6,40 @@
 LOG_MODULE_REGISTER(APP_LOG_MODULE, APP_LOG_LEVEL);
 
 #include "uart_io.h"
-#include "tlv.h"
+#include "tlv_registry.h"
+#include "loopback_bench.h"
+#include "lz_bench.h"
+
+static tlv_registry_t tlv_reg;
+
+/* [VERSION, 0] sorgusuna [VERSION, 2, major, minor] ile cevap verir */
+static void on_tlv_version(const tlv_view_t *v, void *user)
+{
+    ARG_UNUSED(v);
+    ARG_UNUSED(user);
+
+    const uint8_t reply[] = {TLV_ID_VERSION, 2, TLV_VERSION_MAJOR, TLV_VERSION_MINOR};
+    (void)uart_io_send_frame(reply, sizeof(reply), K_MSEC(200));
+}
+
+static void on_tlv_log(const tlv_view_t *v, void *user)
+{
+    ARG_UNUSED(user);
+
+    LOG_INFO("ID:%d LEN:%d", v->id, v->len);
+    LOG_HEXDUMP_INF(v->value, v->len, "TLV VALUE");
+}
 
 static void uart_rx_cb(uart_frame_t *frame)
 {
     if (!frame || frame->len == 0)
         return;
 
-    tlv_packet_t tlv_pack = {0};
-    int ret = tlv_decode(&tlv_pack, frame);
-    
-    LOG_INFO("ret:%d ", ret);
-
-    LOG_HEXDUMP_INF(tlv_pack.value, tlv_pack.len, "TLV VALUE");
-    LOG_INFO("ID:%d ", tlv_pack.id);
-    LOG_INFO("LEN:%d ", tlv_pack.len);
+    int ret = tlv_registry_dispatch(&tlv_reg, frame->data, frame->len);
+    if (ret < 0)
+        LOG_INFO("TLV id:%d dropped ret:%d", frame->data[0], ret);
 
+    /* uart_io_cb kuyruğunda çalışır: uyumak framing'i durdurmaz, sonraki frame'ler havuzda bekler */
     k_msleep(1000);
     // LOG_INFO("ECHO.");
     // const char echo[] = "This is an echo message!";
@@ -39,5 +57,20 @@ int main(void)
         LOG_INFO("UART initilaizing faild err=%d", ret);
     }
 
+#if IS_ENABLED(CONFIG_APP_UART_LOOPBACK_BENCH)
+    /* Loopback kartlarda (boards/native_sim, qemu_cortex_m0) önce uçtan uca ölçüm */
+    (void)loopback_bench_run();
+#endif
+#if IS_ENABLED(CONFIG_APP_UART_LZ_BENCH)
+    (void)lz_bench_run();
+#endif
+
+    tlv_registry_init(&tlv_reg);
+    (void)tlv_registry_set(&tlv_reg, TLV_ID_VERSION, on_tlv_version, NULL);
+    (void)tlv_registry_set(&tlv_reg, TLV_ID_LED, on_tlv_log, NULL);
+    (void)tlv_registry_set(&tlv_reg, TLV_ID_BUZZER, on_tlv_log, NULL);
+    (void)tlv_registry_set(&tlv_reg, TLV_ID_INFECTION_RISK, on_tlv_log, NULL);
+    (void)tlv_registry_set(&tlv_reg, TLV_ID_MEASUREMENT, on_tlv_log, NULL);
+
     uart_io_register_rx_cb(uart_rx_cb);
 }
\ No newline at end of file
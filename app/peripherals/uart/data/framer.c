@@ -4,25 +4,16 @@
 #include "crc16_ccitt.h"
 #include "uart_frame.h"
 
-K_MSGQ_DEFINE(uart_rx_msg_q, sizeof(uart_frame_t), 4, 4);
-
-
-typedef enum { PARSER_SYNC, PARSER_LEN, PARSER_DATA, PARSER_CRC_H, PARSER_CRC_L } parse_state_t;
-
-typedef struct
-{
-    parse_state_t st;
-    uint8_t len, pos, crc_hi_tmp;
-    uint16_t crc_calc;
-    uint16_t budget;      
-    bool drop_until_sync; 
-    uart_frame_t frame;
-} parser_t;
+/* DATA'yı tek parça tüket (memcpy + toplu CRC). 0 verilirse her bayt P[]
+ * üzerinden gider; test/host/bench_framer_len iki yolu böyle karşılaştırır. */
+#ifndef FRAMER_DATA_RUN
+#define FRAMER_DATA_RUN 1
+#endif
 
-static parser_t Q;
-static uint32_t stat_ok, stat_len_err, stat_crc_err, stat_budget = 0;
+/* Blok kendi slab'ını taşır; release hangi instance'tan geldiğini aramaz */
+BUILD_ASSERT(FRAMER_BLOCK_SIZE >= sizeof(frame_blk_t), "FRAMER_BLOCK_SIZE too small");
 
-static inline void q_reset(parser_t *p)
+static inline void q_reset(framer_t *p)
 {
     p->st = PARSER_SYNC;
     p->len = p->pos = p->crc_hi_tmp = 0;
@@ -30,87 +21,257 @@ static inline void q_reset(parser_t *p)
     p->budget = 0;
     p->drop_until_sync = false;
 }
-static inline void q_start(parser_t *p)
+#if IS_ENABLED(CONFIG_CUSTOM_UART_JUMBO)
+static inline bool q_is_sync(uint8_t b) { return b == SYNC_BYTE || b == SYNC_BYTE_JUMBO; }
+static inline bool q_jumbo(const framer_t *p) { return p->jumbo; }
+#else
+static inline bool q_is_sync(uint8_t b) { return b == SYNC_BYTE; }
+static inline bool q_jumbo(const framer_t *p) { ARG_UNUSED(p); return false; }
+#endif
+
+/* SYNC'ten sonraki LEN alanı: klasik 1, jumbo 2 bayt */
+static inline uint16_t q_len_bytes(const framer_t *p) { return q_jumbo(p) ? 2u : 1u; }
+
+/* İlk SYNC adayı (klasik veya jumbo); memchr tabanlı */
+static inline const uint8_t *q_find_sync(const uint8_t *b, size_t n)
 {
+    const uint8_t *s = memchr(b, SYNC_BYTE, n);
+#if IS_ENABLED(CONFIG_CUSTOM_UART_JUMBO)
+    const uint8_t *j = memchr(b, SYNC_BYTE_JUMBO, s ? (size_t)(s - b) : n);
+    if (j)
+        s = j;
+#endif
+    return s;
+}
+
+static inline void q_start(framer_t *p, uint8_t sync)
+{
+    ARG_UNUSED(sync);
     p->st = PARSER_LEN;
     p->len = p->pos = p->crc_hi_tmp = 0;
-    p->crc_calc = 0xFFFF;
+    p->crc_calc = UART_CRC_INT;
     p->budget = 1; /* SYNC okundu */
+#if IS_ENABLED(CONFIG_CUSTOM_UART_JUMBO)
+    p->jumbo = (sync == SYNC_BYTE_JUMBO);
+    if (p->jumbo)
+        p->st = PARSER_LEN_H;
+#endif
+#if IS_ENABLED(CONFIG_CUSTOM_UART_COBS)
+    p->cobs_left = 0;
+    p->cobs_zero = false;
+#endif
+}
+
+/* Yarım bir frame var mı (kesilirse kayıp sayılır) */
+static inline bool q_in_frame(const framer_t *p)
+{
+    if (p->drop_until_sync || p->st == PARSER_SYNC)
+        return false;
+#if IS_ENABLED(CONFIG_CUSTOM_UART_COBS)
+    /* Ayraçtan sonra LEN beklerken henüz frame başlamamıştır */
+    return p->st != PARSER_LEN || p->cobs_left || p->cobs_zero;
+#else
+    return true;
+#endif
 }
 
 /* Hata olduğunda hızlı toparlanma: bir SYNC görene kadar at */
-static inline void set_resync(parser_t *p)
+static inline void set_resync(framer_t *p)
 {
     p->drop_until_sync = true;
     p->st = PARSER_SYNC;
 }
 
-static void q_push_sync(parser_t *p, uint8_t b)
+#if IS_ENABLED(CONFIG_CUSTOM_UART_RX_BACKTRACK)
+/* LEN/CRC/budget hatası: aday yanlış bir SYNC'ten başlamış olabilir. Tüketilen
+ * baytlar (LEN, DATA, CRC) içinde gerçek SYNC varsa kaybolmasın; back_n pencere
+ * boyunu işaretler, push döngüsü durup pencereyi doldurur ve yeniden tarar. */
+static void q_fail(framer_t *p, uart_stat_id_t err, uint16_t n)
+{
+    uart_stat_inc(p->stats, err);
+    p->back_n = n;
+    set_resync(p);
+}
+#else
+static inline void q_fail(framer_t *p, uart_stat_id_t err, uint16_t n)
+{
+    ARG_UNUSED(n);
+    uart_stat_inc(p->stats, err);
+    set_resync(p);
+}
+#endif
+
+static void q_push_sync(framer_t *p, uint8_t b)
 {
-    if (b == SYNC_BYTE) q_start(p);
+    if (q_is_sync(b)) q_start(p, b);
+}
+
+/* Jumbo LEN'in yüksek baytı; alt bayt PARSER_LEN'de birleşir */
+static void q_push_len_h(framer_t *p, uint8_t b)
+{
+    p->budget++;
+    p->len = (uint16_t)b << 8;
+    p->crc_calc = crc16_ccitt_step(p->crc_calc, b);
+    p->st = PARSER_LEN;
 }
 
-static void q_push_len(parser_t *p, uint8_t b)
+static void q_push_len(framer_t *p, uint8_t b)
 {
     p->budget++;
-    if (b == 0 || b > UART_MAX_PACKET_SIZE) { stat_len_err++; set_resync(p); return; }
-    p->len = b; p->frame.len = b;
-    p->crc_calc = crc16_ccitt_step(UART_CRC_INT, b); /* LEN dahil */
+    uint16_t len = q_jumbo(p) ? (uint16_t)(p->len | b) : b;
+    uint16_t max = q_jumbo(p) ? UART_FRAME_LEN_MAX : UART_MAX_PACKET_SIZE;
+    if (len == 0 || len > max) { q_fail(p, UART_STAT_RX_LEN_ERR, q_len_bytes(p)); return; }
+    if (!p->frame)
+    {
+        void *blk;
+        if (k_mem_slab_alloc(p->slab, &blk, K_NO_WAIT) != 0)
+        {
+            /* Havuz tükendi: tüketici blokları bırakana kadar çerçeveler düşer */
+            uart_stat_inc(p->stats, UART_STAT_RX_POOL_EMPTY);
+#if IS_ENABLED(CONFIG_CUSTOM_UART_COBS)
+            set_resync(p);
+#else
+            /* LEN biliniyor: frame'i bütün olarak atla, DATA içindeki SYNC'e takılma */
+            p->len = len;
+            p->st = PARSER_SKIP;
+#endif
+            return;
+        }
+        ((frame_blk_t *)blk)->slab = p->slab;
+        p->frame = &((frame_blk_t *)blk)->frame;
+    }
+    p->len = len; p->frame->len = (uart_frame_len_t)len;
+    p->crc_calc = crc16_ccitt_step(p->crc_calc, b); /* LEN dahil */
     p->pos = 0; p->st = PARSER_DATA;
 }
 
-static void q_push_data(parser_t *p, uint8_t b)
+static void q_push_data(framer_t *p, uint8_t b)
 {
     p->budget++;
-    p->frame.data[p->pos++] = b;
+    p->frame->data[p->pos++] = b;
     p->crc_calc = crc16_ccitt_step(p->crc_calc, b);
     if (p->pos == p->len) p->st = PARSER_CRC_H;
-    if (p->budget > (uint16_t)(1 + 1 + UART_MAX_PACKET_SIZE + 2)) { stat_budget++; set_resync(p); }
+    if (p->budget > (uint16_t)FRAME_MAX_TOTAL) { q_fail(p, UART_STAT_RX_BUDGET_ERR, q_len_bytes(p) + p->pos); }
 }
 
-static void q_push_crc(parser_t *p, uint8_t b)
+static void q_push_skip(framer_t *p, uint8_t b)
+{
+    ARG_UNUSED(b);
+    /* budget SYNC+LEN'i saydı; DATA + CRC(2) bitince frame sınırındayız */
+    if (++p->budget == (uint16_t)(1 + q_len_bytes(p) + p->len + 2))
+        q_reset(p);
+}
+
+static void q_push_crc(framer_t *p, uint8_t b)
 {
     p->budget++;
     p->crc_hi_tmp = b; p->st = PARSER_CRC_L;
 }
 
-static void q_push_l(parser_t *p, uint8_t b)
+static void q_deliver(framer_t *p)
+{
+    uart_frame_t *f = p->frame;
+    frame_blk_t *blk = CONTAINER_OF(f, frame_blk_t, frame);
+    atomic_set(&blk->ref, 1); /* kuyruğun/dispatch'in referansı */
+    blk->t_rx = p->t_rx;
+    p->frame = NULL;
+    if (k_msgq_put(p->msgq, &f, K_NO_WAIT) != 0)
+    {
+        /* Kuyruk derinliği havuz kadar; buraya düşmemeli */
+        uart_stat_inc(p->stats, UART_STAT_RX_Q_FULL);
+        k_mem_slab_free(blk->slab, blk);
+        return;
+    }
+    uart_stat_max(p->stats, UART_STAT_RXQ_HWM, k_msgq_num_used_get(p->msgq));
+}
+
+#if IS_ENABLED(CONFIG_CUSTOM_UART_RX_OVF_PRIORITY)
+/* Son UART_RX_PRIO_RESERVE blok düşük öncelikli TLV id'lerine verilmez;
+ * blok p->frame'de kalır ve sonraki frame için yeniden kullanılır */
+static bool q_admit(framer_t *p)
+{
+    if (p->frame->data[0] < UART_RX_PRIO_LOW_ID_MIN ||
+        k_mem_slab_num_free_get(p->slab) >= UART_RX_PRIO_RESERVE)
+        return true;
+    uart_stat_inc(p->stats, UART_STAT_RX_PRIO_DROP);
+    return false;
+}
+#else
+static inline bool q_admit(framer_t *p) { ARG_UNUSED(p); return true; }
+#endif
+
+static void q_push_l(framer_t *p, uint8_t b)
 {
     p->budget++;
     uint16_t recv_crc = ((uint16_t)p->crc_hi_tmp << 8) | b;
-    if (recv_crc == p->crc_calc) { (void)k_msgq_put(&uart_rx_msg_q, &p->frame, K_NO_WAIT); stat_ok++; }
-    else { stat_crc_err++; }
+    if (recv_crc != p->crc_calc) { q_fail(p, UART_STAT_RX_CRC_ERR, q_len_bytes(p) + p->len + 2); return; }
+    if (q_admit(p)) { q_deliver(p); uart_stat_inc(p->stats, UART_STAT_RX_FRAMES); }
     q_reset(p);
 }
 
-typedef void (*q_push_byte_fn_t)(parser_t *p, uint8_t b);
+/* DATA toplu yolu: LEN bilindikten sonra kalan payload'ı girişten tek seferde
+ * kopyala ve CRC'yi tüm aralık üzerinde güncelle. Tüketilen bayt sayısını döner. */
+static size_t q_push_data_run(framer_t *p, const uint8_t *b, size_t n)
+{
+    size_t run = MIN(n, (size_t)(p->len - p->pos));
+
+#if IS_ENABLED(CONFIG_CUSTOM_UART_COBS)
+    /* Yalnızca açık bloğun düz baytları; ayraç/kod baytı tekli yoldan */
+    run = MIN(run, (size_t)p->cobs_left);
+    const uint8_t *z = memchr(b, COBS_DELIM, run);
+    if (z)
+        run = (size_t)(z - b);
+    if (!run)
+        return 0;
+    p->cobs_left -= (uint8_t)run;
+#elif defined(ALLOW_MIDFRAME_SYNC_RESTART)
+    /* SYNC'te durmalı; o bayt tekli yoldan işlenir */
+    const uint8_t *s = q_find_sync(b, run);
+    if (s)
+        run = (size_t)(s - b);
+    if (!run)
+        return 0;
+#endif
+
+    memcpy(&p->frame->data[p->pos], b, run);
+    p->crc_calc = crc16_ccitt_update(p->crc_calc, b, run);
+    p->pos += (uint16_t)run;
+    p->budget += (uint16_t)run;
+    if (p->pos == p->len) p->st = PARSER_CRC_H;
+    return run;
+}
+
+typedef void (*q_push_byte_fn_t)(framer_t *p, uint8_t b);
 static const q_push_byte_fn_t P[] = {
     [PARSER_SYNC] = q_push_sync,
     [PARSER_LEN] = q_push_len,
     [PARSER_DATA] = q_push_data,
     [PARSER_CRC_H] = q_push_crc,
     [PARSER_CRC_L] = q_push_l,
+    [PARSER_SKIP] = q_push_skip,
+    [PARSER_LEN_H] = q_push_len_h,
 };
 
+#if !IS_ENABLED(CONFIG_CUSTOM_UART_COBS)
 /* Tek bayt ilerlet (korumalarla) */
-static void q_push_byte(parser_t *p, uint8_t b)
+static void q_push_byte(framer_t *p, uint8_t b)
 {
     /* Hızlı yeniden senkron modu: SYNC’e kadar at */
     if (p->drop_until_sync)
     {
-        if (b == SYNC_BYTE)
+        if (q_is_sync(b))
         {
             p->drop_until_sync = false;
-            q_start(p);
+            q_start(p, b);
         }
         return;
     }
 
 #ifdef ALLOW_MIDFRAME_SYNC_RESTART
-    if (p->st != PARSER_SYNC && b == SYNC_BYTE)
+    if (p->st != PARSER_SYNC && q_is_sync(b))
     {
         /* Orta akışta SYNC: mevcut çerçeveyi iptal edip yeniye başla */
-        q_start(p);
+        q_start(p, b);
         return;
     }
 #endif
@@ -125,22 +286,192 @@ static void q_push_byte(parser_t *p, uint8_t b)
     }
 }
 
-void framer_init(void) { q_reset(&Q); }
-void framer_reset(void) { q_reset(&Q); }
+static void q_ready(framer_t *p) { q_reset(p); }
+
+#else /* CONFIG_CUSTOM_UART_COBS */
+
+/* COBS akış çözücü: çözülen baytlar SYNC'siz aynı durum makinesine (LEN..CRC_L)
+ * girer. 0x00 her zaman frame sınırıdır; bozuk bir frame en geç bir sonraki
+ * ayraçta biter, yani yeniden senkron en fazla bir frame sürer. */
+static void q_push_cobs(framer_t *p, uint8_t b)
+{
+    if (b == COBS_DELIM)
+    {
+        /* Frame ortasında ayraç: kesik frame */
+        if (q_in_frame(p))
+            uart_stat_inc(p->stats, UART_STAT_RX_COBS_ERR);
+        p->drop_until_sync = false;
+        q_start(p, SYNC_BYTE);
+        return;
+    }
+    if (p->drop_until_sync || p->st == PARSER_SYNC)
+        return; /* teslim edilmiş/bozuk frame'in kalanı: ayraca kadar at */
+
+    if (p->cobs_left == 0)
+    {
+        /* Kod baytı: önceki blok 0xFF değilse arada bir sıfır vardı */
+        bool zero = p->cobs_zero;
+        p->cobs_left = b - 1;
+        p->cobs_zero = (b != 0xFF);
+        if (zero)
+            P[p->st](p, 0);
+        return;
+    }
+    p->cobs_left--;
+    P[p->st](p, b);
+}
+
+static void q_ready(framer_t *p)
+{
+    q_reset(p);
+    q_start(p, SYNC_BYTE); /* sıfırlamadan sonra ilk bayt frame başı kabul edilir */
+}
+#endif
 
-void framer_push_bytes(const uint8_t *buf, size_t len)
+void framer_init(framer_t *fr, struct k_mem_slab *slab, struct k_msgq *msgq, uart_stats_t *stats)
 {
-    for (size_t i = 0; i < len; i++)
-        q_push_byte(&Q, buf[i]);
+    memset(fr, 0, sizeof(*fr));
+    fr->slab = slab;
+    fr->msgq = msgq;
+    fr->stats = stats;
+    q_ready(fr);
+}
+
+uart_frame_t *framer_frame_ref(uart_frame_t *frame)
+{
+    if (frame)
+        atomic_inc(&CONTAINER_OF(frame, frame_blk_t, frame)->ref);
+    return frame;
+}
+
+void framer_frame_release(uart_frame_t *frame)
+{
+    if (!frame)
+        return;
+    frame_blk_t *blk = CONTAINER_OF(frame, frame_blk_t, frame);
+    if (atomic_dec(&blk->ref) == 1)
+        k_mem_slab_free(blk->slab, blk);
+}
+
+void framer_reset(framer_t *fr) { q_ready(fr); }
+
+void framer_discard(framer_t *fr)
+{
+    if (q_in_frame(fr))
+        uart_stat_inc(fr->stats, UART_STAT_RX_OVF_CUT);
+    q_reset(fr);
+    set_resync(fr); /* COBS: ayraca, değilse SYNC'e kadar at */
+}
+
+/* Baytları parser'a ver; backtrack açıksa başarısız bir adayda durur.
+ * Tüketilen bayt sayısını döner. */
+static size_t q_feed(framer_t *fr, const uint8_t *buf, size_t len)
+{
+    size_t i = 0;
+    while (i < len)
+    {
+#if !IS_ENABLED(CONFIG_CUSTOM_UART_COBS)
+        /* SYNC arayışı: bayt bayt dispatch yerine memchr ile atla */
+        if (fr->st == PARSER_SYNC || fr->drop_until_sync)
+        {
+            const uint8_t *s = q_find_sync(&buf[i], len - i);
+            if (!s)
+                return len;
+            i = (size_t)(s - buf);
+        }
+#endif
+        /* Çerçeve sınırları (SYNC/LEN/CRC) bayt bayt; DATA tek parça */
+        size_t used = 0;
+        if (FRAMER_DATA_RUN && fr->st == PARSER_DATA && !fr->drop_until_sync)
+            used = q_push_data_run(fr, &buf[i], len - i);
+
+        if (used)
+            i += used;
+        else
+#if IS_ENABLED(CONFIG_CUSTOM_UART_COBS)
+            q_push_cobs(fr, buf[i++]);
+#else
+            q_push_byte(fr, buf[i++]);
+#endif
+#if IS_ENABLED(CONFIG_CUSTOM_UART_RX_BACKTRACK)
+        if (fr->back_n)
+            break;
+#endif
+    }
+    return i;
 }
 
+#if IS_ENABLED(CONFIG_CUSTOM_UART_RX_BACKTRACK)
+/* Başarısız adayın baytlarını parser durumundan pencereye topla: [LEN] veya
+ * [LEN DATA(pos)] (budget) veya [LEN DATA CRC_H CRC_L]; jumbo'da LEN iki bayt.
+ * last: son tüketilen bayt. */
+static void q_back_fill(framer_t *p, uint8_t last)
+{
+    uint16_t n = p->back_n;
+    uint16_t h = q_len_bytes(p);
 
-#define APP_LOG_MODULE UART_FRAMER
-#include "logger.h"
-LOG_MODULE_REGISTER(APP_LOG_MODULE, APP_LOG_LEVEL);
-void framer_dump_stats(void)
+    if (n == h)
+    {
+        /* LEN hatası: LEN henüz p->len'e yazılmadı; jumbo'da yüksek bayt orada */
+        if (h == 2)
+            p->back[0] = (uint8_t)(p->len >> 8);
+        p->back[h - 1] = last;
+        return;
+    }
+    if (h == 2)
+        sys_put_be16(p->len, p->back);
+    else
+        p->back[0] = (uint8_t)p->len;
+    memcpy(&p->back[h], p->frame->data, MIN((size_t)(n - h), (size_t)p->len));
+    if (n == (uint16_t)(h + p->len + 2))
+    {
+        p->back[h + p->len] = p->crc_hi_tmp;
+        p->back[h + p->len + 1] = last;
+    }
+}
+
+/* Pencereyi yeniden tara: ilk SYNC adayından itibaren parser'a ver. Yeni aday da
+ * pencere içinde düşerse yalnızca onun SYNC'inden sonrası aynı şekilde taranır:
+ * aradaki teslim edilmiş frame'lerin baytlarına geri dönülmez. Pencere her
+ * turda en az bir bayt kısalır. */
+static void q_rescan(framer_t *p)
 {
-    LOG_INFO("[FRAMER] ok=%u len_err=%u crc_err=%u budget=%u",
-           stat_ok, stat_len_err, stat_crc_err, stat_budget);
+    while (p->back_n)
+    {
+        size_t n = p->back_n;
+        p->back_n = 0;
+
+        const uint8_t *s = q_find_sync(p->back, n);
+        if (!s)
+            return; /* aday yok: drop_until_sync sürer */
+        size_t off = (size_t)(s - p->back) + 1;
+        p->drop_until_sync = false;
+        q_start(p, *s);
+        size_t used = q_feed(p, &p->back[off], n - off);
+        if (p->back_n)
+        {
+            /* Düşen adayın SYNC'i back[start - 1]; baytları back[start..off + used),
+             * ardından henüz beslenmemiş kalan gelir */
+            size_t start = off + used - p->back_n;
+            memmove(p->back, &p->back[start], n - start);
+            p->back_n = (uint16_t)(n - start);
+        }
+    }
 }
+#endif
 
+void framer_push_bytes(framer_t *fr, const uint8_t *buf, size_t len)
+{
+    size_t i = 0;
+    while (i < len)
+    {
+        i += q_feed(fr, &buf[i], len - i);
+#if IS_ENABLED(CONFIG_CUSTOM_UART_RX_BACKTRACK)
+        if (fr->back_n)
+        {
+            q_back_fill(fr, buf[i - 1]);
+            q_rescan(fr);
+        }
+#endif
+    }
+}
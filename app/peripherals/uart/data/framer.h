@@ -1,18 +1,64 @@
 #pragma once
-#include <zephyr/kernel.h>
 #include <stdbool.h>
 
+#include "uart_os.h"
+#include "uart_frame.h"
+#include "uart_stats.h"
 
-/* (Opsiyonel) DATA içinde SYNC görülürse yeni frame başlat (ESC/COBS yoksa kapalı tutmak daha güvenli) */
+
+/* (Opsiyonel) DATA içinde SYNC görülürse yeni frame başlat (ESC/COBS yoksa kapalı tutmak daha güvenli).
+ * CONFIG_CUSTOM_UART_COBS ile gereksiz: 0x00 ayracı veride geçemez, her ayraç frame sınırıdır. */
 // #define ALLOW_MIDFRAME_SYNC_RESTART 1
 
 
-extern struct k_msgq uart_rx_msg_q;
-extern struct k_work_poll uart_rx_wp;
-extern struct k_poll_event uart_rx_pe;
+typedef enum { PARSER_SYNC, PARSER_LEN, PARSER_DATA, PARSER_CRC_H, PARSER_CRC_L, PARSER_SKIP, PARSER_LEN_H } parse_state_t;
+
+/* Havuz bloğu: parser frame'i yerinde doldurur, kuyruktan yalnızca pointer geçer */
+typedef struct
+{
+    atomic_t ref;
+    struct k_mem_slab *slab;
+    uint32_t t_rx;        /* frame'in son baytlarını getiren RX_RDY zamanı (cycle) */
+    uart_frame_t frame;
+} frame_blk_t;
+
+#define FRAMER_BLOCK_SIZE ROUND_UP(sizeof(frame_blk_t), 4)
+
+/* Port başına bir parser; havuz ve kuyruk instance ile birlikte tanımlanır
+ * (slab: FRAMER_BLOCK_SIZE bloklar, msgq: uart_frame_t* elemanlar) */
+typedef struct
+{
+    parse_state_t st;
+    uint16_t len, pos;
+    uint8_t crc_hi_tmp;
+    uint16_t crc_calc;
+    uint16_t budget;
+    bool drop_until_sync;
+#if IS_ENABLED(CONFIG_CUSTOM_UART_JUMBO)
+    bool jumbo;           /* SYNC_BYTE_JUMBO: LEN iki bayt (PARSER_LEN_H → PARSER_LEN) */
+#endif
+    uart_frame_t *frame;  /* havuzdan alınan blok; başarısız çerçevede yeniden kullanılır */
+#if IS_ENABLED(CONFIG_CUSTOM_UART_COBS)
+    uint8_t cobs_left;    /* açık COBS bloğunda kalan düz bayt */
+    bool cobs_zero;       /* blok bitince araya sıfır eklenecek (kod != 0xFF) */
+#endif
+#if IS_ENABLED(CONFIG_CUSTOM_UART_RX_BACKTRACK)
+    uint16_t back_n;                /* != 0: yanlış SYNC, back[0..back_n) yeniden taranacak */
+    uint8_t back[FRAME_MAX_TOTAL];  /* başarısız adayın SYNC sonrası baytları */
+#endif
+    struct k_mem_slab *slab;
+    struct k_msgq *msgq;
+    uart_stats_t *stats;  /* port sayaçları (uart_io ctx) */
+    uint32_t t_rx;        /* beslenen parçanın RX_RDY zamanı; teslim edilen bloğa yazılır */
+} framer_t;
 
-void framer_init(void);
-void framer_reset(void);
-void framer_dump_stats(void);
-void framer_push_bytes(const uint8_t *buf, size_t len);
+void framer_init(framer_t *fr, struct k_mem_slab *slab, struct k_msgq *msgq, uart_stats_t *stats);
+void framer_reset(framer_t *fr);
+/* Akışta kesinti (RX taşması): yarım frame atılır, sonraki sınırdan devam edilir */
+void framer_discard(framer_t *fr);
+void framer_push_bytes(framer_t *fr, const uint8_t *buf, size_t len);
 
+/* msgq, havuzdaki bloklara işaret eden uart_frame_t* taşır.
+ * Her referans framer_frame_release() ile bırakılmalıdır. */
+uart_frame_t *framer_frame_ref(uart_frame_t *frame);
+void framer_frame_release(uart_frame_t *frame);
@@ -0,0 +1,229 @@
+#include <errno.h>
+#include <string.h>
+
+#include "uart_os.h"
+#include "seg_reasm.h"
+#include "uart_cfg.h"
+#include "lz.h"
+
+#if IS_ENABLED(CONFIG_CUSTOM_UART_REASM)
+
+/* Sıralı gelen güvenilir parçalarda her N parçada bir ACK */
+#define REASM_ACK_EVERY MAX(1, UART_REL_WINDOW / 2)
+
+static inline bool seg_test(const reasm_slot_t *r, uint16_t idx)
+{
+    return idx < r->nsegs && (r->bitmap[idx / 32] & BIT(idx % 32));
+}
+
+static inline void slot_open(reasm_slot_t *r, uint8_t xid, uint16_t total, uint16_t seg, bool rel)
+{
+    r->st = SLOT_ACTIVE;
+    r->rel = rel;
+    r->xid = xid;
+    r->total = total;
+    r->seg = seg;
+    r->nsegs = DIV_ROUND_UP(total, seg);
+    r->got = r->cum = r->since_ack = 0;
+    memset(r->bitmap, 0, sizeof(r->bitmap));
+}
+
+/* xid'e ait slotu bul; yoksa boş (veya bitmiş) slot aç. Süresi dolanları yol üstünde temizle */
+static reasm_slot_t *slot_get(seg_reasm_t *ra, uint8_t xid, uint16_t total, uint16_t seg, bool rel, uint32_t now)
+{
+    reasm_slot_t *free_slot = NULL;
+
+    for (uint8_t i = 0; i < ra->nslots; i++)
+    {
+        reasm_slot_t *r = &ra->slots[i];
+        if (r->st != SLOT_FREE && (now - r->last_ms) > UART_REASM_TIMEOUT_MS)
+        {
+            if (r->st == SLOT_ACTIVE)
+                uart_stat_inc(ra->stats, UART_STAT_REASM_TIMEOUT);
+            r->st = SLOT_FREE;
+        }
+        if (r->st != SLOT_FREE && r->xid == xid)
+        {
+            /* Aynı xid farklı boyut/parça boyuyla ya da bitmiş güvenilir olmayan: yeni transfer */
+            if (r->total != total || r->seg != seg || (r->st == SLOT_DONE && !rel))
+                slot_open(r, xid, total, seg, rel);
+            return r;
+        }
+        if (r->st != SLOT_ACTIVE && (!free_slot || free_slot->st == SLOT_DONE))
+            free_slot = r;
+    }
+
+    if (free_slot)
+        slot_open(free_slot, xid, total, seg, rel);
+    return free_slot;
+}
+
+static void send_ack(seg_reasm_t *ra, reasm_slot_t *r)
+{
+    uint8_t ack[SEG_HDR_SIZE + SEG_ACK_BITMAP_SIZE];
+    uint32_t sack = 0;
+
+    for (uint16_t i = 0; i < 32; i++)
+    {
+        if (seg_test(r, r->cum + 1 + i))
+            sack |= BIT(i);
+    }
+    seg_hdr_write(ack, SEG_TYP_ACK, r->xid, r->total,
+                  (uint16_t)MIN((uint32_t)r->cum * r->seg, r->total), SEG_ACK_BITMAP_SIZE);
+    sys_put_be32(sack, &ack[SEG_HDR_SIZE]);
+
+    r->since_ack = 0;
+    uart_stat_inc(ra->stats, UART_STAT_REASM_ACKS);
+    if (ra->ack_fn)
+        ra->ack_fn(ra->ack_user, ack, sizeof(ack));
+}
+
+void seg_reasm_init(seg_reasm_t *ra, reasm_slot_t *slots, uint8_t nslots, uart_stats_t *stats)
+{
+    memset(ra, 0, sizeof(*ra));
+    memset(slots, 0, nslots * sizeof(*slots));
+    ra->slots = slots;
+    ra->nslots = nslots;
+    ra->stats = stats;
+}
+
+void seg_reasm_set_cb(seg_reasm_t *ra, seg_reasm_done_fn_t cb)
+{
+    ra->done_cb = cb;
+}
+
+void seg_reasm_set_ack_fn(seg_reasm_t *ra, seg_reasm_ack_fn_t fn, void *user)
+{
+    ra->ack_fn = fn;
+    ra->ack_user = user;
+}
+
+bool seg_reasm_active(const seg_reasm_t *ra)
+{
+    return ra->done_cb != NULL && ra->nslots > 0;
+}
+
+int seg_reasm_push(seg_reasm_t *ra, const uint8_t *data, size_t len)
+{
+    uint8_t typ, xid;
+    uint16_t total, offset, clen;
+
+    if (len < SEG_HDR_SIZE || len < seg_hdr_size(data[0]))
+        return -ENOMSG;
+    size_t hl = seg_hdr_read(data, &typ, &xid, &total, &offset, &clen);
+    if ((typ & SEG_TYP_MASK) != SEG_TYP_DATA || clen != len - hl || (uint32_t)offset + clen > total)
+        return -ENOMSG;
+
+    /* Buradan sonra frame segment sayılır; geçersizse düşer */
+    if (total > UART_REASM_MAX_SIZE)
+    {
+        uart_stat_inc(ra->stats, UART_STAT_REASM_TOO_BIG);
+        return 0;
+    }
+
+    /* SEG_F_LZ: clen sıkışık boy; parça yine seg hizalı ulen ham bayt taşır */
+    /* Jumbo'suz yapıda jumbo parça boyu PAYLOAD_MAX'tan küçüktür, bitmap'e sığmaz */
+    uint16_t seg = seg_payload_max(typ);
+    bool lz = (typ & SEG_F_LZ) != 0;
+    uint16_t ulen = lz ? (uint16_t)MIN(seg, total - offset) : clen;
+    bool last = (offset + ulen == total);
+    if (((typ & SEG_F_JUMBO) && !IS_ENABLED(CONFIG_CUSTOM_UART_JUMBO)) ||
+        offset % seg || clen == 0 || (!last && ulen != seg))
+    {
+        uart_stat_inc(ra->stats, UART_STAT_REASM_BAD);
+        return 0;
+    }
+
+    bool rel = (typ & SEG_F_ACKREQ) != 0;
+    uint32_t now = k_uptime_get_32();
+    reasm_slot_t *r = slot_get(ra, xid, total, seg, rel, now);
+    if (!r)
+    {
+        uart_stat_inc(ra->stats, UART_STAT_REASM_NO_SLOT);
+        return 0;
+    }
+    r->last_ms = now;
+
+    uint16_t idx = offset / seg;
+    if (r->st == SLOT_DONE || seg_test(r, idx))
+    {
+        /* Tekrar: gönderici ACK'imizi kaçırmış olabilir */
+        uart_stat_inc(ra->stats, UART_STAT_REASM_DUP);
+        if (r->rel)
+            send_ack(ra, r);
+        return 0;
+    }
+    if (lz)
+    {
+        /* Geçmiş buf[0..offset): önceki parçaların hepsi gelmiş olmalı. Sırasız
+         * parça işaretlenmez; güvenilir modda seçici ACK yeniden gönderdirir. */
+        if (!IS_ENABLED(CONFIG_CUSTOM_UART_LZ) || idx != r->cum ||
+            lz_decompress(&data[hl], clen, &r->buf[offset], offset, ulen) != ulen)
+        {
+            uart_stat_inc(ra->stats, UART_STAT_REASM_LZ_ERR);
+            return 0;
+        }
+    }
+    else
+    {
+        memcpy(&r->buf[offset], &data[hl], clen);
+    }
+    r->bitmap[idx / 32] |= BIT(idx % 32);
+    r->got++;
+    r->since_ack++;
+
+    bool gap = (idx != r->cum);
+    uint16_t old_cum = r->cum;
+    while (seg_test(r, r->cum))
+        r->cum++;
+    bool filled = (r->cum > old_cum + 1u);
+
+    if (r->got == r->nsegs)
+    {
+        uart_stat_inc(ra->stats, UART_STAT_REASM_DONE);
+        r->st = r->rel ? SLOT_DONE : SLOT_FREE;
+        if (r->rel)
+            send_ack(ra, r);
+        if (ra->done_cb)
+            ra->done_cb(r->xid, r->buf, r->total);
+    }
+    else if (r->rel && (gap || filled || r->since_ack >= REASM_ACK_EVERY))
+    {
+        /* Sırasız parça = arada kayıp: seçici ACK hemen gider. Deliği kapatan
+         * parça da beklenmeden ACK'lenir; yoksa gönderici RTO'da zaten
+         * alınmış parçaları tekrar yollar. */
+        send_ack(ra, r);
+    }
+    return 0;
+}
+
+#else /* !CONFIG_CUSTOM_UART_REASM */
+
+void seg_reasm_init(seg_reasm_t *ra, reasm_slot_t *slots, uint8_t nslots, uart_stats_t *stats)
+{
+    ARG_UNUSED(slots);
+    ARG_UNUSED(nslots);
+    ARG_UNUSED(stats);
+    ra->done_cb = NULL;
+}
+void seg_reasm_set_cb(seg_reasm_t *ra, seg_reasm_done_fn_t cb) { ra->done_cb = cb; }
+void seg_reasm_set_ack_fn(seg_reasm_t *ra, seg_reasm_ack_fn_t fn, void *user)
+{
+    ARG_UNUSED(ra);
+    ARG_UNUSED(fn);
+    ARG_UNUSED(user);
+}
+bool seg_reasm_active(const seg_reasm_t *ra)
+{
+    ARG_UNUSED(ra);
+    return false;
+}
+int seg_reasm_push(seg_reasm_t *ra, const uint8_t *data, size_t len)
+{
+    ARG_UNUSED(ra);
+    ARG_UNUSED(data);
+    ARG_UNUSED(len);
+    return -ENOMSG;
+}
+
+#endif
@@ -0,0 +1,71 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "uart_cfg.h"
+#include "uart_stats.h"
+
+/* Segmentli aktarım birleştirici (uart_send_large / testbench build_large_frames)
+ * DATA = seg header (7B) + parça. Transferler xid ile ayrılır; parçalar sırasız
+ * ve tekrarlı gelebilir, alınan ofsetler bitmap'te tutulur. typ'ta SEG_F_ACKREQ
+ * varsa kümülatif + seçici ACK üretilir (bkz. uart_rel.c). SEG_F_LZ'li parçalar
+ * yerinde çözülür ve önceki parçalara dayandığından yalnızca sırayla kabul
+ * edilir. Port başına bir instance; slot dizisi instance ile birlikte tanımlanır. */
+
+typedef void (*seg_reasm_done_fn_t)(uint8_t xid, const uint8_t *buf, uint16_t len);
+
+/* Güvenilir (SEG_F_ACKREQ) parçalar için üretilen ACK frame DATA'sını gönderir */
+typedef void (*seg_reasm_ack_fn_t)(void *user, const uint8_t *ack, size_t len);
+
+#if IS_ENABLED(CONFIG_CUSTOM_UART_REASM)
+/* Gönderici parçaları PAYLOAD_MAX (jumbo: PAYLOAD_JUMBO_MAX) hizasında keser:
+ * bitmap'in bir biti bir parça; üst sınır küçük parça boyundan */
+#define REASM_MAX_SEGS DIV_ROUND_UP(UART_REASM_MAX_SIZE, PAYLOAD_MAX)
+
+typedef enum { SLOT_FREE, SLOT_ACTIVE, SLOT_DONE } slot_state_t;
+
+typedef struct
+{
+    slot_state_t st;      /* DONE: güvenilir transfer bitti, geç tekrarlar yeniden ACK'lenir */
+    bool rel;             /* gönderici ACK istiyor */
+    uint8_t xid;
+    uint16_t total;
+    uint16_t seg;         /* parça boyu: seg_payload_max(typ) */
+    uint16_t nsegs, got;
+    uint16_t cum;         /* ilk eksik parça indeksi */
+    uint16_t since_ack;
+    uint32_t last_ms;
+    uint32_t bitmap[DIV_ROUND_UP(REASM_MAX_SEGS, 32)];
+    uint8_t buf[UART_REASM_MAX_SIZE];
+} reasm_slot_t;
+#else
+typedef struct
+{
+    uint8_t unused;
+} reasm_slot_t;
+#endif
+
+typedef struct
+{
+    seg_reasm_done_fn_t done_cb;
+#if IS_ENABLED(CONFIG_CUSTOM_UART_REASM)
+    reasm_slot_t *slots;
+    uint8_t nslots;
+    seg_reasm_ack_fn_t ack_fn;
+    void *ack_user;
+    uart_stats_t *stats;
+#endif
+} seg_reasm_t;
+
+void seg_reasm_init(seg_reasm_t *ra, reasm_slot_t *slots, uint8_t nslots, uart_stats_t *stats);
+void seg_reasm_set_cb(seg_reasm_t *ra, seg_reasm_done_fn_t cb);
+void seg_reasm_set_ack_fn(seg_reasm_t *ra, seg_reasm_ack_fn_t fn, void *user);
+
+/* true: callback kayıtlı ve slot var, segment frame'leri birleştiriciye yönlendirilir */
+bool seg_reasm_active(const seg_reasm_t *ra);
+
+/* 0: segment işlendi (tamamlandıysa callback çağrıldı)
+ * -ENOMSG: segment header'ı değil, frame normal yoldan işlenmeli */
+int seg_reasm_push(seg_reasm_t *ra, const uint8_t *data, size_t len);
+
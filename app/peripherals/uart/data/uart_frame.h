@@ -1,12 +1,26 @@
 #pragma once 
 #include "uart_cfg.h"
 #include <limits.h>  
+#include <stddef.h>
+
+/* Jumbo (CONFIG_CUSTOM_UART_JUMBO) açıkken LEN 16 bit ve blok jumbo boyundadır */
+#if UART_FRAME_LEN_MAX > UINT8_MAX
+typedef uint16_t uart_frame_len_t;
+#else
+typedef uint8_t uart_frame_len_t;
+#endif
 
 typedef struct {
-    uint8_t len;
-    uint8_t data[UART_MAX_PACKET_SIZE];
+    uart_frame_len_t len;
+    uint8_t data[UART_FRAME_LEN_MAX];
 } uart_frame_t;
 
+/* Scatter-gather TX parçası: DATA = parçaların sırayla birleşimi (flash'ta olabilir) */
+typedef struct {
+    const uint8_t *buf;
+    size_t len;
+} uart_iovec_t;
+
 #if UART_MAX_PACKET_SIZE > UINT8_MAX
-# error “uart_frame_t.len is uint8_t; either make len uint16_t or ensure PACKET_SIZE <= 255.”
+# error “classic frame LEN is 1 byte; keep PACKET_SIZE <= 255 and use CONFIG_CUSTOM_UART_JUMBO for larger frames.”
 #endif
\ No newline at end of file
@@ -0,0 +1,75 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "uart_os.h"
+
+/*
+ * COBS (Consistent Overhead Byte Stuffing) kodlayıcı.
+ *
+ * Kodlanmış veride 0x00 hiç geçmez; 0x00 yalnızca frame ayracıdır. Her blok,
+ * bir sonraki sıfıra (veya 254 bayta) kadar olan uzunluğu taşıyan bir kod
+ * baytıyla başlar. Ek yük n bayt için en fazla n/254 + 1 bayttır.
+ * Çözme akış halinde framer.c içinde yapılır.
+ */
+
+#define COBS_DELIM 0x00u
+#define COBS_MAX_ENCODED(n) ((n) + (n) / 254u + 1u) /* ayraç hariç */
+
+typedef struct
+{
+    uint8_t *out;
+    size_t pos;      /* sıradaki yazma konumu */
+    size_t code_pos; /* açık bloğun kod baytı */
+} cobs_enc_t;
+
+static inline void cobs_enc_begin(cobs_enc_t *e, uint8_t *out)
+{
+    e->out = out;
+    e->code_pos = 0;
+    e->pos = 1;
+}
+
+static inline void cobs_enc_close(cobs_enc_t *e)
+{
+    e->out[e->code_pos] = (uint8_t)(e->pos - e->code_pos);
+    e->code_pos = e->pos++;
+}
+
+/* Sıfır olmayan koşular memcpy ile; sıfırlar blok kapatır */
+static inline void cobs_enc_put(cobs_enc_t *e, const uint8_t *b, size_t n)
+{
+    while (n)
+    {
+        size_t room = 0xFFu - (e->pos - e->code_pos);
+        size_t run = MIN(n, room);
+        const uint8_t *z = memchr(b, 0, run);
+        if (z)
+            run = (size_t)(z - b);
+
+        memcpy(&e->out[e->pos], b, run);
+        e->pos += run;
+        b += run;
+        n -= run;
+
+        if (z)
+        {
+            cobs_enc_close(e);
+            b++;
+            n--;
+        }
+        else if (run == room)
+        {
+            cobs_enc_close(e); /* 254 baytlık tam blok (kod 0xFF), sıfır yok */
+        }
+    }
+}
+
+/* Son bloğu kapat, ayracı ekle; toplam boyu döner */
+static inline size_t cobs_enc_end(cobs_enc_t *e)
+{
+    e->out[e->code_pos] = (uint8_t)(e->pos - e->code_pos);
+    e->out[e->pos++] = COBS_DELIM;
+    return e->pos;
+}
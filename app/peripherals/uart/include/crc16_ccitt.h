@@ -1,36 +1,128 @@
 #pragma once
 #include <stdint.h>
+#include <stddef.h>
+#include <string.h>
 #include "uart_cfg.h"
+#include "uart_frame.h"
+#include "cobs.h"
+
+/*
+ * CRC-16/CCITT-FALSE (poly 0x1021, init UART_CRC_INT, no reflect, no xorout)
+ *
+ * Backend Kconfig ile seçilir (CONFIG_CUSTOM_UART_CRC_*):
+ *   BITWISE : bayt başına 8 tur bit döngüsü, tablo yok
+ *   NIBBLE  : 16 girişli (32 B) tablo, bayt başına 2 arama
+ *   TABLE   : 256 girişli (512 B) tablo, bayt başına 1 arama
+ *   SLICE4  : 4x256 girişli (2 KB) tablo; toplu güncellemede 4 bayt/tur
+ * Tablolar flash'ta tutulur (src/crc16_ccitt.c).
+ */
+
+#if defined(CONFIG_CUSTOM_UART_CRC_SLICE4)
+extern const uint16_t crc16_ccitt_table[4][256];
+#elif defined(CONFIG_CUSTOM_UART_CRC_TABLE)
+extern const uint16_t crc16_ccitt_table[1][256];
+#elif defined(CONFIG_CUSTOM_UART_CRC_NIBBLE)
+static const uint16_t crc16_ccitt_nibble[16] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+};
+#endif
 
 static inline uint16_t crc16_ccitt_step(uint16_t crc, uint8_t b)
 {
-
+#if defined(CONFIG_CUSTOM_UART_CRC_SLICE4) || defined(CONFIG_CUSTOM_UART_CRC_TABLE)
+    return (uint16_t)((crc << 8) ^ crc16_ccitt_table[0][(uint8_t)(crc >> 8) ^ b]);
+#elif defined(CONFIG_CUSTOM_UART_CRC_NIBBLE)
+    crc = (uint16_t)((crc << 4) ^ crc16_ccitt_nibble[(crc >> 12) ^ (b >> 4)]);
+    crc = (uint16_t)((crc << 4) ^ crc16_ccitt_nibble[(crc >> 12) ^ (b & 0x0F)]);
+    return crc;
+#else
     crc ^= (uint16_t)b << 8;
     for (int i = 0; i < 8; i++)
-        crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+        crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
     return crc;
+#endif
 }
 
 static inline uint16_t crc16_ccitt_update(uint16_t crc, const uint8_t *d, size_t n)
 {
-
-    while (n--)
+#if defined(CONFIG_CUSTOM_UART_CRC_SLICE4)
+    /* 4 bayt/tur: CRC'nin iki baytı ilk iki veri baytıyla hizalanır */
+    while (n >= 4)
     {
-        crc ^= (uint16_t)(*d++) << 8;
-        for (int i = 0; i < 8; i++)
-            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        crc = (uint16_t)(crc16_ccitt_table[3][(uint8_t)(crc >> 8) ^ d[0]] ^
+                         crc16_ccitt_table[2][(uint8_t)crc ^ d[1]] ^
+                         crc16_ccitt_table[1][d[2]] ^
+                         crc16_ccitt_table[0][d[3]]);
+        d += 4;
+        n -= 4;
     }
+#endif
+    while (n--)
+        crc = crc16_ccitt_step(crc, *d++);
     return crc;
 }
 
-static inline size_t build_frame(uint8_t *out, const uint8_t *payload, uint8_t len)
+/* iovec parçalarından frame kur: parçalar doğrudan out'a yazılır, CRC
+ * kaynaktan parça parça güncellenir. Toplam DATA uzunluğu LEN'e sığmalı. */
+/* out en az FRAME_MAX_TOTAL bayt olmalı. CONFIG_CUSTOM_UART_COBS ile
+ * LEN+DATA+CRC COBS kodlanır ve iki 0x00 ayraç arasına konur (SYNC yerine
+ * baştaki ayraç: aradaki çöp bir sonraki frame'e karışmaz).
+ * CONFIG_CUSTOM_UART_JUMBO ile UART_MAX_PACKET_SIZE'ı aşan DATA jumbo frame
+ * olur: SYNC_BYTE_JUMBO, LEN BE16, DATA, CRC (LEN'in iki baytı dahil). Sığan
+ * frame'ler klasik formatta kalır, jumbo bilmeyen karşı taraf onları okur. */
+static inline size_t build_frame_v(uint8_t *out, const uart_iovec_t *iov, size_t iovcnt, uint16_t len)
 {
-    out[0] = (uint8_t)SYNC_BYTE;
-    out[1] = len;
-    if (len)
-        memcpy(&out[2], payload, len);
-    uint16_t crc = crc16_ccitt_update(UART_CRC_INT, &out[1], (size_t)1 + len); /* LEN+DATA */
-    out[2 + len] = (uint8_t)(crc >> 8);
-    out[2 + len + 1] = (uint8_t)(crc & 0xFF);
-    return (size_t)(2 + len + 2); /* total frame len */
-}
\ No newline at end of file
+#if IS_ENABLED(CONFIG_CUSTOM_UART_COBS)
+    cobs_enc_t e;
+    const uint8_t len8 = (uint8_t)len;
+    out[0] = COBS_DELIM;
+    cobs_enc_begin(&e, &out[1]);
+    cobs_enc_put(&e, &len8, 1);
+    uint16_t crc = crc16_ccitt_step(UART_CRC_INT, len8); /* LEN+DATA */
+    for (size_t i = 0; i < iovcnt; i++)
+    {
+        if (!iov[i].len)
+            continue;
+        cobs_enc_put(&e, iov[i].buf, iov[i].len);
+        crc = crc16_ccitt_update(crc, iov[i].buf, iov[i].len);
+    }
+    const uint8_t c[2] = {(uint8_t)(crc >> 8), (uint8_t)(crc & 0xFF)};
+    cobs_enc_put(&e, c, sizeof(c));
+    return 1 + cobs_enc_end(&e); /* total frame len */
+#else
+    size_t pos;
+    uint16_t crc;
+    if (IS_ENABLED(CONFIG_CUSTOM_UART_JUMBO) && len > UART_MAX_PACKET_SIZE)
+    {
+        out[0] = (uint8_t)SYNC_BYTE_JUMBO;
+        sys_put_be16(len, &out[1]);
+        crc = crc16_ccitt_update(UART_CRC_INT, &out[1], 2); /* LEN+DATA */
+        pos = 3;
+    }
+    else
+    {
+        out[0] = (uint8_t)SYNC_BYTE;
+        out[1] = (uint8_t)len;
+        crc = crc16_ccitt_step(UART_CRC_INT, out[1]); /* LEN+DATA */
+        pos = 2;
+    }
+    for (size_t i = 0; i < iovcnt; i++)
+    {
+        if (!iov[i].len)
+            continue;
+        memcpy(&out[pos], iov[i].buf, iov[i].len);
+        crc = crc16_ccitt_update(crc, iov[i].buf, iov[i].len);
+        pos += iov[i].len;
+    }
+    out[pos] = (uint8_t)(crc >> 8);
+    out[pos + 1] = (uint8_t)(crc & 0xFF);
+    return pos + 2; /* total frame len */
+#endif
+}
+
+static inline size_t build_frame(uint8_t *out, const uint8_t *payload, uint16_t len)
+{
+    const uart_iovec_t v = {.buf = payload, .len = len};
+    return build_frame_v(out, &v, 1, len);
+}
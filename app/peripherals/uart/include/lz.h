@@ -0,0 +1,43 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+
+#include "uart_cfg.h"
+
+/*
+ * Segment sıkıştırması (CONFIG_CUSTOM_UART_LZ): LZ77 ailesinden, entropi
+ * kodlaması olmayan bayt hizalı format. Transfer parça parça sıkıştırılır;
+ * eşleşmeler aynı transferin önceki parçalarına da uzanabilir. Alıcı parçayı
+ * birleştirme buffer'ındaki yerine doğrudan çözer, geçmiş olarak yine o
+ * buffer'ı kullanır: pencere transferin kendisidir (en fazla
+ * UART_REASM_MAX_SIZE), ek RAM gerekmez. Kodlayıcı yalnızca LZ_HASH_SIZE x 2
+ * baytlık hash tablosu tutar.
+ *
+ *   dizi  := token [ext*] literal* [ofs_hi ofs_lo [ext*]]
+ *   token := (literal sayısı << 4) | (eşleşme boyu - LZ_MIN_MATCH); 15 ise
+ *            ardından 255 olmayan ilk bayta kadar ext baytları eklenir
+ *   ofs   := BE16 geri uzaklık, 1..transfer başına kadar
+ *
+ * Girdi bir literal grubundan veya bir eşleşmeden sonra biter.
+ */
+
+#define LZ_MIN_MATCH 4u
+#define LZ_HASH_SIZE (1u << UART_LZ_HASH_BITS)
+
+typedef struct
+{
+    const uint8_t *base;          /* transferin başı; tablo konumları buna göre */
+    uint16_t hash[LZ_HASH_SIZE];  /* 4 baytlık önek → son görüldüğü konum */
+} lz_enc_t;
+
+/* Yeni transfer: base[0..total), total <= UINT16_MAX (seg header'ındaki gibi) */
+void lz_enc_begin(lz_enc_t *e, const uint8_t *base);
+
+/* base[pos..pos+n) parçasını dst'ye sıkıştırır; geçmiş base[0..pos). Parçalar
+ * sırayla verilmelidir. Sonuç cap bayta sığmazsa 0 döner: parça ham gönderilir,
+ * alıcıda aynı ofsete yazıldığından sonraki parçaların geçmişi bozulmaz. */
+size_t lz_enc_block(lz_enc_t *e, size_t pos, size_t n, uint8_t *dst, size_t cap);
+
+/* src[0..n) → dst[0..cap); dst'den önceki hist bayt geçmiştir (önceki parçalar).
+ * Çözülen bayt sayısı veya -EBADMSG (bozuk akış, cap aşımı, geçmiş dışı ofset) */
+int lz_decompress(const uint8_t *src, size_t n, uint8_t *dst, size_t hist, size_t cap);
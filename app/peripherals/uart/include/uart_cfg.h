@@ -1,6 +1,5 @@
 #pragma once
-#include <zephyr/sys/util.h>      // BUILD_ASSERT()
-#include <zephyr/sys/byteorder.h> // sys_put_be16, sys_get_be16
+#include "uart_os.h"             // BUILD_ASSERT(), sys_put_be16, sys_get_be16 (Zephyr veya host)
 
 /* EDIIT YOUR APPICATION REQUIREMENTS*/
 
@@ -9,17 +8,97 @@
 #endif
 
 #ifndef CONFIG_CUSTOM_UART_RX_CHUNK_SIZE
-#define CONFIG_CUSTOM_UART_RX_CHUNK_SIZE        64 /* DMA/ping-pong section */
+#define CONFIG_CUSTOM_UART_RX_CHUNK_SIZE        64 /* RX DMA buffer boyu */
 #endif
 
 #ifndef CONFIG_CUSTOM_UART_SYNC_BYTE
 #define CONFIG_CUSTOM_UART_SYNC_BYTE            0xAA
 #endif
 
+#ifndef CONFIG_CUSTOM_UART_JUMBO_SYNC_BYTE
+#define CONFIG_CUSTOM_UART_JUMBO_SYNC_BYTE      0xAB
+#endif
+
+#ifndef CONFIG_CUSTOM_UART_JUMBO_MAX_SIZE
+#define CONFIG_CUSTOM_UART_JUMBO_MAX_SIZE       2048 /* jumbo frame DATA üst sınırı */
+#endif
+
+#ifndef CONFIG_CUSTOM_UART_RX_POOL_DEPTH
+#define CONFIG_CUSTOM_UART_RX_POOL_DEPTH        4
+#endif
+
 #ifndef UART_MSGQ_DEPTH
-#define UART_MSGQ_DEPTH                         4
+#define UART_MSGQ_DEPTH                         CONFIG_CUSTOM_UART_RX_POOL_DEPTH
+#endif
+
+#ifndef CONFIG_CUSTOM_UART_TX_QUEUE_DEPTH
+#define CONFIG_CUSTOM_UART_TX_QUEUE_DEPTH       4
+#endif
+
+#ifndef UART_TX_QUEUE_DEPTH
+#define UART_TX_QUEUE_DEPTH                     CONFIG_CUSTOM_UART_TX_QUEUE_DEPTH
+#endif
+
+#ifndef CONFIG_CUSTOM_UART_RX_WQ_STACK_SIZE
+#define CONFIG_CUSTOM_UART_RX_WQ_STACK_SIZE     768
+#endif
+
+#ifndef CONFIG_CUSTOM_UART_RX_WQ_PRIORITY
+#define CONFIG_CUSTOM_UART_RX_WQ_PRIORITY       -2
+#endif
+
+#ifndef CONFIG_CUSTOM_UART_CB_WQ_STACK_SIZE
+#define CONFIG_CUSTOM_UART_CB_WQ_STACK_SIZE     1024
+#endif
+
+#ifndef CONFIG_CUSTOM_UART_CB_WQ_PRIORITY
+#define CONFIG_CUSTOM_UART_CB_WQ_PRIORITY       5
+#endif
+
+#define UART_RX_WQ_STACK_SIZE                   CONFIG_CUSTOM_UART_RX_WQ_STACK_SIZE
+#define UART_RX_WQ_PRIORITY                     CONFIG_CUSTOM_UART_RX_WQ_PRIORITY
+#define UART_CB_WQ_STACK_SIZE                   CONFIG_CUSTOM_UART_CB_WQ_STACK_SIZE
+#define UART_CB_WQ_PRIORITY                     CONFIG_CUSTOM_UART_CB_WQ_PRIORITY
+
+#ifndef CONFIG_CUSTOM_UART_TX_COALESCE_BYTES
+#define CONFIG_CUSTOM_UART_TX_COALESCE_BYTES    256
+#endif
+
+#ifndef CONFIG_CUSTOM_UART_TX_COALESCE_WINDOW_US
+#define CONFIG_CUSTOM_UART_TX_COALESCE_WINDOW_US 200
 #endif
 
+#define UART_TX_COALESCE_BYTES                  CONFIG_CUSTOM_UART_TX_COALESCE_BYTES
+#define UART_TX_COALESCE_WINDOW_US              CONFIG_CUSTOM_UART_TX_COALESCE_WINDOW_US
+
+#ifndef CONFIG_CUSTOM_UART_RX_BUF_COUNT
+#define CONFIG_CUSTOM_UART_RX_BUF_COUNT         2
+#endif
+
+#define UART_RX_BUF_COUNT                       CONFIG_CUSTOM_UART_RX_BUF_COUNT
+#define UART_RX_BUF_MAX                         8 /* rx_owned bit maskesi */
+
+#ifndef CONFIG_CUSTOM_UART_RX_IDLE_TIMEOUT_US
+#define CONFIG_CUSTOM_UART_RX_IDLE_TIMEOUT_US   0 /* 0: baud'dan türet */
+#endif
+
+#ifndef CONFIG_CUSTOM_UART_RX_IDLE_CHARS
+#define CONFIG_CUSTOM_UART_RX_IDLE_CHARS        3
+#endif
+
+#ifndef CONFIG_CUSTOM_UART_RX_ADAPTIVE_SMALL_CHUNK
+#define CONFIG_CUSTOM_UART_RX_ADAPTIVE_SMALL_CHUNK 16
+#endif
+
+#ifndef CONFIG_CUSTOM_UART_RX_ADAPTIVE_GAP_CHARS
+#define CONFIG_CUSTOM_UART_RX_ADAPTIVE_GAP_CHARS 16
+#endif
+
+#define UART_RX_IDLE_TIMEOUT_US                 CONFIG_CUSTOM_UART_RX_IDLE_TIMEOUT_US
+#define UART_RX_IDLE_CHARS                      CONFIG_CUSTOM_UART_RX_IDLE_CHARS
+#define UART_RX_ADAPT_SMALL_CHUNK               CONFIG_CUSTOM_UART_RX_ADAPTIVE_SMALL_CHUNK
+#define UART_RX_ADAPT_GAP_CHARS                 CONFIG_CUSTOM_UART_RX_ADAPTIVE_GAP_CHARS
+
 #ifndef UART_CRC_INT
 #define UART_CRC_INT                            0xFFFF
 #endif
@@ -28,10 +107,20 @@
 #define UART_RX_CHUNK_LEN                       CONFIG_CUSTOM_UART_RX_CHUNK_SIZE
 #define UART_RB_SZ                              (UART_RX_CHUNK_LEN * 4)
 #define UART_SYNC_BYTE                          CONFIG_CUSTOM_UART_SYNC_BYTE
+#define UART_JUMBO_SYNC_BYTE                    CONFIG_CUSTOM_UART_JUMBO_SYNC_BYTE
+
+/* Frame DATA üst sınırı: klasik frame UART_MAX_PACKET_SIZE (LEN 1 bayt), jumbo
+ * açıksa ayrı SYNC ile işaretlenen 16-bit LEN'li frame'ler */
+#if IS_ENABLED(CONFIG_CUSTOM_UART_JUMBO)
+#define UART_FRAME_LEN_MAX                      CONFIG_CUSTOM_UART_JUMBO_MAX_SIZE
+#else
+#define UART_FRAME_LEN_MAX                      UART_MAX_PACKET_SIZE
+#endif
 
 enum
 {
-    SYNC_BYTE = UART_SYNC_BYTE
+    SYNC_BYTE = UART_SYNC_BYTE,
+    SYNC_BYTE_JUMBO = UART_JUMBO_SYNC_BYTE
 };
 
 /* segment config*/
@@ -45,9 +134,25 @@ typedef struct __packed
     uint8_t clen;         /* 1: bu parçanın veri uzunluğu */
 } seg_wire_hdr_t;
 
+/* typ: alt 4 bit tür, üst bitler bayrak */
 #define SEG_TYP_DATA 0x01
+#define SEG_TYP_ACK 0x02           /* güvenilir aktarım onayı (alıcı → gönderici) */
+#define SEG_TYP_FLOW 0x03          /* RX backpressure (alıcı → gönderici) */
+#define SEG_TYP_MASK 0x0F
+#define SEG_F_ACKREQ 0x80          /* gönderici ACK bekliyor (sliding window) */
+#define SEG_F_LZ 0x40              /* parça lz.h ile sıkıştırılmış; clen sıkışık boy */
+#define SEG_F_JUMBO 0x20           /* jumbo parça: clen BE16, header 8 bayt */
+
+/* ACK: header{typ=ACK, xid, total, offset=kümülatif alınan bayt, clen=4} +
+ * BE32 bitmap: bit i → (offset/PAYLOAD_MAX + 1 + i). parça alındı */
+#define SEG_ACK_BITMAP_SIZE 4
+
+/* FLOW: header{typ=FLOW, xid=0, total=0, offset=0, clen=1} + durum baytı */
+#define SEG_FLOW_RESUME 0x00
+#define SEG_FLOW_PAUSE 0x01
 
 #define SEG_HDR_SIZE (sizeof(seg_wire_hdr_t)) /* şu an 7 */
+#define SEG_HDR_JUMBO_SIZE (SEG_HDR_SIZE + 1u)  /* clen 2 bayt */
 BUILD_ASSERT(SEG_HDR_SIZE >= 5, "segment header too small?");
 BUILD_ASSERT(SEG_HDR_SIZE <= 64, "segment header unexpectedly large?");
 
@@ -58,28 +163,175 @@ BUILD_ASSERT(SEG_HDR_SIZE < UART_MAX_PACKET_SIZE, "header must fit inside frame
 /* Uygulamanın taşıyabileceği net parça boyutu */
 #define PAYLOAD_MAX (UART_MAX_PACKET_SIZE - SEG_HDR_SIZE)
 BUILD_ASSERT(PAYLOAD_MAX > 0, "PAYLOAD_MAX must be > 0");
+/* Jumbo parça boyu; iki tarafın CONFIG_CUSTOM_UART_JUMBO_MAX_SIZE'ı aynı olmalı */
+#define PAYLOAD_JUMBO_MAX (UART_FRAME_LEN_MAX - SEG_HDR_JUMBO_SIZE)
 
-/* (Bilgi amaçlı) Toplam frame üst sınırı: SYNC + LEN + DATA + CRC(2) */
+#if IS_ENABLED(CONFIG_CUSTOM_UART_JUMBO)
+#if IS_ENABLED(CONFIG_CUSTOM_UART_COBS)
+#error "CONFIG_CUSTOM_UART_JUMBO needs SYNC framing (CONFIG_CUSTOM_UART_COBS=n)"
+#endif
+BUILD_ASSERT(UART_JUMBO_SYNC_BYTE != UART_SYNC_BYTE, "jumbo SYNC must differ from SYNC");
+BUILD_ASSERT(UART_FRAME_LEN_MAX > UART_MAX_PACKET_SIZE && UART_FRAME_LEN_MAX <= 4096,
+             "jumbo LEN must be in (UART_MAX_PACKET_SIZE, 4096]");
+#endif
+
+/* Toplam frame üst sınırı: SYNC + LEN + DATA + CRC(2) */
+#if IS_ENABLED(CONFIG_CUSTOM_UART_COBS)
+/* COBS: SYNC yok; LEN+DATA+CRC kodlanır, kod baytları + baş/son 0x00 ayraç */
+#define FRAME_RAW_MAX (1u /*LEN*/ + UART_MAX_PACKET_SIZE + 2u /*CRC*/)
+#define FRAME_MAX_TOTAL (FRAME_RAW_MAX + FRAME_RAW_MAX / 254u + 1u /*kod*/ + 2u /*ayraç*/)
+#define FRAME_OVERHEAD_BYTES (FRAME_MAX_TOTAL - UART_MAX_PACKET_SIZE)
+#else
 #define FRAME_OVERHEAD_BYTES (1u /*SYNC*/ + 1u /*LEN*/ + 2u /*CRC*/)
+#define FRAME_JUMBO_OVERHEAD_BYTES (1u /*SYNC*/ + 2u /*LEN*/ + 2u /*CRC*/)
+#if IS_ENABLED(CONFIG_CUSTOM_UART_JUMBO)
+#define FRAME_MAX_TOTAL (FRAME_JUMBO_OVERHEAD_BYTES + UART_FRAME_LEN_MAX)
+#else
 #define FRAME_MAX_TOTAL (FRAME_OVERHEAD_BYTES + UART_MAX_PACKET_SIZE)
+#endif
+#endif
+
+/* RX taşma politikası: öncelik eşiği ve ayrılan havuz bloğu */
+#ifndef CONFIG_CUSTOM_UART_RX_PRIO_LOW_ID_MIN
+#define CONFIG_CUSTOM_UART_RX_PRIO_LOW_ID_MIN   0x05
+#endif
+
+#ifndef CONFIG_CUSTOM_UART_RX_PRIO_RESERVE
+#define CONFIG_CUSTOM_UART_RX_PRIO_RESERVE      1
+#endif
+
+#define UART_RX_PRIO_LOW_ID_MIN                 CONFIG_CUSTOM_UART_RX_PRIO_LOW_ID_MIN
+#define UART_RX_PRIO_RESERVE                    CONFIG_CUSTOM_UART_RX_PRIO_RESERVE
+
+/* Akıştaki frame bir blok tutarken boş blok en fazla havuz - 1 olur: ayrılan
+ * blok sayısı havuza ulaşırsa düşük öncelikli her frame reddedilir */
+BUILD_ASSERT(!IS_ENABLED(CONFIG_CUSTOM_UART_RX_OVF_PRIORITY) || UART_RX_PRIO_RESERVE < UART_MSGQ_DEPTH,
+             "CUSTOM_UART_RX_PRIO_RESERVE must be below CUSTOM_UART_RX_POOL_DEPTH");
+
+/* RX backpressure: uart_rb ve frame kuyruğu doluluk eşikleri (yüzde) */
+#ifndef CONFIG_CUSTOM_UART_FLOW_RB_HIGH_PCT
+#define CONFIG_CUSTOM_UART_FLOW_RB_HIGH_PCT     50
+#endif
+
+#ifndef CONFIG_CUSTOM_UART_FLOW_RB_LOW_PCT
+#define CONFIG_CUSTOM_UART_FLOW_RB_LOW_PCT      25
+#endif
+
+#ifndef CONFIG_CUSTOM_UART_FLOW_Q_HIGH_PCT
+#define CONFIG_CUSTOM_UART_FLOW_Q_HIGH_PCT      75
+#endif
+
+#ifndef CONFIG_CUSTOM_UART_FLOW_Q_LOW_PCT
+#define CONFIG_CUSTOM_UART_FLOW_Q_LOW_PCT       25
+#endif
+
+#ifndef CONFIG_CUSTOM_UART_FLOW_REFRESH_MS
+#define CONFIG_CUSTOM_UART_FLOW_REFRESH_MS      100
+#endif
+
+#define UART_FLOW_RB_HIGH_PCT                   CONFIG_CUSTOM_UART_FLOW_RB_HIGH_PCT
+#define UART_FLOW_RB_LOW_PCT                    CONFIG_CUSTOM_UART_FLOW_RB_LOW_PCT
+#define UART_FLOW_Q_HIGH_PCT                    CONFIG_CUSTOM_UART_FLOW_Q_HIGH_PCT
+#define UART_FLOW_Q_LOW_PCT                     CONFIG_CUSTOM_UART_FLOW_Q_LOW_PCT
+#define UART_FLOW_REFRESH_MS                    CONFIG_CUSTOM_UART_FLOW_REFRESH_MS
+
+BUILD_ASSERT(UART_FLOW_RB_LOW_PCT < UART_FLOW_RB_HIGH_PCT && UART_FLOW_RB_HIGH_PCT <= 100,
+             "flow: ring buffer low watermark must be below high");
+BUILD_ASSERT(UART_FLOW_Q_LOW_PCT < UART_FLOW_Q_HIGH_PCT && UART_FLOW_Q_HIGH_PCT <= 100,
+             "flow: frame queue low watermark must be below high");
+
+/* Güvenilir segment aktarımı (uart_rel.c gönderici, seg_reasm.c alıcı ACK) */
+#ifndef CONFIG_CUSTOM_UART_REL_WINDOW
+#define CONFIG_CUSTOM_UART_REL_WINDOW           8
+#endif
+
+#ifndef CONFIG_CUSTOM_UART_REL_RTO_MS
+#define CONFIG_CUSTOM_UART_REL_RTO_MS           200
+#endif
+
+#ifndef CONFIG_CUSTOM_UART_REL_MAX_RETRIES
+#define CONFIG_CUSTOM_UART_REL_MAX_RETRIES      10
+#endif
+
+#define UART_REL_WINDOW                         CONFIG_CUSTOM_UART_REL_WINDOW
+#define UART_REL_RTO_MS                         CONFIG_CUSTOM_UART_REL_RTO_MS
+#define UART_REL_MAX_RETRIES                    CONFIG_CUSTOM_UART_REL_MAX_RETRIES
+
+/* In-band sayaç sorgusu (uart_io.c); tlv_types.h TLV_ID_UART_STATS ile aynı olmalı */
+#ifndef CONFIG_CUSTOM_UART_STATS_TLV_ID
+#define CONFIG_CUSTOM_UART_STATS_TLV_ID         0x07
+#endif
+
+#define UART_STATS_TLV_ID                       CONFIG_CUSTOM_UART_STATS_TLV_ID
+
+/* Cihaz tarafı birleştirici (seg_reasm.c) */
+#ifndef CONFIG_CUSTOM_UART_REASM_SLOTS
+#define CONFIG_CUSTOM_UART_REASM_SLOTS          1
+#endif
+
+#ifndef CONFIG_CUSTOM_UART_REASM_MAX_SIZE
+#define CONFIG_CUSTOM_UART_REASM_MAX_SIZE       1024
+#endif
+
+#ifndef CONFIG_CUSTOM_UART_REASM_TIMEOUT_MS
+#define CONFIG_CUSTOM_UART_REASM_TIMEOUT_MS     1000
+#endif
+
+#define UART_REASM_SLOTS                        CONFIG_CUSTOM_UART_REASM_SLOTS
+#define UART_REASM_MAX_SIZE                     CONFIG_CUSTOM_UART_REASM_MAX_SIZE
+#define UART_REASM_TIMEOUT_MS                   CONFIG_CUSTOM_UART_REASM_TIMEOUT_MS
+
+/* Segment sıkıştırması (lz.h): kodlayıcı hash tablosu 2^bits x 2 bayt */
+#ifndef CONFIG_CUSTOM_UART_LZ_HASH_BITS
+#define CONFIG_CUSTOM_UART_LZ_HASH_BITS         8
+#endif
+
+#define UART_LZ_HASH_BITS                       CONFIG_CUSTOM_UART_LZ_HASH_BITS
+BUILD_ASSERT(UART_LZ_HASH_BITS >= 4 && UART_LZ_HASH_BITS <= 12, "LZ hash bits must be 4..12");
+
+/* typ'a göre header boyu: SEG_F_JUMBO ile clen BE16 */
+static inline size_t seg_hdr_size(uint8_t typ)
+{
+    return (typ & SEG_F_JUMBO) ? SEG_HDR_JUMBO_SIZE : SEG_HDR_SIZE;
+}
+
+/* Parçaların hizalandığı boy (bitmap'in bir biti bir parça) */
+static inline uint16_t seg_payload_max(uint8_t typ)
+{
+    return (typ & SEG_F_JUMBO) ? PAYLOAD_JUMBO_MAX : PAYLOAD_MAX;
+}
 
-static inline void seg_hdr_write(uint8_t *dst, uint8_t typ, uint8_t xid,
-                                 uint16_t total, uint16_t offset, uint8_t clen)
+/* Yazılan header boyunu döner */
+static inline size_t seg_hdr_write(uint8_t *dst, uint8_t typ, uint8_t xid,
+                                   uint16_t total, uint16_t offset, uint16_t clen)
 {
-    /* dst en az SEG_HDR_SIZE kadar olmalı */
+    /* dst en az seg_hdr_size(typ) kadar olmalı */
     dst[0] = typ;
     dst[1] = xid;
     sys_put_be16(total, &dst[2]);  /* total_be */
     sys_put_be16(offset, &dst[4]); /* offset_be */
-    dst[6] = clen;
+    if (typ & SEG_F_JUMBO)
+    {
+        sys_put_be16(clen, &dst[6]);
+        return SEG_HDR_JUMBO_SIZE;
+    }
+    dst[6] = (uint8_t)clen;
+    return SEG_HDR_SIZE;
 }
 
-static inline void seg_hdr_read(const uint8_t *src, uint8_t *typ, uint8_t *xid,
-                                uint16_t *total, uint16_t *offset, uint8_t *clen)
+/* src en az seg_hdr_size(src[0]) bayt olmalı; okunan header boyunu döner */
+static inline size_t seg_hdr_read(const uint8_t *src, uint8_t *typ, uint8_t *xid,
+                                  uint16_t *total, uint16_t *offset, uint16_t *clen)
 {
     *typ = src[0];
     *xid = src[1];
     *total = sys_get_be16(&src[2]);
     *offset = sys_get_be16(&src[4]);
+    if (*typ & SEG_F_JUMBO)
+    {
+        *clen = sys_get_be16(&src[6]);
+        return SEG_HDR_JUMBO_SIZE;
+    }
     *clen = src[6];
+    return SEG_HDR_SIZE;
 }
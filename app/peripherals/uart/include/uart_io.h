@@ -1,18 +1,102 @@
 #pragma once 
 
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+
 #include "uart_frame.h"
+#include "uart_stats.h"
 
 typedef void (*uart_io_rx_cb_t)(uart_frame_t *frame);
-extern uart_io_rx_cb_t rx_cb;
 
+/* devicetree'deki her "custom,uart-io" düğümü (yoksa uart-com alias'ı) için bir
+ * port başlatır. Bir port başarısız olsa da diğerleri açılır; ilk hata döner. */
 int uart_io_init(void);
 
 
-// is not currently supported
-//int uart_io_send_larg(const uint8_t *buf, uint32_t len, uint8_t xfer_id);
-// is not currently supported
-// int uart_io_send_buffer(const uint8_t *buf, size_t len, k_timeout_t per_frame_timeout);
+/* Segmentli büyük aktarım: her frame = seg header (7B) + en fazla PAYLOAD_MAX bayt
+ * (CONFIG_CUSTOM_UART_JUMBO: 8B header + en fazla PAYLOAD_JUMBO_MAX bayt).
+ * CONFIG_CUSTOM_UART_LZ: küçülen parçalar SEG_F_LZ ile sıkışık gider */
+int uart_io_send_larg(const uint8_t *buf, uint32_t len, uint8_t xfer_id);
+/* Güvenilir segmentli aktarım (CONFIG_CUSTOM_UART_RELIABLE): pencere kadar parça
+ * uçuşta, yalnızca eksik ofsetler yeniden gönderilir. Ardışık transferlerde
+ * farklı xfer_id kullanın. 0, -ETIMEDOUT veya -ENOTSUP döner. */
+int uart_io_send_reliable(const uint8_t *buf, uint16_t len, uint8_t xfer_id);
+/* Header'sız dilimleme: her frame en fazla UART_FRAME_LEN_MAX bayt */
+int uart_io_send_buffer(const uint8_t *buf, size_t len, k_timeout_t per_frame_timeout);
+
+/* Frame kuyruğa alınır ve TX_DONE'a kadar beklenir; timeout içinde ilerleme
+ * olmazsa frame iptal edilir (-ETIMEDOUT). Birden çok thread aynı anda çağırabilir. */
+int uart_io_send_frame(const uint8_t *payload, uint16_t len, k_timeout_t timeout);
+
+/* result: 0 (TX_DONE), -ECANCELED (abort) veya uart_tx hatası.
+ * ISR bağlamında çağrılır; kısa tutun. */
+typedef void (*uart_io_tx_cb_t)(int result, void *user_data);
+
+/* Frame slot'a kurulup kuyruğa alınır, çağıran beklemez. payload çağrı
+ * döndükten sonra tekrar kullanılabilir. timeout: boş slot bekleme süresi. */
+int uart_io_send_frame_async(const uint8_t *payload, uint16_t len,
+                             uart_io_tx_cb_t cb, void *user_data, k_timeout_t timeout);
+
+/* Scatter-gather: tek frame'in DATA'sı iov parçalarının birleşimidir (ör. TLV
+ * header + segment header + payload). Parçalar doğrudan DMA'ya ait TX
+ * buffer'ına yazılır, CRC parça parça hesaplanır; kaynak flash'ta olabilir.
+ * Toplam uzunluk 1..UART_FRAME_LEN_MAX olmalı; UART_MAX_PACKET_SIZE'ı aşan
+ * frame jumbo formatta gider (CONFIG_CUSTOM_UART_JUMBO). */
+int uart_io_sendv(const uart_iovec_t *iov, size_t iovcnt, k_timeout_t timeout);
+int uart_io_sendv_async(const uart_iovec_t *iov, size_t iovcnt,
+                        uart_io_tx_cb_t cb, void *user_data, k_timeout_t timeout);
+
+void uart_io_register_rx_cb(uart_io_rx_cb_t uart_io_rx_cb);
+
+/* Segmentli aktarım tamamlandığında çağrılır (thread bağlamı). buf yalnızca
+ * callback süresince geçerlidir. Kayıtlıyken SEG_TYP_DATA header'lı frame'ler
+ * rx_cb'ye gitmez. */
+typedef void (*uart_io_rx_large_cb_t)(uint8_t xid, const uint8_t *buf, uint16_t len);
+void uart_io_register_rx_large_cb(uart_io_rx_large_cb_t cb);
+
+/* Sıfır olmayan sayaçları ve histogram kovalarını loglar (tx_frames / tx_xfers =
+ * DMA transferi başına frame) */
+void uart_io_dump_stats(void);
+
+/* Sayaçların anlık kopyası (ilk port). Her sayaç ayrı okunur; kopya bütün
+ * olarak atomik değildir. Histogram kovası i: [2^i, 2^(i+1)) cycle;
+ * süre = cycle / cyc_per_sec. -EINVAL: out NULL. */
+int uart_io_get_stats(uart_io_stats_t *out);
+/* UART_STAT_* için sayaç adı (ör. "rx_crc_err") */
+const char *uart_io_stat_name(uart_stat_id_t id);
+
+/* RX frame'leri havuzdan referansla verilir; callback döndükten sonra sürücü
+ * kendi referansını bırakır. Frame'i callback dışında tutmak için
+ * uart_io_frame_ref() çağırın, işiniz bitince uart_io_frame_release() ile bırakın. */
+uart_frame_t *uart_io_frame_ref(uart_frame_t *frame);
+void uart_io_frame_release(uart_frame_t *frame);
+
+/* ---- Çoklu port ----
+ * Aşağıdaki uart_io_ctx_* fonksiyonları belirtilen portta çalışır; yukarıdaki
+ * tek-port fonksiyonları ilk instance'ı (indeks 0) kullanır. Her portun ring
+ * buffer'ı, parser'ı, RX havuzu, TX kuyruğu ve sayaçları ayrıdır; tüm portlar
+ * aynı iki iş kuyruğunu (RX drain ve callback dispatch) paylaşır. */
+typedef struct uart_io_ctx uart_io_ctx_t;
 
- int uart_io_send_frame(const uint8_t *payload, uint8_t len, k_timeout_t timeout);
+size_t uart_io_ctx_count(void);
+/* Devicetree instance sırası; aralık dışıysa NULL */
+uart_io_ctx_t *uart_io_ctx_get(size_t idx);
+/* uart: DEVICE_DT_GET(DT_NODELABEL(usart2)) gibi; eşleşme yoksa NULL */
+uart_io_ctx_t *uart_io_ctx_from_dev(const struct device *uart);
 
-void uart_io_register_rx_cb(uart_io_rx_cb_t uart_io_rx_cb);
\ No newline at end of file
+int uart_io_ctx_send_frame(uart_io_ctx_t *ctx, const uint8_t *payload, uint16_t len, k_timeout_t timeout);
+int uart_io_ctx_send_frame_async(uart_io_ctx_t *ctx, const uint8_t *payload, uint16_t len,
+                                 uart_io_tx_cb_t cb, void *user_data, k_timeout_t timeout);
+int uart_io_ctx_sendv(uart_io_ctx_t *ctx, const uart_iovec_t *iov, size_t iovcnt, k_timeout_t timeout);
+int uart_io_ctx_sendv_async(uart_io_ctx_t *ctx, const uart_iovec_t *iov, size_t iovcnt,
+                            uart_io_tx_cb_t cb, void *user_data, k_timeout_t timeout);
+int uart_io_ctx_send_buffer(uart_io_ctx_t *ctx, const uint8_t *buf, size_t len, k_timeout_t per_frame_timeout);
+int uart_io_ctx_send_large(uart_io_ctx_t *ctx, const uint8_t *buf, uint32_t len, uint8_t xfer_id);
+int uart_io_ctx_send_reliable(uart_io_ctx_t *ctx, const uint8_t *buf, uint16_t len, uint8_t xfer_id);
+void uart_io_ctx_register_rx_cb(uart_io_ctx_t *ctx, uart_io_rx_cb_t cb);
+void uart_io_ctx_register_rx_large_cb(uart_io_ctx_t *ctx, uart_io_rx_large_cb_t cb);
+void uart_io_ctx_dump_stats(uart_io_ctx_t *ctx);
+int uart_io_ctx_get_stats(uart_io_ctx_t *ctx, uart_io_stats_t *out);
+void uart_io_ctx_reset_stats(uart_io_ctx_t *ctx);
+/* UART cihaz adı (log/shell için) */
+const char *uart_io_ctx_name(uart_io_ctx_t *ctx);
@@ -0,0 +1,215 @@
+#pragma once
+
+/* Protokol çekirdeğinin (framer, CRC, COBS, seg_reasm, TLV) kullandığı çekirdek
+ * servisleri. Zephyr'de (__ZEPHYR__) doğrudan Zephyr header'larıdır; aksi halde
+ * aynı isim ve imzalarla tek thread'lik bir host karşılığı tanımlanır, böylece
+ * çekirdek düz gcc/clang ile derlenebilir. Fuzz hedefi, testler ve
+ * benchmark'lar test/host/CMakeLists.txt'tedir:
+ *
+ *   cmake -S test/host -B build-host && cmake --build build-host && ctest --test-dir build-host
+ *
+ * Host'ta bekleme yoktur: timeout'lar K_NO_WAIT gibi davranır. Havuz ve kuyruk
+ * k_mem_slab_init() / k_msgq_init() ile çalışma anında kurulur. Konfigürasyon
+ * -DCONFIG_CUSTOM_UART_...=1 ile verilir; verilmeyenler uart_cfg.h varsayılanıdır. */
+
+#if defined(__ZEPHYR__)
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/util.h>
+
+#else /* host */
+
+#include <assert.h>
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+/* ---- sys/util.h ---- */
+#define BUILD_ASSERT(expr, ...) _Static_assert(expr, "" __VA_ARGS__)
+
+/* #if içinde de çalışır: tanımsız veya 1 dışındaki değerler 0 */
+#define IS_ENABLED(config_macro)         Z_IS_ENABLED1(config_macro)
+#define Z_IS_ENABLED1(config_macro)      Z_IS_ENABLED2(_XXXX##config_macro)
+#define _XXXX1                           _YYYY,
+#define Z_IS_ENABLED2(one_or_two_args)   Z_IS_ENABLED3(one_or_two_args 1, 0)
+#define Z_IS_ENABLED3(ignore_this, val, ...) val
+
+#define ARG_UNUSED(x)             (void)(x)
+#define ARRAY_SIZE(a)             (sizeof(a) / sizeof((a)[0]))
+#define MIN(a, b)                 (((a) < (b)) ? (a) : (b))
+#define MAX(a, b)                 (((a) > (b)) ? (a) : (b))
+#define DIV_ROUND_UP(n, d)        (((n) + (d) - 1) / (d))
+#define ROUND_UP(x, align)        (DIV_ROUND_UP((x), (align)) * (align))
+#define BIT(n)                    (1UL << (n))
+#define CONTAINER_OF(ptr, type, field) ((type *)(((char *)(ptr)) - offsetof(type, field)))
+
+#ifndef __packed
+#define __packed                  __attribute__((__packed__))
+#endif
+#ifndef __aligned
+#define __aligned(x)              __attribute__((__aligned__(x)))
+#endif
+
+#define __ASSERT(cond, msg)       assert((cond) && (msg))
+#define __ASSERT_NO_MSG(cond)     assert(cond)
+
+static inline unsigned int find_msb_set(uint32_t x)
+{
+    return x ? 32u - (unsigned int)__builtin_clz(x) : 0u;
+}
+
+/* ---- sys/byteorder.h ---- */
+static inline void sys_put_be16(uint16_t v, uint8_t dst[2])
+{
+    dst[0] = (uint8_t)(v >> 8);
+    dst[1] = (uint8_t)v;
+}
+
+static inline uint16_t sys_get_be16(const uint8_t src[2])
+{
+    return (uint16_t)((src[0] << 8) | src[1]);
+}
+
+static inline void sys_put_be32(uint32_t v, uint8_t dst[4])
+{
+    sys_put_be16((uint16_t)(v >> 16), &dst[0]);
+    sys_put_be16((uint16_t)v, &dst[2]);
+}
+
+static inline uint32_t sys_get_be32(const uint8_t src[4])
+{
+    return ((uint32_t)sys_get_be16(&src[0]) << 16) | sys_get_be16(&src[2]);
+}
+
+/* ---- sys/atomic.h (dönüş değerleri Zephyr'deki gibi eski değerdir) ---- */
+typedef long atomic_t;
+typedef long atomic_val_t;
+
+static inline atomic_val_t atomic_get(const atomic_t *t) { return __atomic_load_n(t, __ATOMIC_SEQ_CST); }
+static inline atomic_val_t atomic_set(atomic_t *t, atomic_val_t v) { return __atomic_exchange_n(t, v, __ATOMIC_SEQ_CST); }
+static inline atomic_val_t atomic_clear(atomic_t *t) { return atomic_set(t, 0); }
+static inline atomic_val_t atomic_add(atomic_t *t, atomic_val_t v) { return __atomic_fetch_add(t, v, __ATOMIC_SEQ_CST); }
+static inline atomic_val_t atomic_inc(atomic_t *t) { return atomic_add(t, 1); }
+static inline atomic_val_t atomic_dec(atomic_t *t) { return atomic_add(t, -1); }
+static inline bool atomic_cas(atomic_t *t, atomic_val_t old, atomic_val_t v)
+{
+    return __atomic_compare_exchange_n(t, &old, v, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+
+/* ---- kernel.h: zaman ---- */
+typedef struct
+{
+    int64_t ticks;
+} k_timeout_t;
+
+#define K_NO_WAIT ((k_timeout_t){0})
+#define K_FOREVER ((k_timeout_t){-1})
+
+static inline uint64_t z_host_ns(void)
+{
+    struct timespec ts; /* C11 timespec_get: POSIX makrosu gerektirmez */
+    timespec_get(&ts, TIME_UTC);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static inline uint32_t k_uptime_get_32(void) { return (uint32_t)(z_host_ns() / 1000000u); }
+static inline uint32_t k_cycle_get_32(void) { return (uint32_t)z_host_ns(); }
+static inline uint32_t sys_clock_hw_cycles_per_sec(void) { return 1000000000u; }
+
+/* ---- kernel.h: sabit bloklu havuz ---- */
+struct k_mem_slab
+{
+    void *free_list; /* boş blokların ilk kelimesi sonrakini gösterir */
+    uint32_t num_blocks, num_used;
+};
+
+static inline int k_mem_slab_init(struct k_mem_slab *slab, void *buffer, size_t block_size, uint32_t num_blocks)
+{
+    if (block_size < sizeof(void *) || block_size % sizeof(void *))
+        return -EINVAL;
+    slab->free_list = NULL;
+    for (uint32_t i = num_blocks; i-- > 0;)
+    {
+        void **blk = (void **)((char *)buffer + i * block_size);
+        *blk = slab->free_list;
+        slab->free_list = blk;
+    }
+    slab->num_blocks = num_blocks;
+    slab->num_used = 0;
+    return 0;
+}
+
+static inline int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
+{
+    ARG_UNUSED(timeout);
+    if (!slab->free_list)
+    {
+        *mem = NULL;
+        return -ENOMEM;
+    }
+    *mem = slab->free_list;
+    slab->free_list = *(void **)slab->free_list;
+    slab->num_used++;
+    return 0;
+}
+
+static inline void k_mem_slab_free(struct k_mem_slab *slab, void *mem)
+{
+    *(void **)mem = slab->free_list;
+    slab->free_list = mem;
+    slab->num_used--;
+}
+
+static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
+{
+    return slab->num_blocks - slab->num_used;
+}
+
+/* ---- kernel.h: sabit boyutlu mesaj kuyruğu ---- */
+struct k_msgq
+{
+    char *buffer;
+    size_t msg_size;
+    uint32_t max_msgs, read, used;
+};
+
+static inline void k_msgq_init(struct k_msgq *q, char *buffer, size_t msg_size, uint32_t max_msgs)
+{
+    q->buffer = buffer;
+    q->msg_size = msg_size;
+    q->max_msgs = max_msgs;
+    q->read = q->used = 0;
+}
+
+static inline int k_msgq_put(struct k_msgq *q, const void *data, k_timeout_t timeout)
+{
+    ARG_UNUSED(timeout);
+    if (q->used == q->max_msgs)
+        return -ENOMSG;
+    memcpy(&q->buffer[((q->read + q->used) % q->max_msgs) * q->msg_size], data, q->msg_size);
+    q->used++;
+    return 0;
+}
+
+static inline int k_msgq_get(struct k_msgq *q, void *data, k_timeout_t timeout)
+{
+    ARG_UNUSED(timeout);
+    if (!q->used)
+        return -ENOMSG;
+    memcpy(data, &q->buffer[q->read * q->msg_size], q->msg_size);
+    q->read = (q->read + 1) % q->max_msgs;
+    q->used--;
+    return 0;
+}
+
+static inline uint32_t k_msgq_num_used_get(struct k_msgq *q)
+{
+    return q->used;
+}
+
+#endif /* __ZEPHYR__ */
@@ -0,0 +1,126 @@
+#pragma once
+#include <stdint.h>
+
+#include "uart_os.h"
+
+/* Port başına birleşik sayaçlar. Liste tek yerde tutulur: enum, isim tablosu
+ * (log/shell) ve TLV sorgusunun kelime sırası buradan üretilir. Yeni sayaçlar
+ * sona eklenir; testbench STATS_FIELDS aynı sırayı izler. */
+#define UART_STATS_LIST(X)                 \
+    /* RX */                               \
+    X(RX_BYTES, rx_bytes)                  \
+    X(RX_FRAMES, rx_frames)                \
+    X(RX_LEN_ERR, rx_len_err)              \
+    X(RX_CRC_ERR, rx_crc_err)              \
+    X(RX_BUDGET_ERR, rx_budget_err)        \
+    X(RX_COBS_ERR, rx_cobs_err)            \
+    X(RX_DROP_BYTES, rx_drop_bytes)        \
+    X(RX_OVF_GAPS, rx_ovf_gaps)            \
+    X(RX_OVF_EVICT, rx_ovf_evict)          \
+    X(RX_OVF_CUT, rx_ovf_cut)              \
+    X(RX_POOL_EMPTY, rx_pool_empty)        \
+    X(RX_Q_FULL, rx_q_full)                \
+    X(RX_PRIO_DROP, rx_prio_drop)          \
+    /* TX */                               \
+    X(TX_BYTES, tx_bytes)                  \
+    X(TX_FRAMES, tx_frames)                \
+    X(TX_XFERS, tx_xfers)                  \
+    X(TX_MAX_BATCH, tx_max_batch)          \
+    X(TX_TIMEOUTS, tx_timeouts)            \
+    X(TX_ABORTS, tx_aborts)                \
+    X(TX_ERRORS, tx_errors)                \
+    X(TX_NOBUFS, tx_nobufs)                \
+    /* doluluk tepe değerleri */           \
+    X(RB_HWM, rb_hwm)                      \
+    X(RXQ_HWM, rxq_hwm)                    \
+    X(TXQ_HWM, txq_hwm)                    \
+    /* flow control */                     \
+    X(FLOW_PAUSE, flow_pause)              \
+    X(FLOW_TX_ERR, flow_tx_err)            \
+    /* segment birleştirici */             \
+    X(REASM_DONE, reasm_done)              \
+    X(REASM_DUP, reasm_dup)                \
+    X(REASM_BAD, reasm_bad)                \
+    X(REASM_TOO_BIG, reasm_too_big)        \
+    X(REASM_NO_SLOT, reasm_no_slot)        \
+    X(REASM_TIMEOUT, reasm_timeout)        \
+    X(REASM_ACKS, reasm_acks)              \
+    /* güvenilir gönderici */              \
+    X(REL_SEGS, rel_segs)                  \
+    X(REL_RETX, rel_retx)                  \
+    X(REL_ACKS, rel_acks)                  \
+    X(REL_FAIL, rel_fail)                  \
+    /* RX DMA ayarı */                     \
+    X(RX_RETUNE, rx_retune)                \
+    X(RX_BUF_NONE, rx_buf_none)            \
+    /* segment sıkıştırması */             \
+    X(REASM_LZ_ERR, reasm_lz_err)
+
+typedef enum
+{
+#define UART_STATS_ENUM(id, name) UART_STAT_##id,
+    UART_STATS_LIST(UART_STATS_ENUM)
+#undef UART_STATS_ENUM
+    UART_STAT_COUNT
+} uart_stat_id_t;
+
+/* log2 gecikme histogramları (k_cycle_get_32 farkı): kova i = [2^i, 2^(i+1)) cycle */
+typedef enum
+{
+    UART_STATS_HIST_RX, /* son RX_RDY kesmesi → rx_cb çağrısı */
+    UART_STATS_HIST_TX, /* kuyruğa alma → TX_DONE */
+    UART_STATS_HIST_COUNT
+} uart_stats_hist_id_t;
+
+#define UART_STATS_HIST_BUCKETS 32
+
+/* Canlı sayaçlar; ISR ve thread'ler kilitsiz günceller */
+typedef struct
+{
+    atomic_t cnt[UART_STAT_COUNT];
+#if IS_ENABLED(CONFIG_CUSTOM_UART_STATS_HIST)
+    atomic_t hist[UART_STATS_HIST_COUNT][UART_STATS_HIST_BUCKETS];
+#endif
+} uart_stats_t;
+
+/* uart_io_get_stats() kopyası. Histogramlar kapalıysa hist sıfırdır. */
+typedef struct
+{
+    uint32_t cnt[UART_STAT_COUNT];
+    uint32_t hist[UART_STATS_HIST_COUNT][UART_STATS_HIST_BUCKETS];
+    uint32_t cyc_per_sec; /* histogram kovalarını süreye çevirmek için */
+} uart_io_stats_t;
+
+static inline void uart_stat_inc(uart_stats_t *s, uart_stat_id_t id)
+{
+    (void)atomic_inc(&s->cnt[id]);
+}
+
+static inline void uart_stat_add(uart_stats_t *s, uart_stat_id_t id, uint32_t v)
+{
+    (void)atomic_add(&s->cnt[id], (atomic_val_t)v);
+}
+
+/* Tepe değer: yalnızca büyürse yazılır */
+static inline void uart_stat_max(uart_stats_t *s, uart_stat_id_t id, uint32_t v)
+{
+    atomic_val_t old;
+    do
+    {
+        old = atomic_get(&s->cnt[id]);
+        if ((uint32_t)old >= v)
+            return;
+    } while (!atomic_cas(&s->cnt[id], old, (atomic_val_t)v));
+}
+
+static inline void uart_stat_hist(uart_stats_t *s, uart_stats_hist_id_t h, uint32_t cycles)
+{
+#if IS_ENABLED(CONFIG_CUSTOM_UART_STATS_HIST)
+    unsigned int msb = find_msb_set(cycles); /* 1..32, 0 → kova 0 */
+    (void)atomic_inc(&s->hist[h][msb ? msb - 1u : 0u]);
+#else
+    ARG_UNUSED(s);
+    ARG_UNUSED(h);
+    ARG_UNUSED(cycles);
+#endif
+}
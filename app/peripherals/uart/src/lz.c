@@ -0,0 +1,164 @@
+#include <errno.h>
+#include <string.h>
+
+#include "lz.h"
+
+#define LZ_NIBBLE_MAX 15u
+#define LZ_HASH_EMPTY UINT16_MAX /* tabloya giren konumlar en fazla total - LZ_MIN_MATCH */
+/* Tablo konumu 16 bit: alıcının penceresi (birleştirme buffer'ı) boş işaretine
+ * ulaşırsa konumlar sessizce örtüşür */
+BUILD_ASSERT(!IS_ENABLED(CONFIG_CUSTOM_UART_LZ) || UART_REASM_MAX_SIZE < LZ_HASH_EMPTY,
+             "CUSTOM_UART_REASM_MAX_SIZE must be below 65535 with CUSTOM_UART_LZ");
+
+static inline uint32_t lz_hash(const uint8_t *p)
+{
+    uint32_t v = (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+    return (v * 2654435761u) >> (32u - UART_LZ_HASH_BITS);
+}
+
+static inline size_t lz_ext_size(size_t n)
+{
+    return n < LZ_NIBBLE_MAX ? 0u : (n - LZ_NIBBLE_MAX) / 255u + 1u;
+}
+
+static inline uint8_t *lz_put_ext(uint8_t *op, size_t n)
+{
+    if (n < LZ_NIBBLE_MAX)
+        return op;
+    for (n -= LZ_NIBBLE_MAX; n >= 255u; n -= 255u)
+        *op++ = 255u;
+    *op++ = (uint8_t)n;
+    return op;
+}
+
+/* Bir dizi yazar; mlen == 0 son literal grubudur. Sığmazsa NULL */
+static uint8_t *lz_emit(uint8_t *op, const uint8_t *oend, const uint8_t *lit, size_t nlit,
+                        size_t ofs, size_t mlen)
+{
+    size_t m = mlen ? mlen - LZ_MIN_MATCH : 0u;
+    size_t need = 1u + lz_ext_size(nlit) + nlit + (mlen ? 2u + lz_ext_size(m) : 0u);
+
+    if ((size_t)(oend - op) < need)
+        return NULL;
+
+    *op++ = (uint8_t)((MIN(nlit, LZ_NIBBLE_MAX) << 4) | MIN(m, LZ_NIBBLE_MAX));
+    op = lz_put_ext(op, nlit);
+    memcpy(op, lit, nlit);
+    op += nlit;
+    if (mlen)
+    {
+        sys_put_be16((uint16_t)ofs, op);
+        op = lz_put_ext(op + 2, m);
+    }
+    return op;
+}
+
+void lz_enc_begin(lz_enc_t *e, const uint8_t *base)
+{
+    e->base = base;
+    memset(e->hash, 0xFF, sizeof(e->hash));
+}
+
+/* Açgözlü, tek adaylı arama; eşleşme içindeki konumlar da tabloya girer.
+ * Eşleşme parça sonunda kesilir, aday önceki parçalarda olabilir. */
+size_t lz_enc_block(lz_enc_t *e, size_t pos, size_t n, uint8_t *dst, size_t cap)
+{
+    const uint8_t *src = e->base;
+    size_t end = pos + n, anchor = pos, i = pos;
+    uint8_t *op = dst;
+    const uint8_t *oend = dst + cap;
+
+    while (i + LZ_MIN_MATCH <= end)
+    {
+        uint32_t h = lz_hash(&src[i]);
+        size_t cand = e->hash[h];
+
+        e->hash[h] = (uint16_t)i;
+        if (cand == LZ_HASH_EMPTY || memcmp(&src[cand], &src[i], LZ_MIN_MATCH) != 0)
+        {
+            i++;
+            continue;
+        }
+
+        size_t m = LZ_MIN_MATCH;
+        while (i + m < end && src[cand + m] == src[i + m])
+            m++;
+
+        op = lz_emit(op, oend, &src[anchor], i - anchor, i - cand, m);
+        if (!op)
+            return 0;
+
+        for (size_t k = i + 1; k < i + m && k + LZ_MIN_MATCH <= end; k++)
+            e->hash[lz_hash(&src[k])] = (uint16_t)k;
+        i += m;
+        anchor = i;
+    }
+
+    if (anchor < end)
+    {
+        op = lz_emit(op, oend, &src[anchor], end - anchor, 0, 0);
+        if (!op)
+            return 0;
+    }
+    return (size_t)(op - dst);
+}
+
+static inline int lz_get_ext(const uint8_t **ip, const uint8_t *iend, size_t *n)
+{
+    uint8_t b;
+
+    do
+    {
+        if (*ip == iend)
+            return -EBADMSG;
+        b = *(*ip)++;
+        *n += b;
+    } while (b == 255u);
+    return 0;
+}
+
+int lz_decompress(const uint8_t *src, size_t n, uint8_t *dst, size_t hist, size_t cap)
+{
+    const uint8_t *ip = src, *iend = src + n;
+    size_t o = 0;
+
+    while (ip < iend)
+    {
+        uint8_t token = *ip++;
+        size_t lit = token >> 4;
+
+        if (lit == LZ_NIBBLE_MAX && lz_get_ext(&ip, iend, &lit))
+            return -EBADMSG;
+        if ((size_t)(iend - ip) < lit || cap - o < lit)
+            return -EBADMSG;
+        memcpy(&dst[o], ip, lit);
+        ip += lit;
+        o += lit;
+
+        if (ip == iend)
+            break;
+        if (iend - ip < 2)
+            return -EBADMSG;
+
+        size_t ofs = sys_get_be16(ip);
+        size_t m = token & LZ_NIBBLE_MAX;
+
+        ip += 2;
+        if (m == LZ_NIBBLE_MAX && lz_get_ext(&ip, iend, &m))
+            return -EBADMSG;
+        m += LZ_MIN_MATCH;
+        if (ofs == 0 || ofs > hist + o || cap - o < m)
+            return -EBADMSG;
+
+        /* ofs < m: kendini tekrarlayan koşu, bayt bayt kopyalanmalı */
+        uint8_t *d = &dst[o];
+        const uint8_t *s = d - ofs;
+        if (ofs >= m)
+            memcpy(d, s, m);
+        else
+            for (size_t k = 0; k < m; k++)
+                d[k] = s[k];
+        o += m;
+    }
+    return (int)o;
+}
@@ -8,186 +8,687 @@
 LOG_MODULE_REGISTER(APP_LOG_MODULE, APP_LOG_LEVEL);
 
 #include "framer.h"
+#include "seg_reasm.h"
+#include "uart_rel.h"
 #include "uart_io.h"
 #include "crc16_ccitt.h"
+#include "lz.h"
 
-/* ---- GLOBALS ---- */
-static const struct device *uart_dev;
+/* ---- INSTANCES ---- */
+
+#define DT_DRV_COMPAT custom_uart_io
 
 #ifndef UART_DEVICE_NODE
 #define UART_DEVICE_NODE DT_ALIAS(uart_com) /* dts: aliases { uart-com = &uart0; }; */
 #endif
 
-struct k_work rx_drain_work;
+/* İki kuyruk, tüm portlar için ortak (port başına thread yok):
+ *  rx_wq: ring buffer drain + framer; yüksek öncelik, kullanıcı kodu çalışmaz
+ *  cb_wq: msgq'dan ACK/reasm/rx_cb dispatch; callback uyursa yalnızca msgq dolar,
+ *         ring buffer boşaltılmaya devam eder (drop_bytes yerine q_full/pool_empty) */
+K_THREAD_STACK_DEFINE(uart_io_rx_wq_stack, UART_RX_WQ_STACK_SIZE);
+K_THREAD_STACK_DEFINE(uart_io_cb_wq_stack, UART_CB_WQ_STACK_SIZE);
+static struct k_work_q uart_io_rx_wq;
+static struct k_work_q uart_io_cb_wq;
+
+/* TX kuyruğu: slot'lar slab'dan, sıra ring dizisinde; ring[head] DMA'dadır */
+typedef struct tx_slot
+{
+    uint8_t buf[FRAME_MAX_TOTAL]; /* DMA tamamlanana kadar sahibi sürücü */
+    uint16_t len;
+    uart_io_tx_cb_t cb;
+    void *user;
+    uint32_t t_enq;       /* kuyruğa alma zamanı (cycle), gecikme histogramı için */
+    struct tx_slot *next; /* kuyruktan çıkan slot'ları kilit dışında tamamlamak için */
+} tx_slot_t;
+
+typedef struct
+{
+    struct k_spinlock lock;
+    uint8_t head, count;
+    uint8_t inflight; /* ring[head..] içinden DMA'daki frame sayısı */
+    bool busy;        /* transfer sürüyor / başlatılacak / pencere bekleniyor */
+#if IS_ENABLED(CONFIG_CUSTOM_UART_TX_COALESCE)
+    bool holding;     /* tek frame birleştirme penceresinde bekletiliyor */
+    uint16_t bytes;   /* kuyruktaki toplam frame baytı */
+#endif
+} tx_queue_t;
+
+#if IS_ENABLED(CONFIG_CUSTOM_UART_FLOW_CTRL)
+/* RX backpressure durumu; eşikler init'te port boyutlarından hesaplanır */
+typedef struct
+{
+    struct k_spinlock lock;
+    bool paused;
+    bool rts;        /* RTS sürülebiliyor; değilse in-band PAUSE/RESUME */
+    bool pending;    /* durum gönderilecek (veya sığmadı, sonraki güncellemede tekrar) */
+    bool sending;    /* bir bağlam kilit dışında durumu gönderiyor */
+    uint32_t sent_ms;
+    uint32_t rb_hi, rb_lo;
+    uint32_t q_hi, q_lo;
+} flow_t;
+#endif
+
+#if IS_ENABLED(CONFIG_CUSTOM_UART_RX_ADAPTIVE)
+/* RX profilleri: küçük buffer + kısa timeout (komut/yanıt) veya tam buffer +
+ * burst boşluğu kadar timeout (akış). Ölçüm ISR'de, RX_RDY'ler arasında. */
+enum
+{
+    RX_PROF_LAT,
+    RX_PROF_BULK,
+    RX_PROF_COUNT
+};
+
+#define RX_ADAPT_BULK_AFTER 4 /* art arda bu kadar kısa boşluklu burst: akış profili */
 
-struct k_work_poll uart_rx_wp;
-struct k_poll_event uart_rx_pe;
+typedef struct
+{
+    uint16_t len[RX_PROF_COUNT];     /* DMA buffer boyu */
+    int32_t tmo_us[RX_PROF_COUNT];   /* inactivity timeout */
+    uint32_t tmo_cyc[RX_PROF_COUNT];
+    uint32_t char_cyc;               /* bir karakterin hattaki süresi */
+    uint32_t gap_cyc;                /* burst'leri ayıran boşluk */
+    uint16_t buf_len[UART_RX_BUF_MAX]; /* DMA'ya verilen boylar: tam dolum / timeout ayrımı */
+    uint32_t last_cyc;               /* önceki RX_RDY'nin son baytı (timeout'ta tmo kadar önce) */
+    uint16_t run;                    /* timeout'suz art arda gelen bayt (burst içi) */
+    uint16_t bulk_run;               /* bu kadar kesintisiz bayt da akış sayılır */
+    uint8_t cur;                     /* RX'in açıldığı profil (timeout) */
+    uint8_t want;                    /* ölçülen profil; buffer boyu hemen uygulanır */
+    uint8_t dense;                   /* art arda kısa boşluklu burst sayısı */
+    bool retune;                     /* RX_DISABLED bizden: durum korunur, yeni timeout'la açılır */
+    bool quiet;                      /* önceki RX_RDY en az burst boşluğu kadar timeout'tu */
+} rx_adapt_t;
+#endif
 
-uart_io_rx_cb_t rx_cb = NULL;
+/* Port başına sabit kaynaklar; boyutlar devicetree'den (yoksa Kconfig) */
+typedef struct
+{
+    const struct device *dev;
+    uint32_t baud;       /* DT current-speed; çalışma anı ayarı okunamazsa */
+    uint32_t rx_idle_us; /* 0: baud'dan UART_RX_IDLE_CHARS karakter süresi */
+    uint8_t *rb_mem;
+    uint32_t rb_size;
+    uint8_t *rx_bufs; /* rx_nbufs x chunk_len DMA buffer'ı */
+    uint16_t chunk_len;
+    uint8_t rx_nbufs;
+    struct k_mem_slab *rx_slab;
+    struct k_msgq *rx_msgq;
+    uint16_t rx_depth; /* havuz = msgq derinliği */
+    struct k_mem_slab *tx_slab;
+    tx_slot_t **tx_ring;
+    uint8_t tx_depth;
+    bool rts; /* UART düğümünde hw-flow-control var */
+#if IS_ENABLED(CONFIG_CUSTOM_UART_TX_COALESCE)
+    uint8_t *coal_buf; /* UART_TX_COALESCE_BYTES */
+#endif
+    reasm_slot_t *reasm_slots;
+    uint8_t reasm_nslots;
+} uart_io_cfg_t;
+
+#if IS_ENABLED(CONFIG_CUSTOM_UART_JUMBO)
+#define UART_IO_LZ_SEG_MAX PAYLOAD_JUMBO_MAX
+#else
+#define UART_IO_LZ_SEG_MAX PAYLOAD_MAX
+#endif
 
+struct uart_io_ctx
+{
+    const uart_io_cfg_t *cfg;
+    bool ready; /* uart_io_init() bu portu başlattı */
+
+    /* RX */
+    /* Tek üretici (RX_RDY) / tek tüketici (rx_wq drain) bayt akışı: ring_buf
+     * put/get uçları ayrı olduğundan kilit gerekmez. DROP_OLDEST'te ISR de
+     * okuma ucundan tahliye eder; yalnız o yapılandırmada rb_lock kullanılır. */
+    struct ring_buf rb;
+    uint8_t rx_next;       /* sıradaki aday DMA buffer'ı */
+    uint8_t rx_owned;      /* bit i: buffer i sürücüde (enable/rsp → RX_BUF_RELEASED) */
+    atomic_t rx_gap;       /* drop-newest: halka taşdı, drain boşaltana kadar yazılmaz */
+    atomic_t rx_reset;     /* RX hata/stop ile yeniden başladı: halka ve parser drain'de sıfırlanır */
+    volatile uint32_t rx_isr_cyc; /* son RX_RDY zamanı; drain frame'lere damgalar */
+    int32_t rx_tmo_us;     /* uart_rx_enable'a verilen inactivity timeout */
+#if IS_ENABLED(CONFIG_CUSTOM_UART_RX_ADAPTIVE)
+    rx_adapt_t adapt;
+#endif
+#if IS_ENABLED(CONFIG_CUSTOM_UART_RX_OVF_DROP_OLDEST)
+    struct k_spinlock rb_lock; /* ISR tahliyesi ile drain okuması */
+    bool rx_evicted;           /* okuma başından frame atıldı */
+#endif
+    struct k_work rx_drain_work;
+    struct k_work_poll rx_wp;
+    struct k_poll_event rx_pe;
+    framer_t framer;
+    seg_reasm_t reasm;
+    uart_rel_t rel;
+    uart_io_rx_cb_t rx_cb;
+#if IS_ENABLED(CONFIG_CUSTOM_UART_FLOW_CTRL)
+    flow_t flow;
+#endif
 
-RING_BUF_DECLARE(uart_rb, UART_RB_SZ);
-static uint8_t uart_rb_mem[UART_RB_SZ];
+    /* TX */
+    tx_queue_t txq;
+#if IS_ENABLED(CONFIG_CUSTOM_UART_TX_COALESCE)
+    struct k_timer tx_hold_timer;
+#endif
+#if IS_ENABLED(CONFIG_CUSTOM_UART_LZ)
+    /* uart_send_large sıkıştırma durumu; aynı anda tek segmentli gönderim */
+    struct k_mutex lz_lock;
+    lz_enc_t lz_enc;
+    uint8_t lz_buf[UART_IO_LZ_SEG_MAX];
+#endif
 
-/* Çift RX buffer (ping-pong) */
-static uint8_t async_rx_buffer[2][UART_RX_CHUNK_LEN];
-static volatile uint8_t async_idx;
+    /* Tüm katmanların sayaçları (ISR'de log yok, sadece sayaç) */
+    uart_stats_t stats;
+};
 
-/* RX_RDY event’inde gelen buffer-ofset takibi */
-static const uint8_t *rx_buf;
-static size_t rx_off;      /* evt->data.rx.offset */
-static size_t rx_prev_len; /* aynı buffer için önceki len */
+#if IS_ENABLED(CONFIG_CUSTOM_UART_TX_COALESCE)
+/* Birden çok frame tek uart_tx ile gider; kablodaki format değişmez. Buffer'a
+ * sığmayan (jumbo) frame tek başına doğrudan slot'tan gider. */
+BUILD_ASSERT(UART_TX_COALESCE_BYTES >= FRAME_OVERHEAD_BYTES + UART_MAX_PACKET_SIZE,
+             "coalesce buffer must hold one frame");
+#define UART_IO_COAL_DEFINE(n) static uint8_t uart_io_coal_##n[UART_TX_COALESCE_BYTES];
+#define UART_IO_COAL_INIT(n) .coal_buf = uart_io_coal_##n,
+#else
+#define UART_IO_COAL_DEFINE(n)
+#define UART_IO_COAL_INIT(n)
+#endif
 
-/* ISR hafif tutulsun: decode/parse burada yok; sadece work tetikleyeceğiz */
+#define UART_IO_REASM_N(x) (IS_ENABLED(CONFIG_CUSTOM_UART_REASM) ? (x) : 0)
+
+#define UART_IO_CTX_DEFINE(n, uart_node, rb_sz, chunk, nbufs, pool, txd, rslots, idle_us)         \
+    BUILD_ASSERT((pool) > 0 && (txd) > 0 && (txd) <= 255, "uart-io: invalid queue depth");        \
+    BUILD_ASSERT((nbufs) >= 2 && (nbufs) <= UART_RX_BUF_MAX, "uart-io: invalid rx-buf-count");    \
+    BUILD_ASSERT((rslots) <= 255, "uart-io: too many reassembly slots");                          \
+    BUILD_ASSERT(!IS_ENABLED(CONFIG_CUSTOM_UART_RX_OVF_PRIORITY) ||                               \
+                 (pool) > UART_RX_PRIO_RESERVE,                                                   \
+                 "uart-io: rx-pool-depth must exceed CUSTOM_UART_RX_PRIO_RESERVE");               \
+    static uint8_t uart_io_rb_mem_##n[rb_sz];                                                     \
+    static uint8_t uart_io_rx_bufs_##n[(nbufs) * (chunk)] __aligned(4);                           \
+    K_MEM_SLAB_DEFINE_STATIC(uart_io_rx_slab_##n, FRAMER_BLOCK_SIZE, pool, 4);                    \
+    K_MSGQ_DEFINE(uart_io_rx_msgq_##n, sizeof(uart_frame_t *), pool, 4);                          \
+    K_MEM_SLAB_DEFINE_STATIC(uart_io_tx_slab_##n, ROUND_UP(sizeof(tx_slot_t), 4), txd, 4);        \
+    static tx_slot_t *uart_io_tx_ring_##n[txd];                                                   \
+    static reasm_slot_t uart_io_reasm_##n[UART_IO_REASM_N(rslots)];                               \
+    UART_IO_COAL_DEFINE(n)                                                                        \
+    static const uart_io_cfg_t uart_io_cfg_##n = {                                                \
+        .dev = DEVICE_DT_GET(uart_node),                                                          \
+        .baud = DT_PROP_OR(uart_node, current_speed, 115200),                                     \
+        .rx_idle_us = (idle_us),                                                                  \
+        .rb_mem = uart_io_rb_mem_##n,                                                             \
+        .rb_size = (rb_sz),                                                                       \
+        .rx_bufs = uart_io_rx_bufs_##n,                                                           \
+        .chunk_len = (chunk),                                                                     \
+        .rx_nbufs = (nbufs),                                                                      \
+        .rx_slab = &uart_io_rx_slab_##n,                                                          \
+        .rx_msgq = &uart_io_rx_msgq_##n,                                                          \
+        .rx_depth = (pool),                                                                       \
+        .tx_slab = &uart_io_tx_slab_##n,                                                          \
+        .tx_ring = uart_io_tx_ring_##n,                                                           \
+        .tx_depth = (txd),                                                                        \
+        .rts = DT_PROP_OR(uart_node, hw_flow_control, 0),                                         \
+        UART_IO_COAL_INIT(n)                                                                      \
+        .reasm_slots = uart_io_reasm_##n,                                                         \
+        .reasm_nslots = UART_IO_REASM_N(rslots),                                                  \
+    };                                                                                            \
+    static struct uart_io_ctx uart_io_ctx_##n = {.cfg = &uart_io_cfg_##n};
+
+#if DT_HAS_COMPAT_STATUS_OKAY(DT_DRV_COMPAT)
+/* dts: uart-io-host { compatible = "custom,uart-io"; uart = <&usart1>; ... };
+ * Verilmeyen boyutlar Kconfig varsayılanlarını alır. */
+#define UART_IO_INST_DEFINE(inst)                                                  \
+    UART_IO_CTX_DEFINE(inst, DT_INST_PHANDLE(inst, uart),                          \
+                       DT_INST_PROP_OR(inst, rx_ring_size, UART_RB_SZ),            \
+                       DT_INST_PROP_OR(inst, rx_chunk_size, UART_RX_CHUNK_LEN),    \
+                       DT_INST_PROP_OR(inst, rx_buf_count, UART_RX_BUF_COUNT),     \
+                       DT_INST_PROP_OR(inst, rx_pool_depth, UART_MSGQ_DEPTH),      \
+                       DT_INST_PROP_OR(inst, tx_queue_depth, UART_TX_QUEUE_DEPTH), \
+                       DT_INST_PROP_OR(inst, reasm_slots, UART_REASM_SLOTS),       \
+                       DT_INST_PROP_OR(inst, rx_idle_timeout_us, UART_RX_IDLE_TIMEOUT_US))
+#define UART_IO_INST_REF(inst) &uart_io_ctx_##inst,
+
+DT_INST_FOREACH_STATUS_OKAY(UART_IO_INST_DEFINE)
+static struct uart_io_ctx *const uart_io_ctxs[] = {DT_INST_FOREACH_STATUS_OKAY(UART_IO_INST_REF)};
+#else
+/* custom,uart-io düğümü yoksa tek port: uart-com alias'ı + Kconfig boyutları */
+UART_IO_CTX_DEFINE(0, UART_DEVICE_NODE, UART_RB_SZ, UART_RX_CHUNK_LEN, UART_RX_BUF_COUNT, UART_MSGQ_DEPTH,
+                   UART_TX_QUEUE_DEPTH, UART_REASM_SLOTS, UART_RX_IDLE_TIMEOUT_US)
+static struct uart_io_ctx *const uart_io_ctxs[] = {&uart_io_ctx_0};
+#endif
 
-/* İstatistik (opsiyonel; ISR’de log yok, sadece sayaç) */
-static volatile uint32_t stat_drop_bytes;
+/* Eski tek-port API'si ilk instance'a gider */
+#define UART_IO_DEFAULT (uart_io_ctxs[0])
 
+/* Senkron gönderim: bir veya daha çok frame'in tamamlanmasını bekler */
 typedef struct
 {
-    struct k_sem lock;   /* gönderim sırası: 1 → yalnızca bir thread */
-    struct k_sem done;   /* TX_DONE/TX_ABORTED sinyali */
-    volatile bool armed; /* aktif bir TX var mı */
-} tx_ctx_t;
+    struct k_sem done; /* tamamlanan her frame için bir give */
+    uint16_t queued;
+    int result;
+} tx_batch_t;
+
+#if IS_ENABLED(CONFIG_CUSTOM_UART_FLOW_CTRL)
+static void flow_update(struct uart_io_ctx *ctx);
+#else
+static inline void flow_update(struct uart_io_ctx *ctx) { ARG_UNUSED(ctx); }
+#endif
 
-tx_ctx_t tx_ctx = {
-    .armed = false};
+/* drop-newest: ISR kesintiden sonra halkaya yazmaz; halkada kalanlar bittiğinde
+ * akış tam kesinti noktasındadır, yarım frame orada atılır */
+static void rx_gap_close(struct uart_io_ctx *ctx, bool gap)
+{
+    if (!gap)
+        return;
+    framer_discard(&ctx->framer);
+    atomic_clear(&ctx->rx_gap);
+}
+
+#if !IS_ENABLED(CONFIG_CUSTOM_UART_RX_OVF_DROP_OLDEST)
+/* on_rx_reenable'ın istediği sıfırlama; claim tutulmazken çağrılır. ISR o
+ * zamandan beri halkaya yazmıyor (rx_gap): halkadakilerin hepsi eski akış */
+static bool rx_reset_take(struct uart_io_ctx *ctx)
+{
+    if (!atomic_get(&ctx->rx_reset))
+        return false;
+    ring_buf_reset(&ctx->rb);
+    framer_reset(&ctx->framer);
+    atomic_clear(&ctx->rx_reset);
+    atomic_clear(&ctx->rx_gap);
+    return true;
+}
+#endif
 
+#if IS_ENABLED(CONFIG_CUSTOM_UART_RX_ZERO_COPY)
 static void rx_drain_worker(struct k_work *work)
 {
+    struct uart_io_ctx *ctx = CONTAINER_OF(work, struct uart_io_ctx, rx_drain_work);
+    bool gap = atomic_get(&ctx->rx_gap) != 0; /* drain'den önce: sonra gelen kesinti yeni submit getirir */
+    uint8_t *p;
+    uint32_t g;
+    ctx->framer.t_rx = ctx->rx_isr_cyc; /* bu drain'in teslim ettiği frame'lerin RX zamanı */
+    do
+    {
+        if (rx_reset_take(ctx))
+            gap = false; /* kesinti sıfırlamayla kapandı */
 
-    ARG_UNUSED(work);
+        /* Kopyasız: ring buffer içindeki bitişik bölgeyi doğrudan parse et */
+        g = ring_buf_get_claim(&ctx->rb, &p, ctx->cfg->rb_size);
+        if (g)
+        {
+            framer_push_bytes(&ctx->framer, p, g);
+            (void)ring_buf_get_finish(&ctx->rb, g);
+        }
+    } while (g > 0);
+
+    rx_gap_close(ctx, gap);
+    flow_update(ctx);
+}
+#else
+static void rx_drain_worker(struct k_work *work)
+{
+    struct uart_io_ctx *ctx = CONTAINER_OF(work, struct uart_io_ctx, rx_drain_work);
+    bool gap = atomic_get(&ctx->rx_gap) != 0;
     uint8_t tmp[256];
     size_t g;
+    ctx->framer.t_rx = ctx->rx_isr_cyc;
     do
     {
-        g = ring_buf_get(&uart_rb, tmp, sizeof(tmp));
+#if IS_ENABLED(CONFIG_CUSTOM_UART_RX_OVF_DROP_OLDEST)
+        /* ISR de halkadan tüketir (tahliye); okuma aynı kilit altında */
+        k_spinlock_key_t key = k_spin_lock(&ctx->rb_lock);
+        g = ring_buf_get(&ctx->rb, tmp, sizeof(tmp));
+        bool cut = ctx->rx_evicted;
+        bool reset = atomic_clear(&ctx->rx_reset) != 0;
+        ctx->rx_evicted = false;
+        k_spin_unlock(&ctx->rb_lock, key);
+
+        /* Tahliye okuma başından yapılır: kesinti tam bu baytlardan önce.
+         * Sıfırlamada halkayı ISR boşalttı; okunanlar yeni akışın başı */
+        if (reset)
+            framer_reset(&ctx->framer);
+        else if (cut)
+            framer_discard(&ctx->framer);
+#else
+        if (rx_reset_take(ctx))
+            gap = false;
+        g = ring_buf_get(&ctx->rb, tmp, sizeof(tmp));
+#endif
         if (g)
-            framer_push_bytes(tmp, g);
+            framer_push_bytes(&ctx->framer, tmp, g);
     } while (g > 0);
+
+    rx_gap_close(ctx, gap);
+    flow_update(ctx);
 }
+#endif
 
-static size_t rb_make_room(struct ring_buf *rb, size_t need)
+#if IS_ENABLED(CONFIG_CUSTOM_UART_RX_OVF_DROP_OLDEST)
+/* İlk frame sınırı: COBS ayracı veya SYNC (jumbo'da iki SYNC'ten önce gelen,
+ * framer'ın q_find_sync'i gibi) */
+static inline const uint8_t *rx_find_boundary(const uint8_t *b, size_t n)
 {
+#if IS_ENABLED(CONFIG_CUSTOM_UART_COBS)
+    return memchr(b, COBS_DELIM, n);
+#else
+    const uint8_t *s = memchr(b, SYNC_BYTE, n);
+#if IS_ENABLED(CONFIG_CUSTOM_UART_JUMBO)
+    const uint8_t *j = memchr(b, SYNC_BYTE_JUMBO, s ? (size_t)(s - b) : n);
+    if (j)
+        s = j;
+#endif
+    return s;
+#endif
+}
+
+/* En eski uçtan bütün frame'leri at: okuma başından sonraki ilk frame sınırına
+ * (SYNC / COBS ayracı) kadar, yer açılana dek tekrar. rb_lock altında çağrılır.
+ * ISR işi sınırlıdır: en fazla need + bir klasik frame bayt taranır; bu pencerede
+ * sınır yoksa (çöp akış veya daha uzun bir jumbo frame) pencere bütün olarak
+ * atılır, drain yine kesinti görür. */
+static void rb_evict_frames(struct uart_io_ctx *ctx, size_t need)
+{
+    bool skip = true; /* okuma başındaki sınır tahliye edilen frame'in kendisidir */
+    size_t budget = need + FRAME_OVERHEAD_BYTES + UART_MAX_PACKET_SIZE;
     size_t freed = 0;
-    uint8_t dump[64];
-    while (ring_buf_space_get(rb) < need)
+    uint8_t *p;
+
+    /* Yer açılsa da sınıra kadar devam: halkanın sarma noktası frame ortasıysa
+     * ilk claim orada biter, kalan yarım frame okuma başında kalmamalı */
+    while ((ring_buf_space_get(&ctx->rb) < need || !skip) && freed < budget)
     {
-        size_t g = ring_buf_get(rb, dump, sizeof(dump));
-        if (g == 0)
+        uint32_t g = ring_buf_get_claim(&ctx->rb, &p, (uint32_t)(budget - freed));
+        if (!g)
             break;
-        freed += g;
+        uint32_t from = skip ? 1u : 0u;
+        const uint8_t *b = from < g ? rx_find_boundary(&p[from], g - from) : NULL;
+        uint32_t n = b ? (uint32_t)(b - p) : g;
+        (void)ring_buf_get_finish(&ctx->rb, n);
+        freed += n;
+        skip = b != NULL;
+        if (b)
+            uart_stat_inc(&ctx->stats, UART_STAT_RX_OVF_EVICT);
     }
-    stat_drop_bytes += freed;
-    return freed;
+    if (freed)
+        ctx->rx_evicted = true;
+    uart_stat_add(&ctx->stats, UART_STAT_RX_DROP_BYTES, freed);
 }
+#endif
 
-/* ---- Event handler’lar (ISR bağlamı) ---- */
-static void on_rx_rdy(const struct device *dev, struct uart_event *evt, void *user)
+static inline uint8_t *rx_chunk(struct uart_io_ctx *ctx, uint8_t idx)
 {
-    ARG_UNUSED(dev);
-    ARG_UNUSED(user);
+    return &ctx->cfg->rx_bufs[idx * ctx->cfg->chunk_len];
+}
+
+static inline uint8_t rx_chunk_idx(struct uart_io_ctx *ctx, const uint8_t *buf)
+{
+    return (uint8_t)((size_t)(buf - ctx->cfg->rx_bufs) / ctx->cfg->chunk_len);
+}
 
-    /* Aynı DMA buffer’ında mıyız? */
-    if (evt->data.rx.buf != rx_buf || evt->data.rx.offset != rx_off)
+/* Sürücüde olmayan sıradaki buffer'ı sahiplen; hepsi sürücüdeyse -1.
+ * Yalnızca UART callback'inden (ISR) çağrılır. */
+static int rx_buf_take(struct uart_io_ctx *ctx)
+{
+    uint8_t n = ctx->cfg->rx_nbufs;
+
+    for (uint8_t k = 0; k < n; k++)
     {
-        rx_buf = evt->data.rx.buf;
-        rx_off = evt->data.rx.offset;
-        rx_prev_len = 0;
+        uint8_t i = (uint8_t)((ctx->rx_next + k) % n);
+        if (ctx->rx_owned & BIT(i))
+            continue;
+        ctx->rx_owned |= BIT(i);
+        ctx->rx_next = (uint8_t)((i + 1) % n);
+        return i;
     }
+    return -1;
+}
+
+/* ---- RX DMA ayarı ---- */
 
-    size_t total = evt->data.rx.len; /* bu buffer’daki toplam doldurulmuş uzunluk */
-    if (total < rx_prev_len)
+static uint32_t rx_baud(const uart_io_cfg_t *cfg)
+{
+#if IS_ENABLED(CONFIG_UART_USE_RUNTIME_CONFIGURE)
+    struct uart_config uc;
+    if (uart_config_get(cfg->dev, &uc) == 0 && uc.baudrate)
+        return uc.baudrate;
+#endif
+    return cfg->baud;
+}
+
+/* 8N1: karakter başına 10 bit */
+static int32_t rx_chars_us(uint32_t baud, uint32_t chars)
+{
+    return (int32_t)DIV_ROUND_UP((uint64_t)chars * 10u * USEC_PER_SEC, baud);
+}
+
+static void rx_tune_init(struct uart_io_ctx *ctx)
+{
+    const uart_io_cfg_t *cfg = ctx->cfg;
+    uint32_t baud = MAX(rx_baud(cfg), 1u);
+
+    ctx->rx_tmo_us = cfg->rx_idle_us ? (int32_t)cfg->rx_idle_us : rx_chars_us(baud, UART_RX_IDLE_CHARS);
+
+#if IS_ENABLED(CONFIG_CUSTOM_UART_RX_ADAPTIVE)
+    rx_adapt_t *a = &ctx->adapt;
+    a->len[RX_PROF_LAT] = MIN(UART_RX_ADAPT_SMALL_CHUNK, cfg->chunk_len);
+    a->len[RX_PROF_BULK] = cfg->chunk_len;
+    a->tmo_us[RX_PROF_LAT] = ctx->rx_tmo_us;
+    a->tmo_us[RX_PROF_BULK] = MAX(rx_chars_us(baud, UART_RX_ADAPT_GAP_CHARS), ctx->rx_tmo_us);
+    for (int i = 0; i < RX_PROF_COUNT; i++)
+        a->tmo_cyc[i] = k_us_to_cyc_ceil32(a->tmo_us[i]);
+    a->char_cyc = (uint32_t)((uint64_t)sys_clock_hw_cycles_per_sec() * 10u / baud);
+    a->gap_cyc = a->char_cyc * UART_RX_ADAPT_GAP_CHARS;
+    a->cur = a->want = RX_PROF_LAT;
+    a->dense = 0;
+    a->run = 0;
+    a->bulk_run = (uint16_t)(RX_ADAPT_BULK_AFTER * cfg->chunk_len);
+    a->retune = false;
+    a->quiet = false;
+    a->last_cyc = k_cycle_get_32();
+#endif
+}
+
+/* DMA'ya verilecek buffer'ın boyu; adaptif modda ölçülen profile göre */
+static uint16_t rx_buf_len(struct uart_io_ctx *ctx, uint8_t idx)
+{
+#if IS_ENABLED(CONFIG_CUSTOM_UART_RX_ADAPTIVE)
+    return ctx->adapt.buf_len[idx] = ctx->adapt.len[ctx->adapt.want];
+#else
+    ARG_UNUSED(idx);
+    return ctx->cfg->chunk_len;
+#endif
+}
+
+static int rx_start(struct uart_io_ctx *ctx)
+{
+#if IS_ENABLED(CONFIG_CUSTOM_UART_RX_ADAPTIVE)
+    ctx->adapt.cur = ctx->adapt.want;
+    ctx->rx_tmo_us = ctx->adapt.tmo_us[ctx->adapt.cur];
+#endif
+    /* RX kapalıyken sürücü tüm buffer'ları bırakmıştır */
+    ctx->rx_owned = BIT(0);
+    ctx->rx_next = 1;
+    return uart_rx_enable(ctx->cfg->dev, rx_chunk(ctx, 0), rx_buf_len(ctx, 0), ctx->rx_tmo_us);
+}
+
+#if IS_ENABLED(CONFIG_CUSTOM_UART_RX_ADAPTIVE)
+/* ISR. Buffer dolmadan gelen RX_RDY timeout'tur ve bir burst'ü bitirir. Sonraki
+ * burst'ün ilk olayında, önceki burst'ün son baytından bu yana geçen süreden
+ * yeni baytların hat süresi ve (varsa) bu olayın timeout'u çıkarılınca
+ * burst'ler arasındaki boşluk kalır. Büyük buffer'da kalan, aradaki kısa
+ * boşlukların toplamı da olabilir: ölçüm yalnız küçük buffer'da yapılır. Akış
+ * profilinin timeout'u ise tek başına uzun boşluğu gösterir. Uzun boşluk:
+ * komut/yanıt. Art arda kısa boşluklar veya RX_ADAPT_BULK_AFTER tam buffer'lık
+ * kesintisiz burst: akış. */
+static void rx_adapt(struct uart_io_ctx *ctx, const struct uart_event *evt, size_t delta)
+{
+    rx_adapt_t *a = &ctx->adapt;
+    uint16_t len = a->buf_len[rx_chunk_idx(ctx, evt->data.rx.buf)];
+    bool idle = evt->data.rx.offset + evt->data.rx.len < len;
+    uint32_t tmo = idle ? a->tmo_cyc[a->cur] : 0u;
+    uint32_t busy = (uint32_t)delta * a->char_cyc + tmo;
+
+    if (a->run == 0)
     {
-        /* Güvenlik: bazı sürücülerde wrap olabilir */
-        rx_prev_len = 0;
+        if (a->quiet || (len <= a->len[RX_PROF_LAT] && ctx->rx_isr_cyc - a->last_cyc > busy + a->gap_cyc))
+        {
+            /* Uzun boşluk: hemen düşük gecikmeye dön */
+            a->dense = 0;
+            a->want = RX_PROF_LAT;
+        }
+        else if (a->dense < RX_ADAPT_BULK_AFTER && ++a->dense == RX_ADAPT_BULK_AFTER)
+        {
+            a->want = RX_PROF_BULK;
+        }
+    }
+    /* Profil aşağıda değişebilir: son bayt bu olayın timeout'uyla bulunur */
+    a->last_cyc = ctx->rx_isr_cyc - tmo;
+    a->quiet = idle && a->tmo_cyc[a->cur] >= a->gap_cyc;
+    a->run = idle ? 0 : (uint16_t)MIN(a->run + delta, a->bulk_run);
+    if (a->run == a->bulk_run)
+    {
+        a->dense = RX_ADAPT_BULK_AFTER;
+        a->want = RX_PROF_BULK;
     }
 
-    size_t delta = total - rx_prev_len; /* yeni gelen kısım */
-    if (!delta)
-        return;
+    /* Timeout yalnızca uart_rx_enable ile değişir. Timeout olayı hattın en az
+     * timeout kadar sessiz olduğunu söyler: yeniden başlatmak için en güvenli
+     * an. Halka ve parser durumu korunur (on_rx_reenable). */
+    if (idle && a->want != a->cur && !a->retune)
+    {
+        a->retune = true;
+        if (uart_rx_disable(ctx->cfg->dev) != 0)
+            a->retune = false;
+    }
+}
+#endif
 
-    const uint8_t *p = evt->data.rx.buf + evt->data.rx.offset + rx_prev_len;
+/* ---- Event handler’lar (ISR bağlamı) ---- */
+static void on_rx_rdy(const struct device *dev, struct uart_event *evt, void *user)
+{
+    ARG_UNUSED(dev);
+    struct uart_io_ctx *ctx = user;
 
-    /* Yer aç; en eskileri at */
-    (void)rb_make_room(&uart_rb, delta);
+    /* Zephyr RX_RDY artımlıdır: yalnız buf[offset, offset+len) yenidir; aynı
+     * buffer'daki sonraki event bir önceki offset+len'den başlar. Takip gerekmez. */
+    size_t delta = evt->data.rx.len;
+    if (!delta)
+        return;
 
-    size_t w = ring_buf_put(&uart_rb, p, delta);
-    /* Yer kalmadıysa kalan baytlar düşer; UART’ı kapatmayız */
+    const uint8_t *p = evt->data.rx.buf + evt->data.rx.offset;
+    ctx->rx_isr_cyc = k_cycle_get_32();
+    uart_stat_add(&ctx->stats, UART_STAT_RX_BYTES, delta);
+
+#if IS_ENABLED(CONFIG_CUSTOM_UART_RX_OVF_DROP_OLDEST)
+    /* Yer aç: en eski bütün frame'leri at, yeni baytlar korunur */
+    k_spinlock_key_t key = k_spin_lock(&ctx->rb_lock);
+    if (ring_buf_space_get(&ctx->rb) < delta)
+        rb_evict_frames(ctx, delta);
+    size_t w = ring_buf_put(&ctx->rb, p, delta);
+    k_spin_unlock(&ctx->rb_lock, key);
+    if (w < delta)
+        uart_stat_add(&ctx->stats, UART_STAT_RX_DROP_BYTES, delta - w); /* chunk halkadan büyük */
+#else
+    /* drop-newest: kesinti kapanana (halka boşalana) kadar gelen her şey düşer;
+     * kesintiden sonraki baytlar önceki yarım frame'e eklenip CRC hatası üretmez */
+    size_t w = atomic_get(&ctx->rx_gap) ? 0 : ring_buf_put(&ctx->rb, p, delta);
     if (w < delta)
     {
-        stat_drop_bytes += (delta - w);
+        if (!atomic_set(&ctx->rx_gap, 1))
+            uart_stat_inc(&ctx->stats, UART_STAT_RX_OVF_GAPS);
+        uart_stat_add(&ctx->stats, UART_STAT_RX_DROP_BYTES, delta - w);
     }
+#endif
+    uart_stat_max(&ctx->stats, UART_STAT_RB_HWM, ring_buf_size_get(&ctx->rb));
 
-    rx_prev_len = total;
+#if IS_ENABLED(CONFIG_CUSTOM_UART_RX_ADAPTIVE)
+    rx_adapt(ctx, evt, delta);
+#endif
+
+    /* Eşik aşıldıysa karşı tarafı hemen durdur; drain beklenmez */
+    flow_update(ctx);
 
     /* Thread tarafına tüketim sinyali: ağır iş orada yapılacak */
-    k_work_submit(&rx_drain_work);
+    k_work_submit_to_queue(&uart_io_rx_wq, &ctx->rx_drain_work);
 }
 
 static void on_rx_buf_request(const struct device *dev, struct uart_event *evt, void *user)
 {
     ARG_UNUSED(evt);
-    ARG_UNUSED(user);
-    int rc = uart_rx_buf_rsp(dev, async_rx_buffer[async_idx], UART_RX_CHUNK_LEN);
-    __ASSERT_NO_MSG(rc == 0);
-    (void)rc;
-    async_idx ^= 1;
+    struct uart_io_ctx *ctx = user;
+    int i = rx_buf_take(ctx);
+
+    if (i < 0)
+    {
+        /* Hepsi hâlâ sürücüde: yanıt verilmez. Sürücü elindeki buffer dolunca
+         * RX'i kapatır, on_rx_reenable temiz başlatır (sayaç: rx_buf_none). */
+        uart_stat_inc(&ctx->stats, UART_STAT_RX_BUF_NONE);
+        return;
+    }
+    if (uart_rx_buf_rsp(dev, rx_chunk(ctx, i), rx_buf_len(ctx, i)) != 0)
+        ctx->rx_owned &= ~BIT(i); /* RX bu arada kapandı */
 }
 
 static void on_rx_buf_released(const struct device *dev, struct uart_event *evt, void *user)
 {
     ARG_UNUSED(dev);
-    ARG_UNUSED(user);
-    if (evt->data.rx_buf.buf == rx_buf)
-    {
-        rx_buf = NULL;
-        rx_off = 0;
-        rx_prev_len = 0;
-    }
+    struct uart_io_ctx *ctx = user;
+
+    ctx->rx_owned &= ~BIT(rx_chunk_idx(ctx, evt->data.rx_buf.buf));
     /* Buffer değiştiyse, tüketimi hızlandır */
-    k_work_submit(&rx_drain_work);
+    k_work_submit_to_queue(&uart_io_rx_wq, &ctx->rx_drain_work);
 }
 
 static void on_rx_reenable(const struct device *dev, struct uart_event *evt, void *user)
 {
+    ARG_UNUSED(dev);
+    struct uart_io_ctx *ctx = user;
+
+#if IS_ENABLED(CONFIG_CUSTOM_UART_RX_ADAPTIVE)
+    if (evt->type == UART_RX_DISABLED && ctx->adapt.retune)
+    {
+        /* Profil değişimi: halkadaki ve parser'daki veri geçerli, yalnız DMA yeniden */
+        ctx->adapt.retune = false;
+        uart_stat_inc(&ctx->stats, UART_STAT_RX_RETUNE);
+        (void)rx_start(ctx);
+        return;
+    }
+#else
     ARG_UNUSED(evt);
-    ARG_UNUSED(user);
+#endif
 
-    /* Hata/stop durumunda temiz başla */
-    unsigned int key = irq_lock();
-    ring_buf_reset(&uart_rb);
-    rx_prev_len = 0;
-    rx_buf = NULL;
-    rx_off = 0;
-    irq_unlock(key);
-    framer_reset();
+    /* Hata/stop durumunda temiz başla. Drain bu an bir claim tutuyor veya
+     * framer_push_bytes içinde olabilir: halka ve parser onundur, sıfırlama
+     * drain'e bırakılır. O zamana kadar gelen baytlar halkaya yazılmaz. */
+#if IS_ENABLED(CONFIG_CUSTOM_UART_RX_OVF_DROP_OLDEST)
+    /* Bu yapıda drain halkayı rb_lock altında kopyalar, claim tutmaz */
+    k_spinlock_key_t key = k_spin_lock(&ctx->rb_lock);
+    ring_buf_reset(&ctx->rb);
+    atomic_set(&ctx->rx_reset, 1);
+    k_spin_unlock(&ctx->rb_lock, key);
+#else
+    atomic_set(&ctx->rx_gap, 1);
+    atomic_set(&ctx->rx_reset, 1);
+#endif
+    k_work_submit_to_queue(&uart_io_rx_wq, &ctx->rx_drain_work);
 
-    async_idx = 1;
-    (void)uart_rx_enable(dev, async_rx_buffer[0], UART_RX_CHUNK_LEN, 20 /* ms timeout */);
+    (void)rx_start(ctx);
 }
 
+static void tx_complete_head(struct uart_io_ctx *ctx, int result);
+
 static void on_tx_done(const struct device *dev, struct uart_event *evt, void *user)
 {
     ARG_UNUSED(dev);
     ARG_UNUSED(evt);
-    ARG_UNUSED(user);
-    if (tx_ctx.armed)
-    {
-        /* ISR’dan çağrılabilir: k_sem_give güvenli */
-        k_sem_give(&tx_ctx.done);
-    }
+    tx_complete_head(user, 0);
 }
 
 static void on_tx_aborted(const struct device *dev, struct uart_event *evt, void *user)
 {
     ARG_UNUSED(dev);
     ARG_UNUSED(evt);
-    ARG_UNUSED(user);
-    if (tx_ctx.armed)
-    {
-        k_sem_give(&tx_ctx.done);
-    }
+    struct uart_io_ctx *ctx = user;
+    uart_stat_inc(&ctx->stats, UART_STAT_TX_ABORTS);
+    tx_complete_head(ctx, -ECANCELED);
 }
 
 /* ---- Tek callback: uart_handler_cb ---- */
@@ -216,170 +717,930 @@ static void uart_handler_cb(const struct device *dev, struct uart_event *evt, vo
 
 /* ============================================ * UART TX * ============================================*/
 
-static int uart_send_frame(const struct device *uart_dev, const uint8_t *payload, uint8_t len, k_timeout_t timeout)
+/* Kuyruğa alınan frame'ler önceden kurulur; sıradaki DMA transferi
+ * on_tx_done (ISR) içinden başlatılır, hat frame'ler arasında boş kalmaz. */
+
+static void tx_batch_cb(int result, void *user)
+{
+    tx_batch_t *b = user;
+    if (result && !b->result)
+        b->result = result;
+    k_sem_give(&b->done); /* son erişim: bekleyen bundan sonra dönebilir */
+}
+
+static inline void tx_batch_init(tx_batch_t *b)
+{
+    k_sem_init(&b->done, 0, K_SEM_MAX_LIMIT);
+    b->queued = 0;
+    b->result = 0;
+}
+
+static inline tx_slot_t *tx_at(struct uart_io_ctx *ctx, uint8_t i)
+{
+    return ctx->cfg->tx_ring[(ctx->txq.head + i) % ctx->cfg->tx_depth];
+}
+
+/* DMA'daki frame'leri kuyruktan çıkarıp liste olarak döner; sıradaki varsa busy kalır (kilit altında) */
+static tx_slot_t *tx_pop_inflight_locked(struct uart_io_ctx *ctx)
+{
+    tx_queue_t *txq = &ctx->txq;
+    tx_slot_t *list = NULL, **tail = &list;
+
+    for (uint8_t i = 0; i < txq->inflight; i++)
+    {
+        tx_slot_t *s = tx_at(ctx, 0);
+        txq->head = (txq->head + 1) % ctx->cfg->tx_depth;
+        txq->count--;
+#if IS_ENABLED(CONFIG_CUSTOM_UART_TX_COALESCE)
+        txq->bytes -= s->len;
+#endif
+        s->next = NULL;
+        *tail = s;
+        tail = &s->next;
+    }
+    txq->inflight = 0;
+    txq->busy = (txq->count > 0);
+    return list;
+}
+
+/* Bu transfere girecek frame'leri seç (kilit altında). Tek frame slot'tan,
+ * birden çoğu birleştirme buffer'ından gönderilir. */
+static uint8_t tx_select_locked(struct uart_io_ctx *ctx, size_t *len)
 {
-    if (!uart_dev)
+    tx_queue_t *txq = &ctx->txq;
+    uint8_t n = 1;
+    size_t total = tx_at(ctx, 0)->len;
+
+#if IS_ENABLED(CONFIG_CUSTOM_UART_TX_COALESCE)
+    while (n < txq->count)
+    {
+        tx_slot_t *c = tx_at(ctx, n);
+        if (total + c->len > UART_TX_COALESCE_BYTES)
+            break;
+        total += c->len;
+        n++;
+    }
+#endif
+
+    txq->inflight = n;
+    *len = total;
+    return n;
+}
+
+/* Listedeki slot'ları serbest bırak ve callback'leri çağır */
+static void tx_slots_done(struct uart_io_ctx *ctx, tx_slot_t *list, int result)
+{
+    uint32_t now = k_cycle_get_32();
+
+    while (list)
+    {
+        tx_slot_t *s = list;
+        uart_io_tx_cb_t cb = s->cb;
+        void *user = s->user;
+
+        if (result == 0)
+            uart_stat_hist(&ctx->stats, UART_STATS_HIST_TX, now - s->t_enq);
+        list = s->next;
+        k_mem_slab_free(ctx->cfg->tx_slab, s);
+        if (cb)
+            cb(result, user);
+    }
+}
+
+/* Kuyruk başındaki frame(ler)i DMA'ya ver; uart_tx reddederse tamamla ve devam et */
+static void tx_start_head(struct uart_io_ctx *ctx)
+{
+    tx_queue_t *txq = &ctx->txq;
+
+    for (;;)
+    {
+        size_t len;
+        k_spinlock_key_t key = k_spin_lock(&txq->lock);
+        if (!txq->busy || txq->inflight || !txq->count)
+        {
+            /* boşta ya da başka bir bağlam transferi çoktan başlattı */
+            k_spin_unlock(&txq->lock, key);
+            return;
+        }
+#if IS_ENABLED(CONFIG_CUSTOM_UART_TX_COALESCE)
+        txq->holding = false;
+#endif
+        uint8_t n = tx_select_locked(ctx, &len);
+        tx_slot_t *s = tx_at(ctx, 0);
+        k_spin_unlock(&txq->lock, key);
+
+        /* Seçilen slot'lar tamamlanana kadar kuyruktan çıkmaz; kilit dışında okunabilir */
+        const uint8_t *buf = s->buf;
+#if IS_ENABLED(CONFIG_CUSTOM_UART_TX_COALESCE)
+        if (n > 1)
+        {
+            size_t off = 0;
+            for (uint8_t i = 0; i < n; i++)
+            {
+                tx_slot_t *c = tx_at(ctx, i);
+                memcpy(&ctx->cfg->coal_buf[off], c->buf, c->len);
+                off += c->len;
+            }
+            buf = ctx->cfg->coal_buf;
+        }
+#endif
+
+        int rc = uart_tx(ctx->cfg->dev, buf, len, SYS_FOREVER_MS);
+        if (rc == 0)
+        {
+            uart_stat_inc(&ctx->stats, UART_STAT_TX_XFERS);
+            uart_stat_add(&ctx->stats, UART_STAT_TX_FRAMES, n);
+            uart_stat_add(&ctx->stats, UART_STAT_TX_BYTES, len);
+            uart_stat_max(&ctx->stats, UART_STAT_TX_MAX_BATCH, n);
+            return;
+        }
+        uart_stat_inc(&ctx->stats, UART_STAT_TX_ERRORS);
+
+        key = k_spin_lock(&txq->lock);
+        tx_slot_t *done = tx_pop_inflight_locked(ctx);
+        k_spin_unlock(&txq->lock, key);
+        tx_slots_done(ctx, done, rc);
+    }
+}
+
+/* TX_DONE/TX_ABORTED: önce sıradakini başlat, sonra callback'ler (ISR bağlamı) */
+static void tx_complete_head(struct uart_io_ctx *ctx, int result)
+{
+    k_spinlock_key_t key = k_spin_lock(&ctx->txq.lock);
+    tx_slot_t *done = tx_pop_inflight_locked(ctx);
+    k_spin_unlock(&ctx->txq.lock, key);
+    if (!done)
+        return;
+
+    tx_start_head(ctx);
+    tx_slots_done(ctx, done, result);
+}
+
+#if IS_ENABLED(CONFIG_CUSTOM_UART_TX_COALESCE)
+/* Gecikme üst sınırı: tek bekleyen frame en fazla pencere kadar tutulur */
+static void tx_hold_expired(struct k_timer *timer)
+{
+    tx_start_head(CONTAINER_OF(timer, struct uart_io_ctx, tx_hold_timer));
+}
+#endif
+
+/* Parçalar doğrudan DMA'ya ait slot buffer'ına yazılır; ara kopya yok */
+static int tx_enqueue_v(struct uart_io_ctx *ctx, const uart_iovec_t *iov, size_t iovcnt,
+                        uart_io_tx_cb_t cb, void *user, k_timeout_t timeout)
+{
+    if (!ctx || !ctx->ready)
         return -ENODEV;
-    if (len == 0 || len > UART_MAX_PACKET_SIZE)
+    if (!iov && iovcnt)
         return -EINVAL;
 
-    /* Sıralama: aynı anda tek gönderim */
-    if (k_sem_take(&tx_ctx.lock, K_NO_WAIT) != 0)
+    size_t len = 0;
+    for (size_t i = 0; i < iovcnt; i++)
+        len += iov[i].len;
+    if (len == 0 || len > UART_FRAME_LEN_MAX)
+        return -EINVAL;
+
+    void *mem;
+    if (k_mem_slab_alloc(ctx->cfg->tx_slab, &mem, timeout) != 0)
     {
-        return -EBUSY;
+        uart_stat_inc(&ctx->stats, UART_STAT_TX_NOBUFS);
+        return -ENOBUFS;
     }
 
-    /* Frame’i stack’te kur → TX_DONE’a kadar fonksiyondan çıkmayacağız */
-    uint8_t frame[2 + UART_MAX_PACKET_SIZE + 2];
-    size_t flen = build_frame(frame, payload, len);
+    tx_slot_t *s = mem;
+    s->len = (uint16_t)build_frame_v(s->buf, iov, iovcnt, (uint16_t)len);
+    s->cb = cb;
+    s->user = user;
+    s->t_enq = k_cycle_get_32();
+
+    /* Slab ve kuyruk aynı derinlikte: slot alındıysa kuyrukta yer var */
+    tx_queue_t *txq = &ctx->txq;
+    k_spinlock_key_t key = k_spin_lock(&txq->lock);
+    ctx->cfg->tx_ring[(txq->head + txq->count) % ctx->cfg->tx_depth] = s;
+    txq->count++;
+    uart_stat_max(&ctx->stats, UART_STAT_TXQ_HWM, txq->count);
+    bool start = !txq->busy;
+    txq->busy = true;
+#if IS_ENABLED(CONFIG_CUSTOM_UART_TX_COALESCE)
+    bool hold = false;
+    txq->bytes += s->len;
+    if (start && UART_TX_COALESCE_WINDOW_US > 0 && txq->bytes < UART_TX_COALESCE_BYTES)
+    {
+        /* Hat boş: arkadan gelecek frame'ler için pencereyi aç */
+        txq->holding = hold = true;
+        start = false;
+    }
+    else if (txq->holding && txq->bytes >= UART_TX_COALESCE_BYTES)
+    {
+        /* Bütçe doldu: pencereyi beklemeden gönder */
+        start = true;
+    }
+#endif
+    k_spin_unlock(&txq->lock, key);
+
+#if IS_ENABLED(CONFIG_CUSTOM_UART_TX_COALESCE)
+    if (hold)
+        k_timer_start(&ctx->tx_hold_timer, K_USEC(UART_TX_COALESCE_WINDOW_US), K_NO_WAIT);
+    else if (start)
+        k_timer_stop(&ctx->tx_hold_timer);
+#endif
+    if (start)
+        tx_start_head(ctx);
+    return 0;
+}
+
+static inline int tx_enqueue(struct uart_io_ctx *ctx, const uint8_t *payload, uint16_t len,
+                             uart_io_tx_cb_t cb, void *user, k_timeout_t timeout)
+{
+    const uart_iovec_t v = {.buf = payload, .len = len};
+    return tx_enqueue_v(ctx, &v, 1, cb, user, timeout);
+}
 
-    tx_ctx.armed = true;
+/* user'a ait bekleyen frame'leri kuyruktan çıkar, DMA'daki frame(ler)i callback'ten
+ * ayırıp abort et. Çıkarılan ve ayrılan frame sayısını döner: bunların hiçbiri
+ * callback çağırmaz. Birleştirmede aynı transferde birden çok frame ayrılabilir. */
+static int tx_cancel(struct uart_io_ctx *ctx, void *user)
+{
+    tx_queue_t *txq = &ctx->txq;
+    uint8_t depth = ctx->cfg->tx_depth;
+    tx_slot_t *drop = NULL;
+    int nout = 0;
+    bool abort = false;
+
+    k_spinlock_key_t key = k_spin_lock(&txq->lock);
+    uint8_t n = txq->count, keep = 0;
+    for (uint8_t i = 0; i < n; i++)
+    {
+        tx_slot_t *s = tx_at(ctx, i);
+        if (s->user != user || !s->cb)
+        {
+            ctx->cfg->tx_ring[(txq->head + keep++) % depth] = s;
+        }
+        else if (i < txq->inflight)
+        {
+            /* DMA'da: slot TX_ABORTED ile serbest kalır, callback çağrılmaz */
+            s->cb = NULL;
+            abort = true;
+            keep++;
+            nout++;
+        }
+        else
+        {
+#if IS_ENABLED(CONFIG_CUSTOM_UART_TX_COALESCE)
+            txq->bytes -= s->len;
+#endif
+            s->next = drop;
+            drop = s;
+            nout++;
+        }
+    }
+    txq->count = keep;
+    if (!keep)
+        txq->busy = false;
+    k_spin_unlock(&txq->lock, key);
 
-    /* uart_tx başlat; buffer TX tamamlanana kadar geçerli kalmalı (bu fonksiyonda bekliyoruz) */
-    int rc = uart_tx(uart_dev, frame, flen, SYS_FOREVER_MS);
-    if (rc != 0)
+    while (drop)
     {
-        tx_ctx.armed = false;
-        k_sem_give(&tx_ctx.lock);
-        return rc; /* -EBUSY etc. */
+        tx_slot_t *s = drop;
+        drop = s->next;
+        k_mem_slab_free(ctx->cfg->tx_slab, s);
     }
+    if (abort)
+        (void)uart_tx_abort(ctx->cfg->dev);
 
-    /* TX_DONE / TX_ABORTED  */
-    if (k_sem_take(&tx_ctx.done, timeout) != 0)
+    return nout;
+}
+
+/* Batch'teki tüm frame'ler bitene kadar bekle; bir frame süresince hiç ilerleme
+ * olmazsa kalanları iptal et */
+static int tx_batch_wait(struct uart_io_ctx *ctx, tx_batch_t *b, k_timeout_t per_frame_timeout)
+{
+    uint16_t done = 0;
+
+    while (done < b->queued)
     {
-        /* zaman aşımı: abort etmeyi dene ve kısa bekle */
-        (void)uart_tx_abort(uart_dev);
-        (void)k_sem_take(&tx_ctx.done, K_MSEC(100));
-        tx_ctx.armed = false;
-        k_sem_give(&tx_ctx.lock);
+        if (k_sem_take(&b->done, per_frame_timeout) == 0)
+        {
+            done++;
+            continue;
+        }
+
+        uart_stat_inc(&ctx->stats, UART_STAT_TX_TIMEOUTS);
+        b->queued -= (uint16_t)tx_cancel(ctx, b);
+        /* Kuyruktan çoktan çıkmış olanların callback'leri yolda */
+        while (done < b->queued)
+        {
+            (void)k_sem_take(&b->done, K_FOREVER);
+            done++;
+        }
         return -ETIMEDOUT;
     }
+    return b->result;
+}
 
-    tx_ctx.armed = false;
-    k_sem_give(&tx_ctx.lock);
-    return 0;
+static int uart_sendv(struct uart_io_ctx *ctx, const uart_iovec_t *iov, size_t iovcnt, k_timeout_t timeout)
+{
+    tx_batch_t b;
+    tx_batch_init(&b);
+
+    int rc = tx_enqueue_v(ctx, iov, iovcnt, tx_batch_cb, &b, timeout);
+    if (rc)
+        return rc;
+    b.queued = 1;
+
+    return tx_batch_wait(ctx, &b, timeout);
 }
 
-static int uart_send_buffer(const struct device *uart_dev, const uint8_t *buf, size_t len, k_timeout_t per_frame_timeout)
+static int uart_send_buffer(struct uart_io_ctx *ctx, const uint8_t *buf, size_t len, k_timeout_t per_frame_timeout)
 {
+    tx_batch_t b;
+    tx_batch_init(&b);
+
+    /* Tüm parçaları kuyruğa at; kuyruk doluysa slot boşalana kadar bekle */
+    int rc = 0;
     while (len > 0)
     {
-        uint8_t chunk = (len > UART_MAX_PACKET_SIZE) ? UART_MAX_PACKET_SIZE : (uint8_t)len;
-        int rc = uart_send_frame(uart_dev, buf, chunk, per_frame_timeout);
-        if (rc != 0)
-            return rc;
+        uint16_t chunk = (uint16_t)MIN(len, (size_t)UART_FRAME_LEN_MAX);
+        rc = tx_enqueue(ctx, buf, chunk, tx_batch_cb, &b, per_frame_timeout);
+        if (rc)
+            break;
+        b.queued++;
         buf += chunk;
         len -= chunk;
     }
-    return 0;
+
+    int wrc = tx_batch_wait(ctx, &b, per_frame_timeout);
+    return rc ? rc : wrc;
 }
 
-/* Büyük buffer’ı küçük frame’lere böler (MAX=64). RAM: sadece küçük bir temp (64B) */
-static int uart_send_large(const struct device *uart_dev, const uint8_t *buf, uint32_t len, uint8_t xfer_id)
+/* Büyük buffer’ı küçük frame’lere böler (MAX=64). Header + veri parçası
+ * doğrudan TX slot'una yazılır; RAM: sadece header (7B). Jumbo açıkken tek
+ * klasik parçaya sığmayan transfer jumbo parçalarla (8B header) gider.
+ * CONFIG_CUSTOM_UART_LZ: parça küçülüyorsa sıkışık hali SEG_F_LZ ile gider,
+ * offset yine ham parça hizasındadır; küçülmeyen parça ham gider.
+ * Header'daki toplam boy 16 bit: len 1..UINT16_MAX olmalı. */
+static int uart_send_large(struct uart_io_ctx *ctx, const uint8_t *buf, uint32_t len, uint8_t xfer_id)
 {
-    uint16_t off = 0;
-    uint8_t frame_payload[UART_MAX_PACKET_SIZE]; /* stack: 64 B */
+    if (len == 0 || len > UINT16_MAX)
+        return -EINVAL;
+
+    uint32_t off = 0;
+    uint8_t hdr[SEG_HDR_JUMBO_SIZE];
+    uint8_t typ = SEG_TYP_DATA;
+    tx_batch_t b;
+    tx_batch_init(&b);
+    int rc = 0;
+
+    if (IS_ENABLED(CONFIG_CUSTOM_UART_JUMBO) && len > PAYLOAD_MAX)
+        typ |= SEG_F_JUMBO;
+    uint16_t seg = seg_payload_max(typ);
+
+#if IS_ENABLED(CONFIG_CUSTOM_UART_LZ)
+    k_mutex_lock(&ctx->lz_lock, K_FOREVER);
+    lz_enc_begin(&ctx->lz_enc, buf);
+#endif
 
     while (off < len)
     {
-        uint8_t chunk = (uint8_t)MIN((uint16_t)PAYLOAD_MAX, (uint16_t)(len - off));
+        uint16_t chunk = (uint16_t)MIN((uint32_t)seg, len - off);
+        uint8_t t = typ;
+        const uint8_t *p = &buf[off];
+        uint16_t plen = chunk;
+
+#if IS_ENABLED(CONFIG_CUSTOM_UART_LZ)
+        /* Kodlayıcı her parçayı görmeli (hash geçmişi); ham gidecekse de çağrılır */
+        size_t c = lz_enc_block(&ctx->lz_enc, off, chunk, ctx->lz_buf, chunk - 1u);
+        if (c)
+        {
+            t |= SEG_F_LZ;
+            p = ctx->lz_buf;
+            plen = (uint16_t)c;
+        }
+#endif
 
         /* header'ı yaz */
-        seg_hdr_write(frame_payload, SEG_TYP_DATA, xfer_id, len, off, chunk);
-
-        /* veriyi header arkasına koy */
-        memcpy(&frame_payload[SEG_HDR_SIZE], &buf[off], chunk);
-
-        /* LEN = header + chunk */
-        int rc = uart_send_frame(uart_dev, frame_payload, SEG_HDR_SIZE + chunk, K_SECONDS(1));
+        size_t hl = seg_hdr_write(hdr, t, xfer_id, (uint16_t)len, (uint16_t)off, plen);
+
+        /* LEN = header + parça; parçalar slot'a kopyalanır, hdr/lz_buf tekrar kullanılabilir */
+        const uart_iovec_t v[] = {
+            {.buf = hdr, .len = hl},
+            {.buf = p, .len = plen},
+        };
+        rc = tx_enqueue_v(ctx, v, ARRAY_SIZE(v), tx_batch_cb, &b, K_SECONDS(1));
         if (rc)
-            return rc;
+            break;
+        b.queued++;
 
         off += chunk;
     }
-    return 0;
+
+#if IS_ENABLED(CONFIG_CUSTOM_UART_LZ)
+    k_mutex_unlock(&ctx->lz_lock);
+#endif
+
+    int wrc = tx_batch_wait(ctx, &b, K_SECONDS(1));
+    return rc ? rc : wrc;
 }
 
+#if IS_ENABLED(CONFIG_CUSTOM_UART_FLOW_CTRL)
+static int flow_set_rts(struct uart_io_ctx *ctx, bool ready)
+{
+#if defined(CONFIG_UART_LINE_CTRL)
+    return uart_line_ctrl_set(ctx->cfg->dev, UART_LINE_CTRL_RTS, ready ? 1 : 0);
+#else
+    ARG_UNUSED(ctx);
+    ARG_UNUSED(ready);
+    return -ENOTSUP;
+#endif
+}
 
-static void uart_rx_handler(struct k_work *work)
+static void flow_init(struct uart_io_ctx *ctx)
 {
-    uart_frame_t f;
+    flow_t *fl = &ctx->flow;
+    uint32_t depth = ctx->cfg->rx_depth;
+
+    fl->paused = fl->pending = fl->sending = false;
+    fl->sent_ms = 0;
+    fl->rb_hi = MAX(1u, ctx->cfg->rb_size * UART_FLOW_RB_HIGH_PCT / 100u);
+    fl->rb_lo = ctx->cfg->rb_size * UART_FLOW_RB_LOW_PCT / 100u;
+    fl->q_hi = MAX(1u, depth * UART_FLOW_Q_HIGH_PCT / 100u);
+    fl->q_lo = MIN(fl->q_hi - 1u, depth * UART_FLOW_Q_LOW_PCT / 100u);
+
+    /* hw-flow-control'lü düğümde RTS'i sürücü üzerinden dene; desteklenmiyorsa in-band */
+    fl->rts = ctx->cfg->rts && flow_set_rts(ctx, true) == 0;
+}
 
-    while (k_msgq_get(&uart_rx_msg_q, &f, K_NO_WAIT) == 0)
+/* Durumu RTS'e veya in-band frame olarak TX kuyruğuna ver */
+static int flow_send(struct uart_io_ctx *ctx, bool paused)
+{
+    if (ctx->flow.rts)
+        return flow_set_rts(ctx, !paused);
+
+    uint8_t msg[SEG_HDR_SIZE + 1];
+    seg_hdr_write(msg, SEG_TYP_FLOW, 0, 0, 0, 1);
+    msg[SEG_HDR_SIZE] = paused ? SEG_FLOW_PAUSE : SEG_FLOW_RESUME;
+    return tx_enqueue(ctx, msg, sizeof(msg), NULL, NULL, K_NO_WAIT);
+}
+
+/* ISR, drain ve dispatch bağlamlarından çağrılır. Karar kilit altında verilir,
+ * gönderim (RTS veya tx_enqueue) kilit dışında: tek bağlam gönderir ve her
+ * turda son durumu yollar, araya giren karar onun bir sonraki turunda gider.
+ * Böylece PAUSE/RESUME kuyruğa karar sırasıyla girer, son giden son durumdur. */
+static void flow_update(struct uart_io_ctx *ctx)
+{
+    flow_t *fl = &ctx->flow;
+    uint32_t rb_used = ring_buf_size_get(&ctx->rb);
+    uint32_t q_used = k_msgq_num_used_get(ctx->cfg->rx_msgq);
+    uint32_t now = k_uptime_get_32();
+
+    k_spinlock_key_t key = k_spin_lock(&fl->lock);
+    if (!fl->paused && (rb_used >= fl->rb_hi || q_used >= fl->q_hi))
     {
+        fl->paused = fl->pending = true;
+        uart_stat_inc(&ctx->stats, UART_STAT_FLOW_PAUSE);
+    }
+    else if (fl->paused && rb_used <= fl->rb_lo && q_used <= fl->q_lo)
+    {
+        fl->paused = false;
+        fl->pending = true;
+    }
+    else if (fl->paused && !fl->rts && now - fl->sent_ms >= UART_FLOW_REFRESH_MS)
+    {
+        /* Karşı taraf PAUSE'u zaman aşımıyla bırakır; hâlâ doluysak tazele */
+        fl->pending = true;
+    }
 
+    if (fl->sending)
+    {
+        /* Gönderen bağlam (ör. kestiğimiz thread) bir sonraki turunda yollar */
+        k_spin_unlock(&fl->lock, key);
+        return;
+    }
+    fl->sending = true;
+    while (fl->pending)
+    {
+        bool paused = fl->paused;
+        fl->pending = false;
+        fl->sent_ms = now;
+        k_spin_unlock(&fl->lock, key);
+
+        int rc = flow_send(ctx, paused);
 
-        if (rx_cb && rx_cb != NULL)
+        key = k_spin_lock(&fl->lock);
+        if (rc)
         {
-            rx_cb(&f);
+            /* Sonraki güncellemede yeniden */
+            fl->pending = true;
+            uart_stat_inc(&ctx->stats, UART_STAT_FLOW_TX_ERR);
+            break;
         }
     }
+    fl->sending = false;
+    k_spin_unlock(&fl->lock, key);
+}
+#endif
 
-    k_work_poll_submit(&uart_rx_wp, &uart_rx_pe, 1, K_FOREVER);
+/* Sayaç kelimeleri: cyc_per_sec, sayaçlar (UART_STATS_LIST sırası), varsa RX ve TX histogramları */
+#define STATS_HIST_WORDS (IS_ENABLED(CONFIG_CUSTOM_UART_STATS_HIST) ? UART_STATS_HIST_COUNT * UART_STATS_HIST_BUCKETS : 0)
+#define STATS_WORDS      (1 + UART_STAT_COUNT + STATS_HIST_WORDS)
+
+static uint32_t stats_word(struct uart_io_ctx *ctx, uint16_t i)
+{
+    if (i == 0)
+        return sys_clock_hw_cycles_per_sec();
+    i--;
+    if (i < UART_STAT_COUNT)
+        return (uint32_t)atomic_get(&ctx->stats.cnt[i]);
+#if IS_ENABLED(CONFIG_CUSTOM_UART_STATS_HIST)
+    i -= UART_STAT_COUNT;
+    return (uint32_t)atomic_get(&ctx->stats.hist[i / UART_STATS_HIST_BUCKETS][i % UART_STATS_HIST_BUCKETS]);
+#else
+    return 0;
+#endif
 }
 
-static void uart_kernel_object_init(void)
+#if IS_ENABLED(CONFIG_CUSTOM_UART_STATS_TLV)
+/* Sayfa: [sayfa, sayfa_sayısı, toplam_kelime BE16] + en fazla STATS_TLV_WORDS x BE32 */
+#define STATS_TLV_VALUE_MAX (UART_MAX_PACKET_SIZE - 2) /* id + len */
+#define STATS_TLV_HDR       4
+#define STATS_TLV_WORDS     ((STATS_TLV_VALUE_MAX - STATS_TLV_HDR) / 4)
+#define STATS_TLV_PAGES     DIV_ROUND_UP(STATS_WORDS, STATS_TLV_WORDS)
+
+/* In-band sorgu: [id, 0] → sayfa 0, [id, 1, n] → sayfa n. Yanıt aynı id ile tek
+ * frame; kuyruk doluysa düşer, host tekrar sorar. Sayfalar ayrı anlarda okunur. */
+static bool stats_tlv_query(struct uart_io_ctx *ctx, const uart_frame_t *f)
 {
+    uint8_t page;
+
+    if (f->data[0] != UART_STATS_TLV_ID)
+        return false;
+    if (f->len == 2 && f->data[1] == 0)
+        page = 0;
+    else if (f->len == 3 && f->data[1] == 1)
+        page = f->data[2];
+    else
+        return false;
+
+    /* Aralık dışı sayfa boş döner; host sayfa sayısını oradan da öğrenir */
+    uint16_t first = (uint16_t)page * STATS_TLV_WORDS;
+    uint8_t n = first < STATS_WORDS ? (uint8_t)MIN(STATS_TLV_WORDS, STATS_WORDS - first) : 0;
+    uint8_t msg[2 + STATS_TLV_HDR + STATS_TLV_WORDS * 4];
+
+    msg[0] = UART_STATS_TLV_ID;
+    msg[1] = (uint8_t)(STATS_TLV_HDR + n * 4);
+    msg[2] = page;
+    msg[3] = (uint8_t)STATS_TLV_PAGES;
+    sys_put_be16(STATS_WORDS, &msg[4]);
+    for (uint8_t i = 0; i < n; i++)
+        sys_put_be32(stats_word(ctx, first + i), &msg[2 + STATS_TLV_HDR + 4 * i]);
+
+    (void)tx_enqueue(ctx, msg, (uint8_t)(2 + msg[1]), NULL, NULL, K_NO_WAIT);
+    return true;
+}
+#else
+static inline bool stats_tlv_query(struct uart_io_ctx *ctx, const uart_frame_t *f)
+{
+    ARG_UNUSED(ctx);
+    ARG_UNUSED(f);
+    return false;
+}
+#endif
 
-    k_work_init(&rx_drain_work, rx_drain_worker);
+/* Birleştiricinin ürettiği ACK; kuyruk doluysa düşer, gönderici RTO ile telafi eder */
+static void rel_ack_send(void *user, const uint8_t *ack, size_t len)
+{
+    (void)tx_enqueue(user, ack, (uint8_t)len, NULL, NULL, K_NO_WAIT);
+}
 
-    k_work_poll_init(&uart_rx_wp, uart_rx_handler);
-    k_poll_event_init(&uart_rx_pe, K_POLL_TYPE_MSGQ_DATA_AVAILABLE, K_POLL_MODE_NOTIFY_ONLY, &uart_rx_msg_q);
-    k_work_poll_submit(&uart_rx_wp, &uart_rx_pe, 1, K_FOREVER);
+static void uart_rx_handler(struct k_work *work)
+{
+    struct k_work_poll *wp = CONTAINER_OF(work, struct k_work_poll, work);
+    struct uart_io_ctx *ctx = CONTAINER_OF(wp, struct uart_io_ctx, rx_wp);
+    uart_frame_t *f;
+
+    while (k_msgq_get(ctx->cfg->rx_msgq, &f, K_NO_WAIT) == 0)
+    {
+        /* Sayaç sorgusu sürücüde yanıtlanır; ACK'ler güvenilir göndericiye,
+         * segment frame'leri birleştiriciye */
+        bool consumed = stats_tlv_query(ctx, f) || uart_rel_on_ack(&ctx->rel, f->data, f->len) == 0 ||
+                        (seg_reasm_active(&ctx->reasm) && seg_reasm_push(&ctx->reasm, f->data, f->len) == 0);
+        if (!consumed && ctx->rx_cb)
+        {
+            uint32_t t_rx = CONTAINER_OF(f, frame_blk_t, frame)->t_rx;
+            uart_stat_hist(&ctx->stats, UART_STATS_HIST_RX, k_cycle_get_32() - t_rx);
+            ctx->rx_cb(f);
+        }
+
+        /* Dispatch referansı; callback tuttuysa uart_io_frame_ref() ile artırmıştır */
+        framer_frame_release(f);
+    }
 
-    k_sem_init(&tx_ctx.lock, 1, 1);
-    k_sem_init(&tx_ctx.done, 0, 1);
-    tx_ctx.armed = false;
+    /* Kuyruk boşaldı: alt eşiğin altındaysa RESUME */
+    flow_update(ctx);
+
+    k_work_poll_submit_to_queue(&uart_io_cb_wq, &ctx->rx_wp, &ctx->rx_pe, 1, K_FOREVER);
 }
 
-/* ============================================ * GLOBALS * ============================================*/
+static void uart_kernel_object_init(struct uart_io_ctx *ctx)
+{
+    k_work_init(&ctx->rx_drain_work, rx_drain_worker);
+
+    k_work_poll_init(&ctx->rx_wp, uart_rx_handler);
+    k_poll_event_init(&ctx->rx_pe, K_POLL_TYPE_MSGQ_DATA_AVAILABLE, K_POLL_MODE_NOTIFY_ONLY, ctx->cfg->rx_msgq);
+    k_work_poll_submit_to_queue(&uart_io_cb_wq, &ctx->rx_wp, &ctx->rx_pe, 1, K_FOREVER);
+
+    ctx->txq.head = ctx->txq.count = ctx->txq.inflight = 0;
+    ctx->txq.busy = false;
+#if IS_ENABLED(CONFIG_CUSTOM_UART_TX_COALESCE)
+    ctx->txq.holding = false;
+    ctx->txq.bytes = 0;
+    k_timer_init(&ctx->tx_hold_timer, tx_hold_expired, NULL);
+#endif
+#if IS_ENABLED(CONFIG_CUSTOM_UART_LZ)
+    k_mutex_init(&ctx->lz_lock);
+#endif
+}
 
-int uart_io_init(void)
+static int uart_io_ctx_init(struct uart_io_ctx *ctx)
 {
+    const uart_io_cfg_t *cfg = ctx->cfg;
 
-    uart_dev = DEVICE_DT_GET(UART_DEVICE_NODE);
-    if (!device_is_ready(uart_dev))
+    if (!device_is_ready(cfg->dev))
     {
         return -ENODEV;
     }
 
-    uart_kernel_object_init();
+    uart_kernel_object_init(ctx);
 
-    ring_buf_init(&uart_rb, UART_RB_SZ, uart_rb_mem);
+    ring_buf_init(&ctx->rb, cfg->rb_size, cfg->rb_mem);
 
-    framer_init();
+    framer_init(&ctx->framer, cfg->rx_slab, cfg->rx_msgq, &ctx->stats);
+    seg_reasm_init(&ctx->reasm, cfg->reasm_slots, cfg->reasm_nslots, &ctx->stats);
+    seg_reasm_set_ack_fn(&ctx->reasm, rel_ack_send, ctx);
+    uart_rel_init(&ctx->rel, ctx, &ctx->stats);
+#if IS_ENABLED(CONFIG_CUSTOM_UART_FLOW_CTRL)
+    flow_init(ctx);
+#endif
 
-    uart_callback_set(uart_dev, uart_handler_cb, (void *)uart_dev);
-    async_idx = 1;
-    int ret = uart_rx_enable(uart_dev, async_rx_buffer[0], UART_RX_CHUNK_LEN, 20 /* ms */);
+    uart_callback_set(cfg->dev, uart_handler_cb, ctx);
+    rx_tune_init(ctx);
+    int ret = rx_start(ctx);
     if (ret)
     {
         return ret;
     }
+    LOG_DEBUG("%s: rx idle timeout %d us", cfg->dev->name, ctx->rx_tmo_us);
+
+    ctx->ready = true;
+    return 0;
+}
+
+/* ============================================ * GLOBALS * ============================================*/
+
+static void uart_io_wq_start(void)
+{
+    static bool started;
+    if (started)
+        return;
+
+    const struct k_work_queue_config rx_cfg = {.name = "uart_io_rx"};
+    const struct k_work_queue_config cb_cfg = {.name = "uart_io_cb"};
+
+    k_work_queue_init(&uart_io_rx_wq);
+    k_work_queue_start(&uart_io_rx_wq, uart_io_rx_wq_stack, K_THREAD_STACK_SIZEOF(uart_io_rx_wq_stack),
+                       UART_RX_WQ_PRIORITY, &rx_cfg);
+    k_work_queue_init(&uart_io_cb_wq);
+    k_work_queue_start(&uart_io_cb_wq, uart_io_cb_wq_stack, K_THREAD_STACK_SIZEOF(uart_io_cb_wq_stack),
+                       UART_CB_WQ_PRIORITY, &cb_cfg);
+    started = true;
+}
+
+int uart_io_init(void)
+{
+    int ret = 0;
+
+    uart_io_wq_start();
+
+    for (size_t i = 0; i < ARRAY_SIZE(uart_io_ctxs); i++)
+    {
+        struct uart_io_ctx *ctx = uart_io_ctxs[i];
+        int rc = uart_io_ctx_init(ctx);
+        if (rc)
+        {
+            LOG_INFO("UART %s init failed err=%d", ctx->cfg->dev->name, rc);
+            if (!ret)
+                ret = rc;
+            continue;
+        }
+        LOG_INFO("UART %s STARTED", ctx->cfg->dev->name);
+    }
+
+    return ret;
+}
+
+size_t uart_io_ctx_count(void)
+{
+    return ARRAY_SIZE(uart_io_ctxs);
+}
+
+uart_io_ctx_t *uart_io_ctx_get(size_t idx)
+{
+    return idx < ARRAY_SIZE(uart_io_ctxs) ? uart_io_ctxs[idx] : NULL;
+}
+
+uart_io_ctx_t *uart_io_ctx_from_dev(const struct device *uart)
+{
+    for (size_t i = 0; i < ARRAY_SIZE(uart_io_ctxs); i++)
+    {
+        if (uart_io_ctxs[i]->cfg->dev == uart)
+            return uart_io_ctxs[i];
+    }
+    return NULL;
+}
+
+int uart_io_ctx_send_large(uart_io_ctx_t *ctx, const uint8_t *buf, uint32_t len, uint8_t xfer_id)
+{
+    return uart_send_large(ctx, buf, len, xfer_id);
+}
+
+int uart_io_ctx_send_reliable(uart_io_ctx_t *ctx, const uint8_t *buf, uint16_t len, uint8_t xfer_id)
+{
+    return uart_rel_send(&ctx->rel, buf, len, xfer_id);
+}
+
+int uart_io_ctx_send_buffer(uart_io_ctx_t *ctx, const uint8_t *buf, size_t len, k_timeout_t per_frame_timeout)
+{
+    return uart_send_buffer(ctx, buf, len, per_frame_timeout);
+}
+
+int uart_io_ctx_send_frame(uart_io_ctx_t *ctx, const uint8_t *payload, uint16_t len, k_timeout_t timeout)
+{
+    const uart_iovec_t v = {.buf = payload, .len = len};
+    return uart_sendv(ctx, &v, 1, timeout);
+}
+
+int uart_io_ctx_sendv(uart_io_ctx_t *ctx, const uart_iovec_t *iov, size_t iovcnt, k_timeout_t timeout)
+{
+    return uart_sendv(ctx, iov, iovcnt, timeout);
+}
 
+int uart_io_ctx_sendv_async(uart_io_ctx_t *ctx, const uart_iovec_t *iov, size_t iovcnt,
+                            uart_io_tx_cb_t cb, void *user_data, k_timeout_t timeout)
+{
+    return tx_enqueue_v(ctx, iov, iovcnt, cb, user_data, timeout);
+}
 
+int uart_io_ctx_send_frame_async(uart_io_ctx_t *ctx, const uint8_t *payload, uint16_t len,
+                                 uart_io_tx_cb_t cb, void *user_data, k_timeout_t timeout)
+{
+    return tx_enqueue(ctx, payload, len, cb, user_data, timeout);
+}
 
-    LOG_INFO("UART STARTED");
+void uart_io_ctx_register_rx_cb(uart_io_ctx_t *ctx, uart_io_rx_cb_t cb)
+{
+    ctx->rx_cb = cb;
+}
 
+void uart_io_ctx_register_rx_large_cb(uart_io_ctx_t *ctx, uart_io_rx_large_cb_t cb)
+{
+    seg_reasm_set_cb(&ctx->reasm, cb);
+}
+
+const char *uart_io_ctx_name(uart_io_ctx_t *ctx)
+{
+    return ctx->cfg->dev->name;
+}
+
+static const char *const uart_stat_names[UART_STAT_COUNT] = {
+#define UART_STATS_NAME(id, name) [UART_STAT_##id] = #name,
+    UART_STATS_LIST(UART_STATS_NAME)
+#undef UART_STATS_NAME
+};
+
+const char *uart_io_stat_name(uart_stat_id_t id)
+{
+    return (unsigned int)id < UART_STAT_COUNT ? uart_stat_names[id] : "?";
+}
+
+int uart_io_ctx_get_stats(uart_io_ctx_t *ctx, uart_io_stats_t *out)
+{
+    if (!ctx || !out)
+        return -EINVAL;
+
+    memset(out, 0, sizeof(*out));
+    for (size_t i = 0; i < UART_STAT_COUNT; i++)
+        out->cnt[i] = (uint32_t)atomic_get(&ctx->stats.cnt[i]);
+#if IS_ENABLED(CONFIG_CUSTOM_UART_STATS_HIST)
+    for (size_t h = 0; h < UART_STATS_HIST_COUNT; h++)
+        for (size_t i = 0; i < UART_STATS_HIST_BUCKETS; i++)
+            out->hist[h][i] = (uint32_t)atomic_get(&ctx->stats.hist[h][i]);
+#endif
+    out->cyc_per_sec = sys_clock_hw_cycles_per_sec();
     return 0;
 }
 
+void uart_io_ctx_reset_stats(uart_io_ctx_t *ctx)
+{
+    for (size_t i = 0; i < UART_STAT_COUNT; i++)
+        atomic_clear(&ctx->stats.cnt[i]);
+#if IS_ENABLED(CONFIG_CUSTOM_UART_STATS_HIST)
+    for (size_t h = 0; h < UART_STATS_HIST_COUNT; h++)
+        for (size_t i = 0; i < UART_STATS_HIST_BUCKETS; i++)
+            atomic_clear(&ctx->stats.hist[h][i]);
+#endif
+}
+
+void uart_io_ctx_dump_stats(uart_io_ctx_t *ctx)
+{
+    const char *name = ctx->cfg->dev->name;
+
+    /* Yalnızca sıfır olmayanlar; tam liste için uart_io_ctx_get_stats() / shell */
+    for (size_t i = 0; i < UART_STAT_COUNT; i++)
+    {
+        uint32_t v = (uint32_t)atomic_get(&ctx->stats.cnt[i]);
+        if (v)
+            LOG_INFO("[UART_IO %s] %s=%u", name, uart_stat_names[i], v);
+    }
+#if IS_ENABLED(CONFIG_CUSTOM_UART_FLOW_CTRL)
+    LOG_INFO("[UART_IO %s] flow: %s", name, ctx->flow.rts ? "rts" : "in-band");
+#endif
+#if IS_ENABLED(CONFIG_CUSTOM_UART_STATS_HIST)
+    static const char *const hist_names[] = {"rx_lat", "tx_lat"};
+    for (size_t h = 0; h < UART_STATS_HIST_COUNT; h++)
+        for (size_t i = 0; i < UART_STATS_HIST_BUCKETS; i++)
+        {
+            uint32_t v = (uint32_t)atomic_get(&ctx->stats.hist[h][i]);
+            if (v)
+                LOG_INFO("[UART_IO %s] %s cyc<2^%u: %u", name, hist_names[h], (unsigned int)i + 1, v);
+        }
+#endif
+}
+
+/* ---- Tek port API'si (ilk instance) ---- */
+
 int uart_io_send_larg(const uint8_t *buf, uint32_t len, uint8_t xfer_id)
 {
-    return uart_send_large(uart_dev, buf, len, xfer_id);
+    return uart_io_ctx_send_large(UART_IO_DEFAULT, buf, len, xfer_id);
+}
+
+int uart_io_send_reliable(const uint8_t *buf, uint16_t len, uint8_t xfer_id)
+{
+    return uart_io_ctx_send_reliable(UART_IO_DEFAULT, buf, len, xfer_id);
 }
 
 int uart_io_send_buffer(const uint8_t *buf, size_t len, k_timeout_t per_frame_timeout)
 {
-    return uart_send_buffer(uart_dev, buf, len, per_frame_timeout);
+    return uart_io_ctx_send_buffer(UART_IO_DEFAULT, buf, len, per_frame_timeout);
 }
 
-int uart_io_send_frame(const uint8_t *payload, uint8_t len, k_timeout_t timeout)
+int uart_io_send_frame(const uint8_t *payload, uint16_t len, k_timeout_t timeout)
 {
-    return uart_send_frame(uart_dev, payload, len, timeout);
+    return uart_io_ctx_send_frame(UART_IO_DEFAULT, payload, len, timeout);
+}
+
+int uart_io_sendv(const uart_iovec_t *iov, size_t iovcnt, k_timeout_t timeout)
+{
+    return uart_io_ctx_sendv(UART_IO_DEFAULT, iov, iovcnt, timeout);
+}
+
+int uart_io_sendv_async(const uart_iovec_t *iov, size_t iovcnt,
+                        uart_io_tx_cb_t cb, void *user_data, k_timeout_t timeout)
+{
+    return uart_io_ctx_sendv_async(UART_IO_DEFAULT, iov, iovcnt, cb, user_data, timeout);
+}
+
+int uart_io_send_frame_async(const uint8_t *payload, uint16_t len,
+                             uart_io_tx_cb_t cb, void *user_data, k_timeout_t timeout)
+{
+    return uart_io_ctx_send_frame_async(UART_IO_DEFAULT, payload, len, cb, user_data, timeout);
+}
+
+uart_frame_t *uart_io_frame_ref(uart_frame_t *frame)
+{
+    return framer_frame_ref(frame);
+}
+
+void uart_io_frame_release(uart_frame_t *frame)
+{
+    framer_frame_release(frame);
+}
+
+int uart_io_get_stats(uart_io_stats_t *out)
+{
+    return uart_io_ctx_get_stats(UART_IO_DEFAULT, out);
+}
+
+void uart_io_dump_stats(void)
+{
+    for (size_t i = 0; i < ARRAY_SIZE(uart_io_ctxs); i++)
+        uart_io_ctx_dump_stats(uart_io_ctxs[i]);
 }
 
 void uart_io_register_rx_cb(uart_io_rx_cb_t uart_io_rx_cb)
 {
-    rx_cb = uart_io_rx_cb;
-}
\ No newline at end of file
+    uart_io_ctx_register_rx_cb(UART_IO_DEFAULT, uart_io_rx_cb);
+}
+
+void uart_io_register_rx_large_cb(uart_io_rx_large_cb_t cb)
+{
+    uart_io_ctx_register_rx_large_cb(UART_IO_DEFAULT, cb);
+}
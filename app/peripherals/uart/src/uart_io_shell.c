@@ -0,0 +1,66 @@
+#include <zephyr/kernel.h>
+
+#if IS_ENABLED(CONFIG_CUSTOM_UART_SHELL)
+#include <zephyr/shell/shell.h>
+#include <errno.h>
+#include <stdlib.h>
+
+#include "uart_io.h"
+
+/* uart_io stats [port] / uart_io reset [port]; port verilmezse 0 */
+static uart_io_ctx_t *shell_ctx(const struct shell *sh, size_t argc, char **argv)
+{
+    unsigned long idx = argc > 1 ? strtoul(argv[1], NULL, 0) : 0;
+    uart_io_ctx_t *ctx = uart_io_ctx_get(idx);
+
+    if (!ctx)
+        shell_error(sh, "no port %lu (%u configured)", idx, (unsigned int)uart_io_ctx_count());
+    return ctx;
+}
+
+static void shell_hist(const struct shell *sh, const char *name, const uint32_t *hist, uint32_t cyc_per_sec)
+{
+    for (unsigned int i = 0; i < UART_STATS_HIST_BUCKETS; i++)
+    {
+        if (!hist[i])
+            continue;
+        /* Kova üst sınırı: 2^(i+1) cycle */
+        uint64_t us = ((uint64_t)2u << i) * 1000000u / MAX(cyc_per_sec, 1u);
+        shell_print(sh, "  %s < %llu us: %u", name, (unsigned long long)us, hist[i]);
+    }
+}
+
+static int cmd_stats(const struct shell *sh, size_t argc, char **argv)
+{
+    static uart_io_stats_t st; /* shell thread'i tek; yığında yer açmaz */
+    uart_io_ctx_t *ctx = shell_ctx(sh, argc, argv);
+
+    if (!ctx)
+        return -EINVAL;
+    (void)uart_io_ctx_get_stats(ctx, &st);
+
+    shell_print(sh, "%s:", uart_io_ctx_name(ctx));
+    for (unsigned int i = 0; i < UART_STAT_COUNT; i++)
+        shell_print(sh, "  %-14s %u", uart_io_stat_name(i), st.cnt[i]);
+    shell_hist(sh, "rx_lat", st.hist[UART_STATS_HIST_RX], st.cyc_per_sec);
+    shell_hist(sh, "tx_lat", st.hist[UART_STATS_HIST_TX], st.cyc_per_sec);
+    return 0;
+}
+
+static int cmd_reset(const struct shell *sh, size_t argc, char **argv)
+{
+    uart_io_ctx_t *ctx = shell_ctx(sh, argc, argv);
+
+    if (!ctx)
+        return -EINVAL;
+    uart_io_ctx_reset_stats(ctx);
+    return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(uart_io_cmds,
+    SHELL_CMD_ARG(stats, NULL, "Print counters and latency histograms: stats [port]", cmd_stats, 1, 1),
+    SHELL_CMD_ARG(reset, NULL, "Zero counters and histograms: reset [port]", cmd_reset, 1, 1),
+    SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(uart_io, &uart_io_cmds, "uart_io port statistics", NULL);
+#endif
@@ -0,0 +1,201 @@
+#include <zephyr/kernel.h>
+#include <errno.h>
+#include <string.h>
+
+#include "uart_io.h"
+#include "uart_rel.h"
+
+#if IS_ENABLED(CONFIG_CUSTOM_UART_RELIABLE)
+
+BUILD_ASSERT(UART_REL_WINDOW <= 32, "selective ACK bitmap covers 32 segments");
+
+static inline bool is_acked(const uart_rel_t *rel, uint16_t idx)
+{
+    return rel->tx.acked[idx / 32] & BIT(idx % 32);
+}
+
+static inline void set_acked(uart_rel_t *rel, uint16_t idx)
+{
+    if (idx < rel->tx.nsegs)
+        rel->tx.acked[idx / 32] |= BIT(idx % 32);
+}
+
+static int rel_send_seg(uart_rel_t *rel, const uint8_t *buf, uint16_t idx)
+{
+    uint16_t off = (uint16_t)(idx * PAYLOAD_MAX);
+    uint8_t clen = (uint8_t)MIN((uint16_t)PAYLOAD_MAX, (uint16_t)(rel->tx.total - off));
+    uint8_t hdr[SEG_HDR_SIZE];
+
+    seg_hdr_write(hdr, SEG_TYP_DATA | SEG_F_ACKREQ, rel->tx.xid, rel->tx.total, off, clen);
+    const uart_iovec_t v[] = {
+        {.buf = hdr, .len = SEG_HDR_SIZE},
+        {.buf = &buf[off], .len = clen},
+    };
+
+    rel->tx.sent_ms[idx % UART_REL_WINDOW] = k_uptime_get_32();
+    uart_stat_inc(rel->stats, UART_STAT_REL_SEGS);
+    return uart_io_ctx_sendv_async(rel->io, v, ARRAY_SIZE(v), NULL, NULL, K_MSEC(UART_REL_RTO_MS));
+}
+
+/* ACK'i uygula; en yüksek seçici onaylı parça indeksini döner (yoksa cum) */
+static uint16_t rel_apply_ack(uart_rel_t *rel, const rel_ack_t *a)
+{
+    uint16_t cum = (a->cum >= rel->tx.total) ? rel->tx.nsegs : (uint16_t)(a->cum / PAYLOAD_MAX);
+    uint16_t high = cum;
+
+    for (uint16_t i = 0; i < cum; i++)
+        set_acked(rel, i);
+    for (uint16_t i = 0; i < 32; i++)
+    {
+        if (a->sack & BIT(i))
+        {
+            set_acked(rel, cum + 1 + i);
+            high = cum + 1 + i;
+        }
+    }
+    return high;
+}
+
+void uart_rel_init(uart_rel_t *rel, struct uart_io_ctx *io, uart_stats_t *stats)
+{
+    memset(rel, 0, sizeof(*rel));
+    rel->io = io;
+    rel->stats = stats;
+    k_mutex_init(&rel->lock);
+    k_sem_init(&rel->ack_sem, 0, 1);
+}
+
+int uart_rel_send(uart_rel_t *rel, const uint8_t *buf, uint16_t len, uint8_t xid)
+{
+    if (!buf || !len)
+        return -EINVAL;
+
+    k_mutex_lock(&rel->lock, K_FOREVER);
+
+    memset(&rel->tx, 0, sizeof(rel->tx));
+    rel->tx.xid = xid;
+    rel->tx.total = len;
+    rel->tx.nsegs = DIV_ROUND_UP(len, PAYLOAD_MAX);
+
+    k_spinlock_key_t key = k_spin_lock(&rel->ack_lock);
+    rel->last_ack.valid = false;
+    k_spin_unlock(&rel->ack_lock, key);
+    k_sem_reset(&rel->ack_sem);
+
+    uint16_t base = 0, next = 0;
+    int retries = 0, rc = 0;
+
+    while (base < rel->tx.nsegs)
+    {
+        /* Pencereyi doldur */
+        while (!rc && next < rel->tx.nsegs && next < base + UART_REL_WINDOW)
+        {
+            rc = rel_send_seg(rel, buf, next);
+            if (!rc)
+                next++;
+        }
+        if (rc)
+            break;
+
+        if (k_sem_take(&rel->ack_sem, K_MSEC(UART_REL_RTO_MS)) != 0)
+        {
+            /* RTO: penceredeki onaysız parçaları yeniden gönder */
+            if (++retries > UART_REL_MAX_RETRIES)
+            {
+                rc = -ETIMEDOUT;
+                break;
+            }
+            for (uint16_t i = base; i < next && !rc; i++)
+            {
+                if (!is_acked(rel, i))
+                {
+                    uart_stat_inc(rel->stats, UART_STAT_REL_RETX);
+                    rc = rel_send_seg(rel, buf, i);
+                }
+            }
+            continue;
+        }
+
+        rel_ack_t a;
+        key = k_spin_lock(&rel->ack_lock);
+        a = rel->last_ack;
+        rel->last_ack.valid = false;
+        k_spin_unlock(&rel->ack_lock, key);
+        if (!a.valid || a.xid != rel->tx.xid || a.total != rel->tx.total)
+            continue;
+
+        uart_stat_inc(rel->stats, UART_STAT_REL_ACKS);
+        uint16_t high = rel_apply_ack(rel, &a);
+        uint16_t old_base = base;
+        while (base < rel->tx.nsegs && is_acked(rel, base))
+            base++;
+        if (base != old_base)
+            retries = 0;
+
+        /* Seçici tekrar: ACK'te görünen delikleri, yakın zamanda gönderilmediyse yolla */
+        uint32_t now = k_uptime_get_32();
+        for (uint16_t i = base; i < MIN(high, next) && !rc; i++)
+        {
+            if (!is_acked(rel, i) && (now - rel->tx.sent_ms[i % UART_REL_WINDOW]) >= UART_REL_RTO_MS / 2)
+            {
+                uart_stat_inc(rel->stats, UART_STAT_REL_RETX);
+                rc = rel_send_seg(rel, buf, i);
+            }
+        }
+    }
+
+    if (rc)
+        uart_stat_inc(rel->stats, UART_STAT_REL_FAIL);
+    k_mutex_unlock(&rel->lock);
+    return rc;
+}
+
+int uart_rel_on_ack(uart_rel_t *rel, const uint8_t *data, size_t len)
+{
+    uint8_t typ, xid;
+    uint16_t total, offset, clen;
+
+    if (len != SEG_HDR_SIZE + SEG_ACK_BITMAP_SIZE)
+        return -ENOMSG;
+    seg_hdr_read(data, &typ, &xid, &total, &offset, &clen);
+    if (typ != SEG_TYP_ACK || clen != SEG_ACK_BITMAP_SIZE)
+        return -ENOMSG;
+
+    k_spinlock_key_t key = k_spin_lock(&rel->ack_lock);
+    rel->last_ack.valid = true;
+    rel->last_ack.xid = xid;
+    rel->last_ack.total = total;
+    rel->last_ack.cum = offset;
+    rel->last_ack.sack = sys_get_be32(&data[SEG_HDR_SIZE]);
+    k_spin_unlock(&rel->ack_lock, key);
+
+    k_sem_give(&rel->ack_sem);
+    return 0;
+}
+
+#else /* !CONFIG_CUSTOM_UART_RELIABLE */
+
+void uart_rel_init(uart_rel_t *rel, struct uart_io_ctx *io, uart_stats_t *stats)
+{
+    ARG_UNUSED(stats);
+    rel->io = io;
+}
+
+int uart_rel_send(uart_rel_t *rel, const uint8_t *buf, uint16_t len, uint8_t xid)
+{
+    ARG_UNUSED(rel);
+    ARG_UNUSED(buf);
+    ARG_UNUSED(len);
+    ARG_UNUSED(xid);
+    return -ENOTSUP;
+}
+
+int uart_rel_on_ack(uart_rel_t *rel, const uint8_t *data, size_t len)
+{
+    ARG_UNUSED(rel);
+    ARG_UNUSED(data);
+    ARG_UNUSED(len);
+    return -ENOMSG;
+}
+
+#endif
@@ -0,0 +1,56 @@
+#pragma once
+#include <zephyr/kernel.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "uart_cfg.h"
+#include "uart_stats.h"
+
+/* Sliding-window güvenilir segment gönderici (seg header + SEG_F_ACKREQ).
+ * Alıcı tarafı seg_reasm.c içinde ACK üretir. Port başına bir instance. */
+
+struct uart_io_ctx;
+
+#if IS_ENABLED(CONFIG_CUSTOM_UART_RELIABLE)
+#define REL_MAX_SEGS DIV_ROUND_UP(UINT16_MAX, PAYLOAD_MAX)
+
+/* Alınan en son ACK; RX work'ü yazar, gönderen thread okur */
+typedef struct
+{
+    bool valid;
+    uint8_t xid;
+    uint16_t total, cum;
+    uint32_t sack;
+} rel_ack_t;
+
+typedef struct
+{
+    uint8_t xid;
+    uint16_t total, nsegs;
+    uint32_t acked[DIV_ROUND_UP(REL_MAX_SEGS, 32)];
+    uint32_t sent_ms[UART_REL_WINDOW]; /* idx % WINDOW; pencere içinde tekil */
+} rel_tx_t;
+
+typedef struct
+{
+    struct uart_io_ctx *io;
+    struct k_mutex lock; /* aynı anda tek güvenilir gönderim */
+    struct k_sem ack_sem;
+    struct k_spinlock ack_lock;
+    rel_ack_t last_ack;
+    rel_tx_t tx;
+    uart_stats_t *stats;
+} uart_rel_t;
+#else
+typedef struct
+{
+    struct uart_io_ctx *io;
+} uart_rel_t;
+#endif
+
+void uart_rel_init(uart_rel_t *rel, struct uart_io_ctx *io, uart_stats_t *stats);
+
+int uart_rel_send(uart_rel_t *rel, const uint8_t *buf, uint16_t len, uint8_t xid);
+
+/* RX yolundan: 0 → ACK frame'i tüketildi, -ENOMSG → ACK değil */
+int uart_rel_on_ack(uart_rel_t *rel, const uint8_t *data, size_t len);
@@ -0,0 +1,87 @@
+#pragma once
+#include <stdbool.h>
+
+#include "uart_os.h"
+#include "tlv_types.h"
+
+/* id ile indekslenen handler tablosu: dispatch kayıt başına bir sınır kontrolü
+ * ve bir dolaylı çağrıdır, value kopyalanmaz. Handler'lar RX başlamadan (ör.
+ * uart_io_register_rx_cb öncesi) kaydedilir; tablo kilitsiz okunur. */
+
+typedef void (*tlv_handler_t)(const tlv_view_t *v, void *user);
+
+typedef enum
+{
+    TLV_REG_STAT_HANDLED,   /* handler'a teslim edilen TLV */
+    TLV_REG_STAT_UNKNOWN,   /* tabloda handler'ı olmayan id */
+    TLV_REG_STAT_MALFORMED, /* bozuk kayıt; frame'in kalanı atlanır */
+    TLV_REG_STAT_COUNT
+} tlv_reg_stat_id_t;
+
+typedef struct
+{
+    tlv_handler_t fn;
+    void *user;
+} tlv_handler_entry_t;
+
+typedef struct
+{
+    tlv_handler_entry_t handlers[TLV_ID_COUNT];
+    atomic_t cnt[TLV_REG_STAT_COUNT];
+} tlv_registry_t;
+
+/// @brief Clear all handlers and counters
+static inline void tlv_registry_init(tlv_registry_t *reg)
+{
+    memset(reg, 0, sizeof(*reg));
+}
+
+/// @brief Register (fn != NULL) or remove (fn == NULL) the handler of an id
+/// @return 0, -EINVAL for ids outside tlv_id_t
+static inline int tlv_registry_set(tlv_registry_t *reg, tlv_id_t id, tlv_handler_t fn, void *user)
+{
+    if (!reg || (unsigned)id >= TLV_ID_COUNT)
+        return -EINVAL;
+
+    reg->handlers[id].user = user;
+    reg->handlers[id].fn = fn;
+    return 0;
+}
+
+/// @brief Walk every tlv record of frame DATA in place and call each record's handler
+/// @return 0 all handled, -ENOENT some id had no handler, tlv_view_decode() errors
+///         for a malformed record (records before it are already handled)
+static inline int tlv_registry_dispatch(tlv_registry_t *reg, const uint8_t *data, size_t len)
+{
+    tlv_iter_t it;
+    tlv_view_t v;
+    int ret = 0, r;
+
+    tlv_iter_init(&it, data, len);
+    while ((r = tlv_iter_next(&it, &v)) > 0)
+    {
+        const tlv_handler_entry_t *h = (v.id < TLV_ID_COUNT) ? &reg->handlers[v.id] : NULL;
+
+        if (!h || !h->fn)
+        {
+            (void)atomic_inc(&reg->cnt[TLV_REG_STAT_UNKNOWN]);
+            ret = -ENOENT;
+            continue;
+        }
+
+        (void)atomic_inc(&reg->cnt[TLV_REG_STAT_HANDLED]);
+        h->fn(&v, h->user);
+    }
+
+    if (r < 0)
+    {
+        (void)atomic_inc(&reg->cnt[TLV_REG_STAT_MALFORMED]);
+        return r;
+    }
+    return ret;
+}
+
+static inline uint32_t tlv_registry_stat(const tlv_registry_t *reg, tlv_reg_stat_id_t id)
+{
+    return (uint32_t)atomic_get(&reg->cnt[id]);
+}
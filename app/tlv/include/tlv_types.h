@@ -18,6 +18,9 @@ typedef enum {
     TLV_ID_MAX,
     
     TLV_ID_MEASUREMENT,
+    TLV_ID_UART_STATS, /* sürücü yanıtlar (CONFIG_CUSTOM_UART_STATS_TLV_ID) */
+
+    TLV_ID_COUNT,      /* handler tablosu boyu (tlv_registry.h); yeni id'ler bunun önüne */
 } tlv_id_t;
 
 typedef struct 
@@ -30,6 +33,22 @@ typedef struct
 typedef void (*event_fn_t)(tlv_packet_t *p);
 #define TLV_PACK_SIZE  sizeof(tlv_packet_t)
 
+/* Kopyasız TLV: value frame'in içini gösterir, frame bırakılana kadar geçerlidir */
+typedef struct
+{
+    uint8_t id;
+    uint8_t len;
+    const uint8_t *value;
+} tlv_view_t;
+
+/* Çok kayıtlı frame: DATA = TLV TLV ... (kayıtlar arasında boşluk yok).
+ * Tek kayıtlı frame de aynı formattadır; eski alıcılar ilk kaydı okur. */
+typedef struct
+{
+    const uint8_t *p;
+    size_t left;
+} tlv_iter_t;
+
 /// @brief Craete a uart frame with tlv packet
 /// @param frame out
 /// @param tlv_packet in
@@ -77,4 +96,83 @@ static inline int tlv_decode(tlv_packet_t *out, const uart_frame_t *frame)
     out->len = vlen;
     memcpy(out->value, &frame->data[2], vlen);
     return 0;
-}
\ No newline at end of file
+}
+
+/// @brief Parse a tlv header in place; out->value points into data (no copy)
+/// @param out
+/// @param data frame DATA
+/// @param len frame LEN
+/// @return same error codes as tlv_decode()
+static inline int tlv_view_decode(tlv_view_t *out, const uint8_t *data, size_t len)
+{
+    if (!out)
+        return -EFAULT;
+
+    if (!data)
+        return -ENODATA;
+
+    if (len < 2u)
+        return -EBADMSG;
+
+    uint8_t vlen = data[1];
+
+    if (vlen > TLV_MAX_VALUE_SIZE)
+        return -EMSGSIZE;
+
+    if (len < (size_t)(2u + vlen))
+        return -EOVERFLOW;
+
+    out->id = data[0];
+    out->len = vlen;
+    out->value = &data[2];
+    return 0;
+}
+
+/// @brief Append one tlv record to frame DATA; set frame->len = 0 to start an empty frame
+/// @param frame in/out, records are packed back to back
+/// @return 0, -EMSGSIZE value too large, -ENOSPC frame full (frame unchanged)
+static inline int tlv_append(uart_frame_t *frame, uint8_t id, const void *value, uint8_t len)
+{
+    if (!frame || (len && !value))
+        return -EINVAL;
+
+    if (len > TLV_MAX_VALUE_SIZE)
+        return -EMSGSIZE;
+
+    if ((size_t)frame->len + 2u + len > sizeof(frame->data))
+        return -ENOSPC;
+
+    uint8_t *d = &frame->data[frame->len];
+    d[0] = id;
+    d[1] = len;
+    if (len)
+        memcpy(&d[2], value, len);
+
+    frame->len = (uart_frame_len_t)(frame->len + 2u + len);
+    return 0;
+}
+
+static inline void tlv_iter_init(tlv_iter_t *it, const uint8_t *data, size_t len)
+{
+    it->p = data;
+    it->left = data ? len : 0u;
+}
+
+/// @brief Next record of a multi-record frame, in place
+/// @return 1 record in out, 0 end of frame, <0 malformed tail (tlv_view_decode() codes; iteration stops)
+static inline int tlv_iter_next(tlv_iter_t *it, tlv_view_t *out)
+{
+    if (it->left == 0u)
+        return 0;
+
+    int ret = tlv_view_decode(out, it->p, it->left);
+    if (ret < 0)
+    {
+        it->left = 0u;
+        return ret;
+    }
+
+    it->p += 2u + out->len;
+    it->left -= 2u + out->len;
+    return 1;
+}
@@ -0,0 +1,127 @@
+/* Bit hatalı hatta kurtarılan frame oranı. Aynı kaynak iki kez derlenir:
+ * bench_backtrack (CONFIG_CUSTOM_UART_RX_BACKTRACK) ve bench_backtrack_off.
+ * build_frame() akışına (payload'ın 1/8'i SYNC_BYTE) verilen bit hata oranında
+ * rastgele bit hatası eklenir; hiç hata almamış frame'lerden kaçının teslim
+ * edildiği ve akışta olmayan (hayalet) frame sayısı yazılır.
+ *
+ *   ./bench_backtrack [frame_sayısı]
+ */
+
+#include "host_common.h"
+
+#if IS_ENABLED(CONFIG_CUSTOM_UART_RX_BACKTRACK)
+#define BENCH_MODE "on"
+#else
+#define BENCH_MODE "off"
+#endif
+
+#define BENCH_MAX_FRAMES 50000u
+
+static uint8_t pay[BENCH_MAX_FRAMES][UART_MAX_PACKET_SIZE];
+static uint16_t pay_len[BENCH_MAX_FRAMES];
+static bool hit[BENCH_MAX_FRAMES];
+static uint8_t stream[BENCH_MAX_FRAMES * FRAME_MAX_TOTAL];
+
+typedef struct
+{
+    uint32_t nframes;
+    int32_t last;     /* son teslim edilen sıra no */
+    uint32_t ok;      /* hatasız ve teslim edilen */
+    uint32_t phantom; /* akıştaki hiçbir frame'le eşleşmeyen */
+} score_t;
+
+/* Payload'ın ilk iki baytı sıra no: teslim edilen frame kaynağına bağlanır */
+static size_t build_stream(uint32_t nframes, uint32_t *seed, size_t *start)
+{
+    size_t n = 0;
+
+    for (uint32_t k = 0; k < nframes; k++)
+    {
+        uint16_t l = (uint16_t)host_rand_range(seed, 3, UART_MAX_PACKET_SIZE);
+        sys_put_be16((uint16_t)k, pay[k]);
+        for (uint16_t j = 2; j < l; j++)
+            pay[k][j] = (host_rand(seed) % 8u == 0) ? SYNC_BYTE : (uint8_t)host_rand(seed);
+        pay_len[k] = l;
+        start[k] = n;
+        n += build_frame(&stream[n], pay[k], l);
+    }
+    start[nframes] = n;
+    return n;
+}
+
+/* Her bit ber olasılıkla ters çevrilir; hata alan frame'ler işaretlenir */
+static void inject(size_t n, double ber, uint32_t nframes, const size_t *start, uint32_t *seed)
+{
+    uint32_t thr = (uint32_t)(ber * 4294967296.0);
+    uint32_t k = 0;
+
+    memset(hit, 0, sizeof(hit));
+    for (size_t i = 0; i < n; i++)
+    {
+        while (k + 1 < nframes && start[k + 1] <= i)
+            k++;
+        for (int bit = 0; bit < 8; bit++)
+        {
+            if (host_rand(seed) < thr)
+            {
+                stream[i] ^= (uint8_t)(1u << bit);
+                hit[k] = true;
+            }
+        }
+    }
+}
+
+static void on_frame(const uart_frame_t *f, void *user)
+{
+    score_t *s = user;
+    uint32_t k = f->len >= 2 ? sys_get_be16(f->data) : UINT32_MAX;
+
+    if (k < s->nframes && (int32_t)k > s->last && f->len == pay_len[k] && memcmp(f->data, pay[k], f->len) == 0)
+    {
+        s->last = (int32_t)k;
+        s->ok += !hit[k];
+    }
+    else
+    {
+        s->phantom++;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    static size_t start[BENCH_MAX_FRAMES + 1];
+    static const double bers[] = {1e-5, 1e-4, 1e-3, 3e-3, 1e-2};
+    uint32_t nframes = argc > 1 ? (uint32_t)atol(argv[1]) : 20000u;
+    host_rx_t rx;
+
+    nframes = MIN(MAX(nframes, 1u), BENCH_MAX_FRAMES);
+    host_rx_init(&rx, UART_RX_CHUNK_LEN / 5 + 2);
+    printf("backtrack %s, %u frames, payload 3..%u, 1/8 SYNC bytes\n", BENCH_MODE, nframes, UART_MAX_PACKET_SIZE);
+
+    for (size_t b = 0; b < ARRAY_SIZE(bers); b++)
+    {
+        uint32_t seed = 0xb17e;
+        size_t n = build_stream(nframes, &seed, start);
+        inject(n, bers[b], nframes, start, &seed);
+
+        uint32_t intact = 0;
+        for (uint32_t k = 0; k < nframes; k++)
+            intact += !hit[k];
+
+        score_t s = {.nframes = nframes, .last = -1};
+        host_rx_reset(&rx);
+        double t0 = host_now_s();
+        for (size_t i = 0; i < n; i += UART_RX_CHUNK_LEN)
+        {
+            framer_push_bytes(&rx.fr, &stream[i], MIN((size_t)UART_RX_CHUNK_LEN, n - i));
+            host_rx_drain(&rx, on_frame, &s);
+        }
+        double t = host_now_s() - t0;
+
+        CHECK(s.ok <= intact);
+        printf("  ber %.0e: %6u / %6u intact frames delivered (%6.2f%%), %u phantom, %.1f MB/s\n",
+               bers[b], s.ok, intact, intact ? 100.0 * s.ok / intact : 0.0, s.phantom, (double)n / t / 1e6);
+    }
+    host_rx_free(&rx);
+    return 0;
+}
@@ -0,0 +1,137 @@
+/* COBS çerçevelemenin maliyeti ve kazancı. Aynı kaynak iki kez derlenir:
+ * bench_cobs (CONFIG_CUSTOM_UART_COBS) ve bench_cobs_sync (SYNC LEN DATA CRC).
+ *  - encode: build_frame() MB/s (payload'ın %25'i 0x00/0xAA),
+ *  - decode: framer_push_bytes() MB/s, UART_RX_CHUNK_LEN'lik parçalarla (havuz
+ *    bir parçadaki en çok frame'i tutacak derinlikte derlenir),
+ *  - kayıp: frame'lerin ~%5'ine bit hatası ve araya çöp; teslim edilmeyen
+ *    frame sayısı hatalı frame sayısıyla karşılaştırılır.
+ *
+ *   ./bench_cobs [süre_sn]
+ */
+
+#include "host_common.h"
+
+#if IS_ENABLED(CONFIG_CUSTOM_UART_COBS)
+#define BENCH_MODE "COBS"
+#else
+#define BENCH_MODE "SYNC"
+#endif
+
+#define BENCH_FRAMES 20000u
+
+BUILD_ASSERT(UART_MSGQ_DEPTH >= UART_RX_CHUNK_LEN / 2 + 2, "pool must hold a chunk's frames");
+
+static uint8_t stream[BENCH_FRAMES * (FRAME_MAX_TOTAL + 8u)];
+static host_rx_t rx;
+
+/* Ayraç ve SYNC'le çakışan baytlar bol: COBS'un blok kapatma yolu ve SYNC
+ * modunda payload içi sahte SYNC'ler */
+static uint16_t gen_payload(uint8_t *p, uint32_t *seed, uint16_t l)
+{
+    for (uint16_t j = 0; j < l; j++)
+    {
+        uint32_t r = host_rand(seed);
+        p[j] = (r % 8u == 0) ? 0x00 : (r % 8u == 1) ? SYNC_BYTE : (uint8_t)(r >> 8);
+    }
+    return l;
+}
+
+/* Payload'lar önceden üretilir: ölçülen yalnızca build_frame() */
+static void bench_encode(double secs, bool fixed)
+{
+    static uint8_t p[1024][UART_MAX_PACKET_SIZE];
+    static uint16_t pl[1024];
+    uint8_t out[FRAME_MAX_TOTAL];
+    uint32_t seed = 0xe4c0;
+    uint64_t bytes = 0, frames = 0;
+    volatile uint8_t sink = 0;
+
+    for (size_t r = 0; r < ARRAY_SIZE(pl); r++)
+        pl[r] = gen_payload(p[r], &seed, fixed ? UART_MAX_PACKET_SIZE
+                                               : (uint16_t)host_rand_range(&seed, 1, UART_MAX_PACKET_SIZE));
+
+    double t0 = host_now_s(), t;
+    do
+    {
+        for (size_t r = 0; r < ARRAY_SIZE(pl); r++)
+        {
+            sink ^= out[build_frame(out, p[r], pl[r]) - 1];
+            bytes += pl[r];
+        }
+        frames += ARRAY_SIZE(pl);
+        t = host_now_s() - t0;
+    } while (t < secs);
+    (void)sink;
+    printf("  encode len %4s : %8.1f MB/s payload %10.0f frames/s\n",
+           fixed ? "max" : "rand", (double)bytes / t / 1e6, (double)frames / t);
+}
+
+/* Geçerli frame'ler (bozuk=true ise ~%5'i bit hatalı, aralarda 0..7 bayt çöp).
+ * *bad: bit hatası alan frame sayısı. */
+static size_t build_stream(bool corrupt, uint32_t *bad)
+{
+    uint8_t p[UART_MAX_PACKET_SIZE];
+    uint32_t seed = 0x10557;
+    size_t n = 0;
+
+    *bad = 0;
+    for (uint32_t k = 0; k < BENCH_FRAMES; k++)
+    {
+        uint16_t l = gen_payload(p, &seed, (uint16_t)host_rand_range(&seed, 1, UART_MAX_PACKET_SIZE));
+        size_t fl = build_frame(&stream[n], p, l);
+        if (corrupt && host_rand(&seed) % 20u == 0)
+        {
+            stream[n + host_rand(&seed) % fl] ^= (uint8_t)(1u << (host_rand(&seed) % 8u));
+            (*bad)++;
+        }
+        n += fl;
+        if (corrupt)
+            for (uint32_t j = host_rand(&seed) % 8u; j; j--)
+                stream[n++] = (uint8_t)host_rand(&seed);
+    }
+    return n;
+}
+
+static uint32_t feed(size_t n)
+{
+    uint32_t got = 0;
+
+    framer_reset(&rx.fr);
+    for (size_t i = 0; i < n; i += UART_RX_CHUNK_LEN)
+    {
+        framer_push_bytes(&rx.fr, &stream[i], MIN((size_t)UART_RX_CHUNK_LEN, n - i));
+        got += host_rx_drain(&rx, NULL, NULL);
+    }
+    return got;
+}
+
+int main(int argc, char **argv)
+{
+    double secs = argc > 1 ? atof(argv[1]) : 0.5;
+    uint32_t bad;
+
+    host_rx_init(&rx, UART_MSGQ_DEPTH);
+    printf("framing %s, payload 1..%u, 25%% 0x00/0x%02X bytes\n", BENCH_MODE, UART_MAX_PACKET_SIZE, SYNC_BYTE);
+
+    bench_encode(secs, false);
+    bench_encode(secs, true);
+
+    size_t n = build_stream(false, &bad);
+    uint64_t bytes = 0;
+    double t0 = host_now_s(), t;
+    do
+    {
+        CHECK(feed(n) == BENCH_FRAMES);
+        bytes += n;
+        t = host_now_s() - t0;
+    } while (t < secs);
+    printf("  decode          : %8.1f MB/s wire\n", (double)bytes / t / 1e6);
+
+    n = build_stream(true, &bad);
+    uint32_t got = feed(n);
+    CHECK(got <= BENCH_FRAMES && bad > 0);
+    printf("  lost            : %u frames for %u bit flips (%.2f per flip)\n",
+           BENCH_FRAMES - got, bad, (double)(BENCH_FRAMES - got) / bad);
+    host_rx_free(&rx);
+    return 0;
+}
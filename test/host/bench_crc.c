@@ -0,0 +1,134 @@
+/* CRC-16/CCITT backend ölçümü: her CONFIG_CUSTOM_UART_CRC_* için ayrı hedef
+ * (bench_crc_<backend>). Önce kontrol değeri ("123456789" -> 0x29B1) ve rastgele
+ * tamponlarda bit döngülü referansla karşılaştırma, sonra uzunluk başına bayt
+ * başına çevrim (x86'da TSC, diğerlerinde ns) ve MB/s.
+ *
+ *   ./bench_crc_table [süre_sn]
+ *   ./bench_crc_table --vectors N   (Python crc16_ccitt/build_frame karşılaştırması
+ *                                    için "payload crc frame" hex satırları)
+ */
+
+#include "host_common.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_CYC_UNIT "cyc"
+static inline uint64_t bench_cycles(void)
+{
+    return __rdtsc();
+}
+#else
+#define BENCH_CYC_UNIT "ns"
+static inline uint64_t bench_cycles(void)
+{
+    return z_host_ns();
+}
+#endif
+
+#if defined(CONFIG_CUSTOM_UART_CRC_SLICE4)
+#define CRC_BACKEND "SLICE4"
+#elif defined(CONFIG_CUSTOM_UART_CRC_TABLE)
+#define CRC_BACKEND "TABLE"
+#elif defined(CONFIG_CUSTOM_UART_CRC_NIBBLE)
+#define CRC_BACKEND "NIBBLE"
+#else
+#define CRC_BACKEND "BITWISE"
+#endif
+
+/* Backend'den bağımsız referans: seçilen backend'le aynı kod yolundan geçmez */
+static uint16_t crc_ref(uint16_t crc, const uint8_t *d, size_t n)
+{
+    while (n--)
+    {
+        crc ^= (uint16_t)(*d++) << 8;
+        for (int i = 0; i < 8; i++)
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+    return crc;
+}
+
+static void check_backend(void)
+{
+    static uint8_t buf[4096];
+    uint32_t seed = 0xc0c0;
+
+    CHECK(crc16_ccitt_update(0xFFFF, (const uint8_t *)"123456789", 9) == 0x29B1);
+    for (int it = 0; it < 2000; it++)
+    {
+        size_t n = host_rand_range(&seed, 0, sizeof(buf) - 1);
+        size_t off = host_rand(&seed) % 4u; /* SLICE4'ün hizasız başlangıcı */
+        uint16_t init = (uint16_t)host_rand(&seed);
+        for (size_t i = 0; i < n + off && i < sizeof(buf); i++)
+            buf[i] = (uint8_t)host_rand(&seed);
+        n = MIN(n, sizeof(buf) - off);
+        CHECK(crc16_ccitt_update(init, &buf[off], n) == crc_ref(init, &buf[off], n));
+
+        /* Parçalı güncelleme tek seferle aynı */
+        size_t cut = n ? host_rand(&seed) % n : 0;
+        uint16_t c = crc16_ccitt_update(init, &buf[off], cut);
+        CHECK(crc16_ccitt_update(c, &buf[off + cut], n - cut) == crc_ref(init, &buf[off], n));
+    }
+}
+
+static void print_hex(const uint8_t *d, size_t n)
+{
+    for (size_t i = 0; i < n; i++)
+        printf("%02x", d[i]);
+}
+
+static int print_vectors(long count)
+{
+    static uint8_t p[UART_FRAME_LEN_MAX], out[FRAME_MAX_TOTAL];
+    uint32_t seed = 0x7e57;
+
+    for (long v = 0; v < count; v++)
+    {
+        uint16_t l = (uint16_t)host_rand_range(&seed, 1, UART_MAX_PACKET_SIZE);
+        for (uint16_t j = 0; j < l; j++)
+            p[j] = (v % 4 == 0) ? (uint8_t)(v + j) : (uint8_t)host_rand(&seed);
+        size_t fl = build_frame(out, p, l);
+        print_hex(p, l);
+        printf(" %04x ", crc16_ccitt_update(UART_CRC_INT, p, l));
+        print_hex(out, fl);
+        printf("\n");
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc >= 3 && strcmp(argv[1], "--vectors") == 0)
+        return print_vectors(atol(argv[2]));
+
+    double secs = argc > 1 ? atof(argv[1]) : 0.5;
+    const size_t lens[] = {8, UART_MAX_PACKET_SIZE, 256, 2048};
+    static uint8_t buf[2048];
+    uint32_t seed = 0xbe9c;
+    volatile uint16_t sink = 0;
+
+    check_backend();
+    for (size_t i = 0; i < sizeof(buf); i++)
+        buf[i] = (uint8_t)host_rand(&seed);
+
+    printf("crc16_ccitt %s: check 0x29B1 ok\n", CRC_BACKEND);
+    for (size_t k = 0; k < ARRAY_SIZE(lens); k++)
+    {
+        uint64_t bytes = 0, c0 = bench_cycles();
+        double t0 = host_now_s(), t;
+        uint16_t crc = UART_CRC_INT;
+
+        do
+        {
+            for (int r = 0; r < 256; r++)
+                crc = crc16_ccitt_update(crc, buf, lens[k]);
+            bytes += 256u * lens[k];
+            t = host_now_s() - t0;
+        } while (t < secs);
+        sink ^= crc;
+
+        printf("  len %4zu: %6.2f %s/B %8.1f MB/s\n", lens[k],
+               (double)(bench_cycles() - c0) / (double)bytes, BENCH_CYC_UNIT, (double)bytes / t / 1e6);
+    }
+    (void)sink;
+    return 0;
+}
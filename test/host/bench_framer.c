@@ -0,0 +1,69 @@
+/* framer_push_bytes verim ölçümü (MB/s). Rastgele boylu (1..UART_MAX_PACKET_SIZE)
+ * frame'lerden kurulu akış, drain'in verdiği boyutlarda parçalarla beslenir:
+ * UART_RX_CHUNK_LEN (DMA buffer'ı), 256 (kopyalı drain'in tmp'si) ve 4096.
+ *
+ *   ./bench_framer [süre_sn]
+ *
+ * Her turda teslim edilen frame sayısı akıştakiyle karşılaştırılır. */
+
+#include "host_common.h"
+
+#define BENCH_STREAM (1u << 20)
+
+static uint8_t stream[BENCH_STREAM + FRAME_MAX_TOTAL];
+
+static size_t build_stream(uint32_t *nframes)
+{
+    uint8_t p[UART_MAX_PACKET_SIZE];
+    uint32_t seed = 0x5eed;
+    size_t n = 0;
+
+    *nframes = 0;
+    while (n < BENCH_STREAM)
+    {
+        uint16_t l = (uint16_t)host_rand_range(&seed, 1, UART_MAX_PACKET_SIZE);
+        for (uint16_t j = 0; j < l; j++)
+            p[j] = (uint8_t)host_rand(&seed);
+        n += build_frame(&stream[n], p, l);
+        (*nframes)++;
+    }
+    return n;
+}
+
+int main(int argc, char **argv)
+{
+    double secs = argc > 1 ? atof(argv[1]) : 1.0;
+    const size_t chunks[] = {UART_RX_CHUNK_LEN, 256, 4096};
+    uint32_t nframes;
+    size_t n = build_stream(&nframes);
+    host_rx_t rx;
+
+    host_rx_init(&rx, 4096 / 5 + 2); /* en kısa frame 5 bayt */
+    printf("framer: %zu B stream, %u frames, payload 1..%u\n", n, nframes, UART_MAX_PACKET_SIZE);
+
+    for (size_t c = 0; c < ARRAY_SIZE(chunks); c++)
+    {
+        size_t chunk = chunks[c];
+        uint64_t bytes = 0, frames = 0;
+        double t0 = host_now_s(), t;
+
+        do
+        {
+            host_rx_reset(&rx);
+            uint32_t got = 0;
+            for (size_t i = 0; i < n; i += chunk)
+            {
+                framer_push_bytes(&rx.fr, &stream[i], MIN(chunk, n - i));
+                got += host_rx_drain(&rx, NULL, NULL);
+            }
+            CHECK(got == nframes);
+            bytes += n;
+            frames += got;
+            t = host_now_s() - t0;
+        } while (t < secs);
+
+        printf("  chunk %7zu: %8.1f MB/s %10.0f frames/s\n", chunk, (double)bytes / t / 1e6, (double)frames / t);
+    }
+    host_rx_free(&rx);
+    return 0;
+}
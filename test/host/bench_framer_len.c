@@ -0,0 +1,91 @@
+/* Payload boyuna göre frames/s: aynı boydaki frame'lerden kurulu akış
+ * UART_RX_CHUNK_LEN'lik parçalarla (DMA buffer'ı, drain'in verdiği boy) beslenir;
+ * kuyruk UART_MSGQ_DEPTH frame tuttuğu için kısa frame'lerde parça o kadar
+ * frame'e iner.
+ * bench_framer_len DATA'yı tek parça tüketen yolu, bench_framer_len_bytewise
+ * (FRAMER_DATA_RUN=0) her baytı P[] üzerinden işleyen eski yolu ölçer; ikisi de
+ * CONFIG_CUSTOM_UART_RX_STACK_SIZE=255 ile 1..255 arası boyları kapsar.
+ *
+ *   ./bench_framer_len [süre_sn] [boy...]
+ */
+
+#include "host_common.h"
+#include "uart_frame.h"
+
+#define BENCH_STREAM (256u * 1024u)
+
+#if defined(FRAMER_DATA_RUN) && !FRAMER_DATA_RUN
+#define BENCH_PATH "bytewise"
+#else
+#define BENCH_PATH "bulk"
+#endif
+
+static uint8_t stream[BENCH_STREAM + FRAME_MAX_TOTAL];
+static host_rx_t rx;
+
+static size_t build_stream(uint16_t l, uint32_t *nframes)
+{
+    uint8_t p[UART_MAX_PACKET_SIZE];
+    uint32_t seed = 0x5eed + l;
+    size_t n = 0;
+
+    *nframes = 0;
+    while (n < BENCH_STREAM)
+    {
+        for (uint16_t j = 0; j < l; j++)
+            p[j] = (uint8_t)host_rand(&seed);
+        n += build_frame(&stream[n], p, l);
+        (*nframes)++;
+    }
+    return n;
+}
+
+int main(int argc, char **argv)
+{
+    static const uint16_t def_lens[] = {1, 2, 4, 8, 16, 32, 48, 64, 96, 128, 192, 224, 255};
+    uint16_t lens[ARRAY_SIZE(def_lens) + 64];
+    size_t nlens = 0;
+    double secs = argc > 1 ? atof(argv[1]) : 0.2;
+
+    for (int a = 2; a < argc && nlens < ARRAY_SIZE(lens); a++)
+        lens[nlens++] = (uint16_t)atoi(argv[a]);
+    if (!nlens)
+    {
+        memcpy(lens, def_lens, sizeof(def_lens));
+        nlens = ARRAY_SIZE(def_lens);
+    }
+
+    host_rx_init(&rx, UART_MSGQ_DEPTH);
+    printf("framer (%s DATA), chunk %u\n", BENCH_PATH, UART_RX_CHUNK_LEN);
+
+    for (size_t k = 0; k < nlens; k++)
+    {
+        uint16_t l = lens[k];
+        CHECK(l >= 1 && l <= UART_MAX_PACKET_SIZE);
+
+        uint32_t nframes;
+        size_t n = build_stream(l, &nframes);
+        size_t slice = MIN((size_t)UART_RX_CHUNK_LEN, UART_MSGQ_DEPTH * (size_t)(l + FRAME_OVERHEAD_BYTES));
+        uint64_t bytes = 0, frames = 0;
+        double t0 = host_now_s(), t;
+
+        do
+        {
+            framer_reset(&rx.fr);
+            uint32_t got = 0;
+            for (size_t i = 0; i < n; i += slice)
+            {
+                framer_push_bytes(&rx.fr, &stream[i], MIN(slice, n - i));
+                got += host_rx_drain(&rx, NULL, NULL);
+            }
+            CHECK(got == nframes);
+            bytes += n;
+            frames += got;
+            t = host_now_s() - t0;
+        } while (t < secs);
+
+        printf("  len %3u: %10.0f frames/s %8.1f MB/s\n", l, (double)frames / t, (double)bytes / t / 1e6);
+    }
+    host_rx_free(&rx);
+    return 0;
+}
@@ -0,0 +1,67 @@
+#!/usr/bin/env python3
+"""Cross-check the C CRC backends and build_frame() against the Python
+testbench (test/zephyr_uart_testbench.py).
+
+Usage: check_crc_py.py <bench_crc binary> [vectors]
+
+The testbench imports pyserial at module level; a stub 'serial' module is
+installed first so the check runs without pyserial or a serial port.
+"""
+
+import os
+import subprocess
+import sys
+import types
+
+
+def import_testbench():
+    if "serial" not in sys.modules:
+        stub = types.ModuleType("serial")
+
+        class Serial:  # only referenced in annotations
+            pass
+
+        class SerialException(Exception):
+            pass
+
+        stub.Serial = Serial
+        stub.SerialException = SerialException
+        sys.modules["serial"] = stub
+    sys.dont_write_bytecode = True  # keep test/ free of __pycache__
+    sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), ".."))
+    import zephyr_uart_testbench as tb
+    return tb
+
+
+def main(argv):
+    if len(argv) < 2:
+        print(__doc__, file=sys.stderr)
+        return 2
+    count = int(argv[2]) if len(argv) > 2 else 500
+    tb = import_testbench()
+
+    assert tb.crc16_ccitt(b"123456789") == 0x29B1
+    out = subprocess.run([argv[1], "--vectors", str(count)], check=True,
+                         capture_output=True, text=True).stdout
+    n = 0
+    for line in out.splitlines():
+        payload_hex, crc_hex, frame_hex = line.split()
+        payload = bytes.fromhex(payload_hex)
+        crc = tb.crc16_ccitt(payload)
+        if crc != int(crc_hex, 16):
+            print(f"crc mismatch for {payload_hex}: C {crc_hex}, Python {crc:04x}", file=sys.stderr)
+            return 1
+        frame = tb.build_frame(payload)
+        if frame != bytes.fromhex(frame_hex):
+            print(f"frame mismatch for {payload_hex}:\n  C  {frame_hex}\n  Py {frame.hex()}", file=sys.stderr)
+            return 1
+        n += 1
+    if n != count:
+        print(f"expected {count} vectors, got {n}", file=sys.stderr)
+        return 1
+    print(f"check_crc_py: {n} vectors match")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
@@ -0,0 +1,246 @@
+/* framer_push_bytes fuzz hedefi.
+ *
+ *   libFuzzer: cmake -DUART_HOST_LIBFUZZER=ON -DCMAKE_C_COMPILER=clang ...
+ *              ./fuzz_framer_sync corpus/
+ *   AFL:       CC=afl-clang-fast cmake ...; afl-fuzz -i in -o out -- ./fuzz_framer_sync @@
+ *   bağımsız:  ./fuzz_framer_sync dosya...   (kayıtlı girdileri tekrar oynatır)
+ *              ./fuzz_framer_sync -r N [tohum] (gürültü + geçerli/bozuk frame akışları; ctest)
+ *
+ * Girdi üç şekilde beslenir: tek parça, bayt bayt ve girdiden türeyen 1..64
+ * baytlık parçalar. Her beslemede:
+ *  - frame.len 1..UART_FRAME_LEN_MAX; data[] dışına yazım ASan'a takılır,
+ *  - teslim edilen her frame girdide bir öncekinin bittiği yerden sonra birebir
+ *    geçer: parse edilen her bayt girdiden gelir ve en fazla bir frame'e girer,
+ *  - frame dizisi ve hata sayaçları üç beslemede aynıdır: parçalama bir baytın
+ *    kaç kez tüketildiğini değiştirmez.
+ * Havuz girdideki en fazla frame sayısı kadar: pool_empty yolu devreye girmez. */
+
+#include "host_common.h"
+
+#define FUZZ_MAX_LEN 16384u
+
+typedef struct
+{
+    const uint8_t *in;
+    size_t n;
+    size_t pos;     /* önceki frame'in girdideki bitişi */
+    uint32_t count;
+    uint64_t digest;
+} fuzz_run_t;
+
+static host_rx_t rx;
+
+/* Frame'in kablodaki görüntüsü img[0..il). COBS'ta ayraçlar komşu frame'le
+ * paylaşılabilir, görüntü onlarsız döner. Son bloğun kod baytı (*wild) büyük
+ * de olabilir: parser CRC_L'de teslim eder, ayraca kadarki kalanı atar. */
+static size_t frame_image(uint8_t *img, const uart_frame_t *f, bool jumbo, size_t *wild)
+{
+    static uint8_t out[FRAME_MAX_TOTAL + 3];
+
+    *wild = SIZE_MAX;
+#if IS_ENABLED(CONFIG_CUSTOM_UART_COBS)
+    ARG_UNUSED(jumbo);
+    size_t n = build_frame(out, f->data, f->len) - 2;
+    memcpy(img, &out[1], n);
+    size_t c = 0;
+    while (c + img[c] < n)
+        c += img[c];
+    *wild = c;
+    return n;
+#else
+    ARG_UNUSED(out);
+    if (!jumbo)
+    {
+        img[0] = SYNC_BYTE;
+        img[1] = (uint8_t)f->len;
+    }
+    else
+    {
+        img[0] = SYNC_BYTE_JUMBO;
+        sys_put_be16(f->len, &img[1]);
+    }
+    size_t h = jumbo ? 3u : 2u; /* SYNC + LEN */
+    memcpy(&img[h], f->data, f->len);
+    uint16_t crc = crc16_ccitt_update(UART_CRC_INT, &img[1], h - 1 + f->len);
+    sys_put_be16(crc, &img[h + f->len]);
+    return h + f->len + 2;
+#endif
+}
+
+static bool image_match(const uint8_t *in, const uint8_t *img, size_t il, size_t wild)
+{
+    for (size_t j = 0; j < il; j++)
+        if (j == wild ? in[j] < img[j] : in[j] != img[j])
+            return false;
+    return true;
+}
+
+static bool image_at(fuzz_run_t *r, const uart_frame_t *f, bool jumbo)
+{
+    static uint8_t img[FRAME_MAX_TOTAL + 3];
+    size_t wild;
+    size_t il = frame_image(img, f, jumbo, &wild);
+
+    for (size_t i = r->pos; i + il <= r->n; i++)
+    {
+        if (image_match(&r->in[i], img, il, wild))
+        {
+            r->pos = i + il;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void on_frame(const uart_frame_t *f, void *user)
+{
+    fuzz_run_t *r = user;
+
+    bool found = image_at(r, f, false);
+#if IS_ENABLED(CONFIG_CUSTOM_UART_JUMBO)
+    /* Jumbo SYNC'li frame klasik boyda da olabilir */
+    if (!found)
+        found = image_at(r, f, true);
+#endif
+    if (!found)
+    {
+        fprintf(stderr, "frame %u (len %u) not found after input offset %zu\n", r->count, f->len, r->pos);
+        abort();
+    }
+
+    /* FNV-1a: üç beslemenin frame dizilerini karşılaştırmak için */
+    r->digest ^= f->len;
+    r->digest *= 1099511628211ull;
+    for (size_t i = 0; i < f->len; i++)
+    {
+        r->digest ^= f->data[i];
+        r->digest *= 1099511628211ull;
+    }
+    r->count++;
+}
+
+static const uart_stat_id_t err_stats[] = {
+    UART_STAT_RX_FRAMES, UART_STAT_RX_LEN_ERR, UART_STAT_RX_CRC_ERR,
+    UART_STAT_RX_BUDGET_ERR, UART_STAT_RX_COBS_ERR, UART_STAT_RX_POOL_EMPTY,
+};
+
+typedef enum { FEED_WHOLE, FEED_BYTES, FEED_CHUNKS, FEED_COUNT } feed_t;
+
+static void run_feed(const uint8_t *in, size_t n, feed_t how, fuzz_run_t *r, uint32_t *stats)
+{
+    memset(r, 0, sizeof(*r));
+    r->in = in;
+    r->n = n;
+    r->digest = 14695981039346656037ull;
+    host_rx_reset(&rx);
+
+    for (size_t i = 0; i < n;)
+    {
+        size_t c = how == FEED_WHOLE ? n : how == FEED_BYTES ? 1 : 1u + in[i] % 64u;
+        c = MIN(c, n - i);
+        framer_push_bytes(&rx.fr, &in[i], c);
+        host_rx_drain(&rx, on_frame, r);
+        i += c;
+    }
+    for (size_t k = 0; k < ARRAY_SIZE(err_stats); k++)
+        stats[k] = host_stat(&rx, err_stats[k]);
+
+    CHECK(stats[0] == r->count);
+    /* Yarım kalan frame'in bloğu parser'da; geri kalan her blok havuza dönmüş olmalı */
+    CHECK(k_mem_slab_num_free_get(&rx.slab) + (rx.fr.frame ? 1u : 0u) == rx.depth);
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    if (!rx.depth)
+        host_rx_init(&rx, FUZZ_MAX_LEN / 4u + 2u);
+    size = MIN(size, (size_t)FUZZ_MAX_LEN);
+
+    fuzz_run_t ref, r;
+    uint32_t ref_st[ARRAY_SIZE(err_stats)], st[ARRAY_SIZE(err_stats)];
+
+    run_feed(data, size, FEED_WHOLE, &ref, ref_st);
+    for (feed_t how = FEED_BYTES; how < FEED_COUNT; how++)
+    {
+        run_feed(data, size, how, &r, st);
+        if (r.count != ref.count || r.digest != ref.digest || memcmp(st, ref_st, sizeof(st)) != 0)
+        {
+            fprintf(stderr, "feed %d differs from single push: %u vs %u frames\n", how, r.count, ref.count);
+            abort();
+        }
+    }
+    return 0;
+}
+
+#ifndef UART_FUZZ_LIBFUZZER
+/* Rastgele akış: gürültü, SYNC'li gürültü, geçerli ve bit hatalı frame'ler */
+static size_t gen_stream(uint8_t *buf, size_t cap, uint32_t *seed)
+{
+    static uint8_t p[UART_FRAME_LEN_MAX];
+    size_t n = 0;
+
+    while (n + FRAME_MAX_TOTAL + 64 < cap)
+    {
+        uint32_t k = host_rand(seed) % 8u;
+        if (k < 2)
+        {
+            uint32_t r = host_rand(seed) % 40u;
+            for (uint32_t j = 0; j < r; j++)
+                buf[n++] = (host_rand(seed) % 4u == 0) ? SYNC_BYTE : (uint8_t)host_rand(seed);
+            continue;
+        }
+        uint16_t max = (k == 7) ? UART_FRAME_LEN_MAX : UART_MAX_PACKET_SIZE;
+        uint16_t l = (uint16_t)host_rand_range(seed, 1, max);
+        for (uint16_t j = 0; j < l; j++)
+            p[j] = (host_rand(seed) % 8u == 0) ? SYNC_BYTE : (uint8_t)host_rand(seed);
+        size_t fl = build_frame(&buf[n], p, l);
+        if (k < 4)
+            buf[n + host_rand(seed) % fl] ^= (uint8_t)(1u << (host_rand(seed) % 8u));
+        if (k == 4)
+            fl = host_rand(seed) % fl; /* kesik frame */
+        n += fl;
+    }
+    return n;
+}
+
+static int replay_file(const char *path)
+{
+    static uint8_t buf[FUZZ_MAX_LEN];
+    FILE *f = fopen(path, "rb");
+    if (!f)
+    {
+        perror(path);
+        return 1;
+    }
+    size_t n = fread(buf, 1, sizeof(buf), f);
+    fclose(f);
+    return LLVMFuzzerTestOneInput(buf, n);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc >= 3 && strcmp(argv[1], "-r") == 0)
+    {
+        static uint8_t buf[FUZZ_MAX_LEN];
+        long iters = atol(argv[2]);
+        uint32_t seed = argc > 3 ? (uint32_t)strtoul(argv[3], NULL, 0) : 1u;
+
+        for (long i = 0; i < iters; i++)
+        {
+            size_t cap = host_rand_range(&seed, FRAME_MAX_TOTAL + 128u, sizeof(buf));
+            LLVMFuzzerTestOneInput(buf, gen_stream(buf, cap, &seed));
+        }
+        printf("fuzz_framer: %ld random streams ok\n", iters);
+        return 0;
+    }
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s -r ITERATIONS [SEED] | FILE...\n", argv[0]);
+        return 2;
+    }
+    for (int i = 1; i < argc; i++)
+        if (replay_file(argv[i]))
+            return 1;
+    return 0;
+}
+#endif
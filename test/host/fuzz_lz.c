@@ -0,0 +1,218 @@
+/* lz_decompress fuzz hedefi.
+ *
+ *   libFuzzer: cmake -DUART_HOST_LIBFUZZER=ON -DCMAKE_C_COMPILER=clang ...
+ *              ./fuzz_lz corpus/
+ *   bağımsız:  ./fuzz_lz dosya...   (kayıtlı girdileri tekrar oynatır)
+ *              ./fuzz_lz -r N [tohum] (sabit kenar durumları + sıkıştırılıp
+ *              bozulan/kesilen akışlar; ctest)
+ *
+ * Girdi: BE16 geçmiş boyu, BE16 cap, ardından sıkışık akış. Geçmiş ve çıktı
+ * tam boyunda ayrılır, akış tam boyunda kopyalanır: dışına okuma/yazma ASan'a
+ * takılır. Her girdide:
+ *  - sonuç -EBADMSG veya 0..cap, geçmiş değişmez,
+ *  - başarılıysa aynı akış tam sonuç boyundaki cap ile aynı baytları verir,
+ *    bir bayt eksik cap ile -EBADMSG döner: çözücü cap'e kadar yazar, ötesine
+ *    yazmaz. */
+
+#include <errno.h>
+
+#include "host_common.h"
+#include "lz.h"
+
+#define LZ_FUZZ_MAX 4096u
+
+static int run(const uint8_t *src, size_t n, const uint8_t *hist_bytes, size_t hist, size_t cap, uint8_t *out)
+{
+    uint8_t *s = malloc(n ? n : 1);
+    uint8_t *buf = malloc(hist + cap ? hist + cap : 1);
+    CHECK(s && buf);
+    memcpy(s, src, n);
+    memcpy(buf, hist_bytes, hist);
+
+    int rc = lz_decompress(s, n, &buf[hist], hist, cap);
+    CHECK(rc == -EBADMSG || (rc >= 0 && (size_t)rc <= cap));
+    CHECK(memcmp(buf, hist_bytes, hist) == 0);
+    if (rc > 0 && out)
+        memcpy(out, &buf[hist], (size_t)rc);
+    free(buf);
+    free(s);
+    return rc;
+}
+
+static int check_stream(const uint8_t *src, size_t n, const uint8_t *hist_bytes, size_t hist, size_t cap)
+{
+    static uint8_t a[LZ_FUZZ_MAX], b[LZ_FUZZ_MAX];
+
+    int rc = run(src, n, hist_bytes, hist, cap, a);
+    if (rc < 0)
+        return rc;
+    CHECK(run(src, n, hist_bytes, hist, (size_t)rc, b) == rc);
+    CHECK(memcmp(a, b, (size_t)rc) == 0);
+    if (rc > 0)
+        CHECK(run(src, n, hist_bytes, hist, (size_t)rc - 1u, NULL) == -EBADMSG);
+    return rc;
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    static uint8_t hist_bytes[LZ_FUZZ_MAX];
+
+    if (size < 4)
+        return 0;
+    size_t hist = sys_get_be16(data) % (LZ_FUZZ_MAX + 1u);
+    size_t cap = sys_get_be16(&data[2]) % (LZ_FUZZ_MAX + 1u);
+    for (size_t i = 0; i < hist; i++)
+        hist_bytes[i] = (uint8_t)(i * 7u);
+    (void)check_stream(&data[4], size - 4, hist_bytes, hist, cap);
+    return 0;
+}
+
+#ifndef UART_FUZZ_LIBFUZZER
+/* Elle yazılmış akışlar: geçmiş sınırı, ext zincirleri, kesik diziler */
+static void edge_cases(void)
+{
+    static const uint8_t hist[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    uint8_t s[600];
+    uint8_t out[64];
+
+    /* 2 literal + geçmişin başına uzanan eşleşme: ofs == hist + o sınırda geçerli */
+    const uint8_t at_edge[] = {0x20, 'a', 'b', 0x00, 10};
+    CHECK(run(at_edge, sizeof(at_edge), hist, 8, 64, out) == 6);
+    CHECK(memcmp(out, "ab\x01\x02\x03\x04", 6) == 0);
+    const uint8_t past_edge[] = {0x20, 'a', 'b', 0x00, 11};
+    CHECK(run(past_edge, sizeof(past_edge), hist, 8, 64, NULL) == -EBADMSG);
+    const uint8_t ofs_zero[] = {0x10, 'a', 0x00, 0x00};
+    CHECK(run(ofs_zero, sizeof(ofs_zero), hist, 8, 64, NULL) == -EBADMSG);
+
+    /* ofs < m: kendini tekrarlayan koşu */
+    const uint8_t rle[] = {0x12, 'x', 0x00, 0x01};
+    CHECK(run(rle, sizeof(rle), hist, 0, 64, out) == 7 && memcmp(out, "xxxxxxx", 7) == 0);
+
+    /* Literal ext zinciri: 15 + 255 + 255 + 2 = 527 literal; akış veya cap
+     * eksikse reddedilir, zincir 255 ile biterse de */
+    size_t n = 0;
+    s[n++] = 0xF0;
+    s[n++] = 255;
+    s[n++] = 255;
+    s[n++] = 2;
+    memset(&s[n], 'L', 527);
+    CHECK(run(s, n + 527, hist, 0, 527, NULL) == 527);
+    CHECK(run(s, n + 526, hist, 0, 527, NULL) == -EBADMSG);
+    CHECK(run(s, n + 527, hist, 0, 526, NULL) == -EBADMSG);
+    CHECK(run(s, 3, hist, 0, 527, NULL) == -EBADMSG);
+
+    /* Eşleşme ext zinciri cap'i aşar; zincir akış sonunda kesilir */
+    const uint8_t long_match[] = {0x1F, 'y', 0x00, 0x01, 255, 255, 0};
+    CHECK(run(long_match, sizeof(long_match), hist, 0, 1 + 4 + 15 + 510, NULL) == 1 + 4 + 15 + 510);
+    CHECK(run(long_match, sizeof(long_match), hist, 0, 1 + 4 + 15 + 509, NULL) == -EBADMSG);
+    CHECK(run(long_match, sizeof(long_match) - 1, hist, 0, 1024, NULL) == -EBADMSG);
+
+    /* Ofset'in tek baytı */
+    const uint8_t short_ofs[] = {0x10, 'a', 0x00};
+    CHECK(run(short_ofs, sizeof(short_ofs), hist, 0, 64, NULL) == -EBADMSG);
+}
+
+/* Sıkıştırılabilir veri: rastgele literal'ler ve önceki baytların kopyaları */
+static size_t gen_data(uint8_t *d, size_t cap, uint32_t *seed)
+{
+    size_t n = host_rand_range(seed, 1, (uint32_t)cap);
+
+    for (size_t i = 0; i < n;)
+    {
+        size_t r = host_rand_range(seed, 1, 40);
+        r = MIN(r, n - i);
+        if (i >= 8 && host_rand(seed) % 2u)
+        {
+            size_t from = host_rand(seed) % i;
+            for (size_t k = 0; k < r; k++)
+                d[i + k] = d[from + k];
+        }
+        else
+        {
+            for (size_t k = 0; k < r; k++)
+                d[i + k] = (uint8_t)(host_rand(seed) % 6u);
+        }
+        i += r;
+    }
+    return n;
+}
+
+/* Transferi parça parça sıkıştır; her parça önceki parçalar geçmişken birebir
+ * çözülmeli. Sonra parçanın bozuk/kesik/uzatılmış hali check_stream'e girer. */
+static void round_trip(uint32_t *seed)
+{
+    static uint8_t d[LZ_FUZZ_MAX], z[LZ_FUZZ_MAX + 64], out[LZ_FUZZ_MAX];
+    static lz_enc_t enc;
+    size_t n = gen_data(d, sizeof(d), seed);
+
+    lz_enc_begin(&enc, d);
+    for (size_t pos = 0; pos < n;)
+    {
+        size_t part = host_rand_range(seed, 1, 300);
+        part = MIN(part, n - pos);
+        size_t zn = lz_enc_block(&enc, pos, part, z, part + 16u);
+        if (zn)
+        {
+            CHECK(run(z, zn, d, pos, part, out) == (int)part);
+            CHECK(memcmp(out, &d[pos], part) == 0);
+
+            switch (host_rand(seed) % 4u)
+            {
+            case 0:
+                z[host_rand(seed) % zn] ^= (uint8_t)(1u << (host_rand(seed) % 8u));
+                break;
+            case 1:
+                zn = host_rand(seed) % zn; /* kesik */
+                break;
+            case 2:
+                for (uint32_t k = host_rand_range(seed, 1, 40); k > 0; k--)
+                    z[zn++] = (uint8_t)host_rand(seed);
+                break;
+            default:
+                z[host_rand(seed) % zn] = 255; /* token veya ext: zincir uzar */
+                break;
+            }
+            (void)check_stream(z, zn, d, pos, host_rand_range(seed, 0, (uint32_t)(part + 64u)));
+        }
+        pos += part;
+    }
+}
+
+static int replay_file(const char *path)
+{
+    static uint8_t buf[LZ_FUZZ_MAX + 4];
+    FILE *f = fopen(path, "rb");
+    if (!f)
+    {
+        perror(path);
+        return 1;
+    }
+    size_t n = fread(buf, 1, sizeof(buf), f);
+    fclose(f);
+    return LLVMFuzzerTestOneInput(buf, n);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc >= 3 && strcmp(argv[1], "-r") == 0)
+    {
+        long iters = atol(argv[2]);
+        uint32_t seed = argc > 3 ? (uint32_t)strtoul(argv[3], NULL, 0) : 1u;
+
+        edge_cases();
+        for (long i = 0; i < iters; i++)
+            round_trip(&seed);
+        printf("fuzz_lz: edge cases and %ld random transfers ok\n", iters);
+        return 0;
+    }
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s -r ITERATIONS [SEED] | FILE...\n", argv[0]);
+        return 2;
+    }
+    for (int i = 1; i < argc; i++)
+        if (replay_file(argv[i]))
+            return 1;
+    return 0;
+}
+#endif
@@ -0,0 +1,108 @@
+#pragma once
+
+/* Host test ve benchmark'larının ortak parçaları: uart_os.h host tarafıyla
+ * kurulan framer (havuz + kuyruk), tohumlu PRNG, zaman ve kontrol makroları. */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "uart_os.h"
+#include "framer.h"
+#include "crc16_ccitt.h"
+
+#define CHECK(cond)                                                            \
+    do                                                                         \
+    {                                                                          \
+        if (!(cond))                                                           \
+        {                                                                      \
+            fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+            exit(1);                                                           \
+        }                                                                      \
+    } while (0)
+
+/* ---- xorshift32: testler platformdan bağımsız aynı akışı üretir ---- */
+static inline uint32_t host_rand(uint32_t *s)
+{
+    uint32_t x = *s;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *s = x;
+}
+
+/* [lo, hi] aralığında */
+static inline uint32_t host_rand_range(uint32_t *s, uint32_t lo, uint32_t hi)
+{
+    return lo + host_rand(s) % (hi - lo + 1u);
+}
+
+#if !defined(__ZEPHYR__) /* zsim'de zaman simüledir, bkz. zsim/zsim.h */
+static inline double host_now_s(void)
+{
+    return (double)z_host_ns() * 1e-9;
+}
+#endif
+
+/* ---- Host framer: havuz ve kuyruk aynı derinlikte, bloklar heap'ten ---- */
+typedef struct
+{
+    framer_t fr;
+    struct k_mem_slab slab;
+    struct k_msgq q;
+    uart_stats_t st;
+    void *blocks;
+    uart_frame_t **qbuf;
+    uint32_t depth;
+} host_rx_t;
+
+static inline void host_rx_init(host_rx_t *h, uint32_t depth)
+{
+    memset(h, 0, sizeof(*h));
+    h->depth = depth;
+    h->blocks = malloc((size_t)depth * FRAMER_BLOCK_SIZE);
+    h->qbuf = calloc(depth, sizeof(*h->qbuf));
+    CHECK(h->blocks && h->qbuf);
+    CHECK(k_mem_slab_init(&h->slab, h->blocks, FRAMER_BLOCK_SIZE, depth) == 0);
+    k_msgq_init(&h->q, (char *)h->qbuf, sizeof(uart_frame_t *), depth);
+    framer_init(&h->fr, &h->slab, &h->q, &h->st);
+}
+
+/* Aynı havuzla sıfırdan başla (bekleyen frame'ler bırakılmış olmalı) */
+static inline void host_rx_reset(host_rx_t *h)
+{
+    /* Parser başarısız frame'in bloğunu sonraki frame için tutar */
+    if (h->fr.frame)
+        k_mem_slab_free(&h->slab, CONTAINER_OF(h->fr.frame, frame_blk_t, frame));
+    memset(&h->st, 0, sizeof(h->st));
+    framer_init(&h->fr, &h->slab, &h->q, &h->st);
+}
+
+static inline void host_rx_free(host_rx_t *h)
+{
+    free(h->blocks);
+    free(h->qbuf);
+}
+
+/* Kuyruktaki frame'leri fn'e ver ve bırak; teslim edilen sayıyı döner */
+typedef void (*host_frame_fn_t)(const uart_frame_t *f, void *user);
+
+static inline uint32_t host_rx_drain(host_rx_t *h, host_frame_fn_t fn, void *user)
+{
+    uart_frame_t *f;
+    uint32_t n = 0;
+
+    while (k_msgq_get(&h->q, &f, K_NO_WAIT) == 0)
+    {
+        CHECK(f->len >= 1 && f->len <= UART_FRAME_LEN_MAX);
+        if (fn)
+            fn(f, user);
+        framer_frame_release(f);
+        n++;
+    }
+    return n;
+}
+
+static inline uint32_t host_stat(const host_rx_t *h, uart_stat_id_t id)
+{
+    return (uint32_t)atomic_get(&h->st.cnt[id]);
+}
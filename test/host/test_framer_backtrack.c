@@ -0,0 +1,151 @@
+/* CONFIG_CUSTOM_UART_RX_BACKTRACK senaryoları. Her akış tek parça ve bayt bayt
+ * beslenir; teslim edilen frame dizisi beklenenle birebir aynı olmalı. */
+
+#include "host_common.h"
+
+#if !IS_ENABLED(CONFIG_CUSTOM_UART_RX_BACKTRACK)
+#error "test_framer_backtrack needs CONFIG_CUSTOM_UART_RX_BACKTRACK"
+#endif
+
+#define MAX_FRAMES 16
+
+typedef struct
+{
+    uint32_t n;
+    uint16_t len[MAX_FRAMES];
+    uint8_t data[MAX_FRAMES][UART_FRAME_LEN_MAX];
+} got_t;
+
+static host_rx_t rx;
+
+static void on_frame(const uart_frame_t *f, void *user)
+{
+    got_t *g = user;
+
+    CHECK(g->n < MAX_FRAMES);
+    g->len[g->n] = f->len;
+    memcpy(g->data[g->n], f->data, f->len);
+    g->n++;
+}
+
+static void feed(const uint8_t *s, size_t n, size_t chunk, got_t *g)
+{
+    memset(g, 0, sizeof(*g));
+    host_rx_reset(&rx);
+    for (size_t i = 0; i < n; i += chunk)
+    {
+        framer_push_bytes(&rx.fr, &s[i], MIN(chunk, n - i));
+        host_rx_drain(&rx, on_frame, g);
+    }
+}
+
+/* Akış beklenen payload'ları sırayla ve yalnızca onları vermeli */
+static void expect(const char *name, const uint8_t *s, size_t n, const uint8_t *const *p, const uint16_t *pl, uint32_t np)
+{
+    const size_t chunks[] = {n, 1, 7};
+    got_t g;
+
+    for (size_t c = 0; c < ARRAY_SIZE(chunks); c++)
+    {
+        feed(s, n, chunks[c], &g);
+        if (g.n != np)
+        {
+            fprintf(stderr, "%s (chunk %zu): %u frames, expected %u\n", name, chunks[c], g.n, np);
+            exit(1);
+        }
+        for (uint32_t k = 0; k < np; k++)
+            CHECK(g.len[k] == pl[k] && memcmp(g.data[k], p[k], pl[k]) == 0);
+    }
+    printf("%s: ok\n", name);
+}
+
+static size_t put(uint8_t *s, size_t n, const uint8_t *b, size_t bl)
+{
+    memcpy(&s[n], b, bl);
+    return n + bl;
+}
+
+/* Yanlış SYNC'in tükettiği baytlar içinde başlayan gerçek frame kaybolmaz */
+static void test_hidden_frame(void)
+{
+    static const uint8_t a[] = {'h', 'i', 'd', 'd', 'e', 'n'};
+    uint8_t s[128], img[FRAME_MAX_TOTAL];
+    size_t n = 0;
+
+    s[n++] = SYNC_BYTE;
+    s[n++] = 20; /* yanlış aday 20 + 2 bayt tüketir */
+    n = put(s, n, img, build_frame(img, a, sizeof(a)));
+    while (n < 2 + 20 + 2 + 4)
+        s[n++] = 0x11;
+
+    const uint8_t *p[] = {a};
+    const uint16_t pl[] = {sizeof(a)};
+    expect("hidden frame", s, n, p, pl, 1);
+    CHECK(host_stat(&rx, UART_STAT_RX_CRC_ERR) == 1);
+}
+
+/* Pencerede teslim edilen bir frame'den sonra ikinci aday düşerse tarama o
+ * adayın SYNC'inden sürer: teslim edilmiş A'nın payload'ındaki frame görüntüsü
+ * (B) ikinci kez okunup hayalet frame olarak verilmez. */
+static void test_no_rescan_of_delivered(void)
+{
+    static const uint8_t b[] = {0x01, 0x02, 0x03, 0x04};
+    static const uint8_t c[] = {'a', 'f', 't', 'e', 'r'};
+    uint8_t s[160], a[16], img[FRAME_MAX_TOTAL];
+    size_t n = 0, al = 0;
+
+    /* A = [7E, B'nin tam görüntüsü, 7E] */
+    a[al++] = 0x7E;
+    al = put(a, al, img, build_frame(img, b, sizeof(b)));
+    a[al++] = 0x7E;
+
+    s[n++] = SYNC_BYTE;
+    s[n++] = 0x30; /* yanlış aday: 48 + 2 bayt */
+    n = put(s, n, img, build_frame(img, a, (uint16_t)al));
+    CHECK(s[n - 2] != SYNC_BYTE && s[n - 1] != SYNC_BYTE); /* A'nın CRC'si aday açmaz */
+    s[n++] = SYNC_BYTE;
+    s[n++] = 0x00; /* pencere içinde LEN hatası */
+    while (n < 2 + 0x30 + 2)
+        s[n++] = 0x11;
+    n = put(s, n, img, build_frame(img, c, sizeof(c)));
+
+    const uint8_t *p[] = {a, c};
+    const uint16_t pl[] = {(uint16_t)al, sizeof(c)};
+    expect("no rescan of delivered frame", s, n, p, pl, 2);
+    CHECK(host_stat(&rx, UART_STAT_RX_LEN_ERR) == 1);
+    CHECK(host_stat(&rx, UART_STAT_RX_CRC_ERR) == 1);
+}
+
+/* İç içe düşen adaylar: pencere her turda kısalır, sonunda gerçek frame bulunur */
+static void test_nested_failures(void)
+{
+    static const uint8_t a[] = {'n', 'e', 's', 't'};
+    uint8_t s[160], img[FRAME_MAX_TOTAL];
+    size_t n = 0;
+
+    s[n++] = SYNC_BYTE;
+    s[n++] = 0x28;
+    s[n++] = 0x33;
+    s[n++] = SYNC_BYTE;
+    s[n++] = 0x00; /* LEN hatası */
+    s[n++] = SYNC_BYTE;
+    s[n++] = 0x08; /* CRC hatası, gerçek frame'in başını yutar */
+    s[n++] = 0x44;
+    n = put(s, n, img, build_frame(img, a, sizeof(a)));
+    while (n < 2 + 0x28 + 2 + 4)
+        s[n++] = 0x55;
+
+    const uint8_t *p[] = {a};
+    const uint16_t pl[] = {sizeof(a)};
+    expect("nested failures", s, n, p, pl, 1);
+}
+
+int main(void)
+{
+    host_rx_init(&rx, MAX_FRAMES);
+    test_hidden_frame();
+    test_no_rescan_of_delivered();
+    test_nested_failures();
+    host_rx_free(&rx);
+    return 0;
+}
@@ -0,0 +1,166 @@
+/* seg_reasm'de SEG_F_LZ parçaları. Parçalar uart_send_large gibi üretilir:
+ * her parça lz_enc_block'tan geçer, küçülmeyen ham gider. Senaryolar:
+ *  - inorder: sıralı parçalar; transfer bir kez ve birebir tamamlanır
+ *  - ooo: LZ parçası önceki parça gelmeden gelir; geçmişi eksik olduğundan
+ *    reddedilir (reasm_lz_err) ve işaretlenmez, eksik gelince tekrarı kabul edilir
+ *  - trunc: bir bayt kısaltılmış LZ parçası reddedilir, tekrarı kabul edilir */
+
+#include "host_common.h"
+#include "lz.h"
+#include "seg_reasm.h"
+
+#if !IS_ENABLED(CONFIG_CUSTOM_UART_LZ) || !IS_ENABLED(CONFIG_CUSTOM_UART_REASM)
+#error "test_seg_reasm_lz needs CONFIG_CUSTOM_UART_LZ and CONFIG_CUSTOM_UART_REASM"
+#endif
+
+#define TOTAL 700
+#define NSEGS DIV_ROUND_UP(TOTAL, PAYLOAD_MAX)
+
+BUILD_ASSERT(TOTAL <= UART_REASM_MAX_SIZE && NSEGS >= 4, "transfer must fit and span several segments");
+
+static seg_reasm_t ra;
+static reasm_slot_t slots[2];
+static uart_stats_t stats;
+static uint8_t src[TOTAL];
+
+static struct
+{
+    uint8_t n[NSEGS];
+    uint8_t data[NSEGS][UART_MAX_PACKET_SIZE];
+    bool lz[NSEGS];
+} seg;
+
+static struct
+{
+    uint32_t calls;
+    uint8_t xid;
+    uint16_t len;
+    uint8_t buf[TOTAL];
+} done;
+
+static void on_done(uint8_t xid, const uint8_t *buf, uint16_t len)
+{
+    CHECK(len <= TOTAL);
+    done.calls++;
+    done.xid = xid;
+    done.len = len;
+    memcpy(done.buf, buf, len);
+}
+
+static uint32_t stat(uart_stat_id_t id)
+{
+    return (uint32_t)atomic_get(&stats.cnt[id]);
+}
+
+/* Parçalar arası tekrar eden metin: eşleşmeler önceki parçalara uzanır */
+static void build_segments(uint8_t xid)
+{
+    static const char words[][8] = {"uart", "frame", "seg", "lz", "reasm", "crc"};
+    static lz_enc_t enc;
+    uint32_t s = 7;
+
+    for (size_t i = 0; i < TOTAL;)
+    {
+        const char *w = words[host_rand(&s) % ARRAY_SIZE(words)];
+        for (size_t k = 0; w[k] && i < TOTAL; k++)
+            src[i++] = (uint8_t)w[k];
+        if (i < TOTAL)
+            src[i++] = (uint8_t)(' ' + host_rand(&s) % 2u);
+    }
+
+    lz_enc_begin(&enc, src);
+    for (uint16_t k = 0; k < NSEGS; k++)
+    {
+        uint16_t off = (uint16_t)(k * PAYLOAD_MAX);
+        uint16_t chunk = (uint16_t)MIN(PAYLOAD_MAX, (size_t)(TOTAL - off));
+        uint8_t *d = seg.data[k];
+        size_t c = lz_enc_block(&enc, off, chunk, &d[SEG_HDR_SIZE], chunk - 1u);
+
+        seg.lz[k] = c != 0;
+        if (!c)
+        {
+            memcpy(&d[SEG_HDR_SIZE], &src[off], chunk);
+            c = chunk;
+        }
+        seg_hdr_write(d, (uint8_t)(SEG_TYP_DATA | (seg.lz[k] ? SEG_F_LZ : 0)), xid, TOTAL, off, (uint16_t)c);
+        seg.n[k] = (uint8_t)(SEG_HDR_SIZE + c);
+    }
+}
+
+static void push(uint16_t k)
+{
+    CHECK(seg_reasm_push(&ra, seg.data[k], seg.n[k]) == 0);
+}
+
+static void expect_done(uint8_t xid)
+{
+    CHECK(done.calls == 1 && done.xid == xid && done.len == TOTAL);
+    CHECK(memcmp(done.buf, src, TOTAL) == 0);
+    memset(&done, 0, sizeof(done));
+}
+
+static void test_inorder(void)
+{
+    uint32_t nlz = 0;
+
+    build_segments(1);
+    for (uint16_t k = 0; k < NSEGS; k++)
+    {
+        nlz += seg.lz[k];
+        push(k);
+    }
+    expect_done(1);
+    /* İlk parçadan sonrakiler önceki parçalara dayanarak küçülür */
+    CHECK(nlz >= NSEGS - 1 && seg.lz[1] && seg.lz[2]);
+    CHECK(stat(UART_STAT_REASM_DONE) == 1 && stat(UART_STAT_REASM_LZ_ERR) == 0);
+    printf("inorder: ok (%u/%u segments compressed)\n", nlz, (unsigned)NSEGS);
+}
+
+static void test_ooo(void)
+{
+    build_segments(2);
+    push(0);
+    push(2); /* geçmiş buf[0..2 * seg) eksik */
+    CHECK(stat(UART_STAT_REASM_LZ_ERR) == 1 && done.calls == 0);
+    push(1);
+    push(2); /* reddedilen parça işaretlenmemişti: tekrar değil */
+    CHECK(stat(UART_STAT_REASM_DUP) == 0);
+    for (uint16_t k = 3; k < NSEGS; k++)
+        push(k);
+    expect_done(2);
+    CHECK(stat(UART_STAT_REASM_DONE) == 2 && stat(UART_STAT_REASM_LZ_ERR) == 1);
+    printf("ooo: ok\n");
+}
+
+static void test_trunc(void)
+{
+    build_segments(3);
+    for (uint16_t k = 0; k < 3; k++)
+        push(k);
+
+    /* Sıkışık parçanın son baytı düşmüş: clen ve frame boyu yine tutarlı */
+    uint8_t bad[UART_MAX_PACKET_SIZE];
+    uint16_t clen = (uint16_t)(seg.n[3] - SEG_HDR_SIZE - 1u);
+    memcpy(bad, seg.data[3], seg.n[3] - 1u);
+    seg_hdr_write(bad, (uint8_t)(SEG_TYP_DATA | SEG_F_LZ), 3, TOTAL, 3 * PAYLOAD_MAX, clen);
+    CHECK(seg.lz[3] && seg_reasm_push(&ra, bad, SEG_HDR_SIZE + clen) == 0);
+    CHECK(stat(UART_STAT_REASM_LZ_ERR) == 2 && done.calls == 0);
+
+    for (uint16_t k = 3; k < NSEGS; k++)
+        push(k);
+    expect_done(3);
+    CHECK(stat(UART_STAT_REASM_DONE) == 3 && stat(UART_STAT_REASM_DUP) == 0);
+    printf("trunc: ok\n");
+}
+
+int main(void)
+{
+    seg_reasm_init(&ra, slots, ARRAY_SIZE(slots), &stats);
+    seg_reasm_set_cb(&ra, on_done);
+
+    test_inorder();
+    test_ooo();
+    test_trunc();
+    printf("test_seg_reasm_lz: ok\n");
+    return 0;
+}
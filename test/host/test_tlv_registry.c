@@ -0,0 +1,192 @@
+/* tlv_registry.h ve tlv_types.h'nin çok kayıtlı frame yolu:
+ *  - register: tablo dışı id'ler -EINVAL, fn == NULL kaydı siler
+ *  - dispatch: handled/unknown sayaçları, value frame'in içini gösterir
+ *  - truncated: bozuk kuyruk iterasyonu durdurur; önceki kayıtlar teslim edilmiş,
+ *    malformed bir kez sayılmış olmalı
+ *  - append: frame dolunca -ENOSPC, frame->len ve DATA değişmez */
+
+#include "host_common.h"
+#include "tlv_registry.h"
+
+#define MAX_CALLS 16
+
+static tlv_registry_t reg;
+
+static struct
+{
+    uint32_t n;
+    uint8_t id[MAX_CALLS];
+    uint8_t len[MAX_CALLS];
+    const uint8_t *value[MAX_CALLS];
+    void *user[MAX_CALLS];
+} calls;
+
+static void on_tlv(const tlv_view_t *v, void *user)
+{
+    CHECK(calls.n < MAX_CALLS);
+    calls.id[calls.n] = v->id;
+    calls.len[calls.n] = v->len;
+    calls.value[calls.n] = v->value;
+    calls.user[calls.n] = user;
+    calls.n++;
+}
+
+static void reset(void)
+{
+    tlv_registry_init(&reg);
+    memset(&calls, 0, sizeof(calls));
+}
+
+static void expect_stats(uint32_t handled, uint32_t unknown, uint32_t malformed)
+{
+    CHECK(tlv_registry_stat(&reg, TLV_REG_STAT_HANDLED) == handled);
+    CHECK(tlv_registry_stat(&reg, TLV_REG_STAT_UNKNOWN) == unknown);
+    CHECK(tlv_registry_stat(&reg, TLV_REG_STAT_MALFORMED) == malformed);
+}
+
+static void test_register(void)
+{
+    static const uint8_t d[] = {TLV_ID_COUNT - 1, 0};
+    int tag;
+
+    reset();
+    CHECK(tlv_registry_set(&reg, TLV_ID_COUNT, on_tlv, NULL) == -EINVAL);
+    CHECK(tlv_registry_set(&reg, (tlv_id_t)0xFF, on_tlv, NULL) == -EINVAL);
+    CHECK(tlv_registry_set(NULL, TLV_ID_LED, on_tlv, NULL) == -EINVAL);
+
+    /* Son id tabloda; kayıt user'ıyla çağrılır, silinince bilinmez olur */
+    CHECK(tlv_registry_set(&reg, (tlv_id_t)(TLV_ID_COUNT - 1), on_tlv, &tag) == 0);
+    CHECK(tlv_registry_dispatch(&reg, d, sizeof(d)) == 0);
+    CHECK(calls.n == 1 && calls.id[0] == TLV_ID_COUNT - 1 && calls.len[0] == 0 && calls.user[0] == &tag);
+    CHECK(tlv_registry_set(&reg, (tlv_id_t)(TLV_ID_COUNT - 1), NULL, NULL) == 0);
+    CHECK(tlv_registry_dispatch(&reg, d, sizeof(d)) == -ENOENT);
+    CHECK(calls.n == 1);
+    expect_stats(1, 1, 0);
+    printf("register: ok\n");
+}
+
+static void test_dispatch(void)
+{
+    /* LED, tablo dışı id, handler'sız BUZZER, VERSION */
+    static const uint8_t d[] = {
+        TLV_ID_LED,     2, 0x11, 0x22,
+        0xF0,           1, 0x33,
+        TLV_ID_BUZZER,  0,
+        TLV_ID_VERSION, 3, TLV_VERSION_MAJOR, TLV_VERSION_MINOR, 0x44,
+    };
+
+    reset();
+    CHECK(tlv_registry_set(&reg, TLV_ID_LED, on_tlv, NULL) == 0);
+    CHECK(tlv_registry_set(&reg, TLV_ID_VERSION, on_tlv, NULL) == 0);
+    CHECK(tlv_registry_dispatch(&reg, d, sizeof(d)) == -ENOENT);
+
+    /* Kopyasız: value frame DATA'sının içini gösterir */
+    CHECK(calls.n == 2);
+    CHECK(calls.id[0] == TLV_ID_LED && calls.len[0] == 2 && calls.value[0] == &d[2]);
+    CHECK(calls.id[1] == TLV_ID_VERSION && calls.len[1] == 3 && calls.value[1] == &d[11]);
+    expect_stats(2, 2, 0);
+
+    /* Boş frame: kayıt yok, hata yok */
+    CHECK(tlv_registry_dispatch(&reg, d, 0) == 0);
+    expect_stats(2, 2, 0);
+    printf("dispatch: ok\n");
+}
+
+static void test_truncated(void)
+{
+    /* İki geçerli kayıt + bozuk kuyruk: kısa value, tek baytlık başlık, aşırı LEN */
+    uint8_t d[8 + TLV_MAX_VALUE_SIZE] = {TLV_ID_LED, 1, 0x01, TLV_ID_VERSION, 0};
+    const struct
+    {
+        uint8_t tail[3];
+        size_t n;
+        int err;
+    } cases[] = {
+        {{TLV_ID_LED, 5, 0xAA}, 3, -EOVERFLOW},
+        {{TLV_ID_LED}, 1, -EBADMSG},
+        {{TLV_ID_LED, TLV_MAX_VALUE_SIZE + 1}, 2, -EMSGSIZE},
+    };
+
+    for (size_t c = 0; c < ARRAY_SIZE(cases); c++)
+    {
+        reset();
+        CHECK(tlv_registry_set(&reg, TLV_ID_LED, on_tlv, NULL) == 0);
+        CHECK(tlv_registry_set(&reg, TLV_ID_VERSION, on_tlv, NULL) == 0);
+        memcpy(&d[5], cases[c].tail, cases[c].n);
+        CHECK(tlv_registry_dispatch(&reg, d, 5 + cases[c].n) == cases[c].err);
+        CHECK(calls.n == 2 && calls.id[0] == TLV_ID_LED && calls.id[1] == TLV_ID_VERSION);
+        expect_stats(2, 0, 1);
+
+        /* İterasyon bozuk kayıtta durur ve sonra 0 döner */
+        tlv_iter_t it;
+        tlv_view_t v;
+        tlv_iter_init(&it, d, 5 + cases[c].n);
+        CHECK(tlv_iter_next(&it, &v) == 1 && tlv_iter_next(&it, &v) == 1);
+        CHECK(tlv_iter_next(&it, &v) == cases[c].err);
+        CHECK(tlv_iter_next(&it, &v) == 0);
+    }
+    printf("truncated: ok\n");
+}
+
+static void test_append(void)
+{
+    static uart_frame_t f, before;
+    uint8_t value[TLV_MAX_VALUE_SIZE + 1];
+    uint32_t n = 0;
+
+    for (size_t i = 0; i < sizeof(value); i++)
+        value[i] = (uint8_t)i;
+    f.len = 0;
+    CHECK(tlv_append(&f, TLV_ID_LED, NULL, 1) == -EINVAL);
+    CHECK(tlv_append(NULL, TLV_ID_LED, value, 1) == -EINVAL);
+    CHECK(tlv_append(&f, TLV_ID_LED, value, TLV_MAX_VALUE_SIZE + 1) == -EMSGSIZE);
+    CHECK(f.len == 0);
+
+    /* 3 baytlık kayıtlarla doldur; kalan yer bir kayda yetmeyince -ENOSPC */
+    while (f.len + 3u <= sizeof(f.data))
+    {
+        CHECK(tlv_append(&f, (uint8_t)(n % TLV_ID_COUNT), &value[n % 8u], 1) == 0);
+        n++;
+    }
+    before = f;
+    CHECK(tlv_append(&f, TLV_ID_LED, value, 1) == -ENOSPC);
+    CHECK(f.len == before.len && memcmp(&f, &before, sizeof(f)) == 0);
+
+    /* Eklenen kayıtlar sırayla ve birebir geri okunur */
+    tlv_iter_t it;
+    tlv_view_t v;
+    uint32_t k = 0;
+    tlv_iter_init(&it, f.data, f.len);
+    while (tlv_iter_next(&it, &v) == 1)
+    {
+        CHECK(k < n && v.id == k % TLV_ID_COUNT && v.len == 1 && v.value == &f.data[3u * k + 2u]);
+        CHECK(v.value[0] == value[k % 8u]);
+        k++;
+    }
+    CHECK(k == n);
+
+    /* Tam dolum: en büyük value frame'i tam doldurur, boş kayıt bile sığmaz */
+    f.len = 0;
+    CHECK(tlv_append(&f, TLV_ID_MEASUREMENT, value, TLV_MAX_VALUE_SIZE) == 0);
+    CHECK(f.len == 2u + TLV_MAX_VALUE_SIZE && f.len <= sizeof(f.data));
+    if (f.len + 2u <= sizeof(f.data))
+    {
+        /* Jumbo frame'de yer kalır: kalan baytlar boş kayıtlarla dolar */
+        while (f.len + 2u <= sizeof(f.data))
+            CHECK(tlv_append(&f, TLV_ID_BUZZER, NULL, 0) == 0);
+    }
+    before = f;
+    CHECK(tlv_append(&f, TLV_ID_BUZZER, NULL, 0) == -ENOSPC);
+    CHECK(memcmp(&f, &before, sizeof(f)) == 0);
+    printf("append: ok (%u records, %zu byte frame)\n", n, sizeof(f.data));
+}
+
+int main(void)
+{
+    test_register();
+    test_dispatch();
+    test_truncated();
+    test_append();
+    printf("test_tlv_registry: ok\n");
+    return 0;
+}
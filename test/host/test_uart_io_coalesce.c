@@ -0,0 +1,170 @@
+/* CONFIG_CUSTOM_UART_TX_COALESCE, zsim üzerinde: tek frame'in pencere kadar
+ * bekletilmesi, art arda frame'lerin tek uart_tx ile gitmesi, bütçe dolunca
+ * beklemeden gönderim ve aynı transferdeki birden çok frame'in timeout'ta
+ * iptali (batch beklemesi takılmadan -ETIMEDOUT döner). */
+
+#include "uart_io_test.h"
+
+#if !IS_ENABLED(CONFIG_CUSTOM_UART_TX_COALESCE)
+#error "test_uart_io_coalesce needs CONFIG_CUSTOM_UART_TX_COALESCE"
+#endif
+
+#define MAX_FRAMES 8
+
+static uart_io_ctx_t *io;
+static uint8_t payload[UART_FRAME_LEN_MAX * 2];
+
+typedef struct
+{
+    uint32_t n;
+    int64_t at[MAX_FRAMES]; /* tamamlanma zamanı */
+} sent_t;
+
+typedef struct
+{
+    uint32_t n;
+    uint16_t len[MAX_FRAMES];
+} got_t;
+
+typedef struct
+{
+    const sent_t *s;
+    uint32_t want;
+} want_t;
+
+static void on_sent(int result, void *user)
+{
+    sent_t *s = user;
+
+    CHECK(result == 0 && s->n < MAX_FRAMES);
+    s->at[s->n++] = zsim_now_ns();
+}
+
+static bool sent_all(void *arg)
+{
+    want_t *w = arg;
+    return w->s->n == w->want;
+}
+
+static void wait_sent(const sent_t *s, uint32_t n)
+{
+    want_t w = {.s = s, .want = n};
+    CHECK(zsim_wait(sent_all, &w, K_SECONDS(1)));
+}
+
+static void on_frame(const uart_frame_t *f, void *user)
+{
+    got_t *g = user;
+
+    CHECK(g->n < MAX_FRAMES);
+    CHECK(memcmp(f->data, payload, f->len) == 0);
+    g->len[g->n++] = f->len;
+}
+
+static void send_n(sent_t *s, uint32_t n, uint16_t len)
+{
+    for (uint32_t i = 0; i < n; i++)
+        CHECK(uart_io_ctx_send_frame_async(io, payload, len, on_sent, s, K_NO_WAIT) == 0);
+}
+
+static void expect_wire(uint32_t n, uint16_t len)
+{
+    got_t g = {0};
+
+    CHECK(io_wire_frames(on_frame, &g) == n);
+    for (uint32_t i = 0; i < n; i++)
+        CHECK(g.len[i] == len);
+}
+
+static int64_t wire_ns(uint32_t n, uint16_t len)
+{
+    return (int64_t)n * (len + FRAME_OVERHEAD_BYTES) * zsim_uart_char_ns();
+}
+
+static void test_lone_frame(void)
+{
+    sent_t s = {0};
+    uint32_t xfers = io_stat(io, UART_STAT_TX_XFERS);
+
+    /* Hat boş: tek frame pencere kadar tutulur, sonra tek başına gider */
+    int64_t t0 = zsim_now_ns();
+    send_n(&s, 1, 10);
+    wait_sent(&s, 1);
+    CHECK(s.at[0] - t0 == UART_TX_COALESCE_WINDOW_US * 1000 + wire_ns(1, 10));
+    CHECK(io_stat(io, UART_STAT_TX_XFERS) == xfers + 1);
+    expect_wire(1, 10);
+    printf("lone frame: ok\n");
+}
+
+static void test_burst(void)
+{
+    sent_t s = {0};
+    uint32_t xfers = io_stat(io, UART_STAT_TX_XFERS);
+    uint32_t frames = io_stat(io, UART_STAT_TX_FRAMES);
+
+    /* Pencere içindeki frame'ler tek transferde, hepsi aynı TX_DONE'da biter */
+    int64_t t0 = zsim_now_ns();
+    send_n(&s, 4, 8);
+    wait_sent(&s, 4);
+    for (int i = 0; i < 4; i++)
+        CHECK(s.at[i] - t0 == UART_TX_COALESCE_WINDOW_US * 1000 + wire_ns(4, 8));
+    CHECK(io_stat(io, UART_STAT_TX_XFERS) == xfers + 1);
+    CHECK(io_stat(io, UART_STAT_TX_FRAMES) == frames + 4);
+    CHECK(io_stat(io, UART_STAT_TX_MAX_BATCH) >= 4);
+    expect_wire(4, 8);
+    printf("burst: ok\n");
+}
+
+static void test_budget(void)
+{
+    sent_t s = {0};
+    uint16_t len = UART_TX_COALESCE_BYTES / 4 - FRAME_OVERHEAD_BYTES;
+
+    BUILD_ASSERT(UART_TX_COALESCE_BYTES / 4 - FRAME_OVERHEAD_BYTES <= UART_MAX_PACKET_SIZE, "frame too long");
+
+    /* Bütçe dolunca pencere beklenmez */
+    int64_t t0 = zsim_now_ns();
+    send_n(&s, 4, len);
+    wait_sent(&s, 4);
+    CHECK(s.at[3] - t0 == wire_ns(4, len));
+    expect_wire(4, len);
+    printf("budget: ok\n");
+}
+
+static void test_timeout_coalesced(void)
+{
+    uint32_t timeouts = io_stat(io, UART_STAT_TX_TIMEOUTS);
+    sent_t s = {0};
+
+    /* İki parça aynı transferde DMA'da takılır; timeout ikisini de ayırır.
+     * Batch yalnız birini sayarsa kalan için K_FOREVER bekler (zsim: deadlock). */
+    zsim_uart_tx_stuck(true);
+    CHECK(uart_io_ctx_send_buffer(io, payload, UART_FRAME_LEN_MAX + 10, K_MSEC(10)) == -ETIMEDOUT);
+    CHECK(zsim_uart_stats()->tx_calls > 0 && zsim_uart_stats()->tx_aborts == 1);
+    CHECK(io_stat(io, UART_STAT_TX_TIMEOUTS) == timeouts + 1);
+    zsim_uart_tx_stuck(false);
+    zsim_uart_wire_clear();
+
+    /* Kuyruk ve slot havuzu boş: derinlik kadar frame yine girer */
+    send_n(&s, UART_TX_QUEUE_DEPTH, 8);
+    wait_sent(&s, UART_TX_QUEUE_DEPTH);
+    expect_wire(UART_TX_QUEUE_DEPTH, 8);
+    printf("timeout with coalesced frames in flight: ok\n");
+}
+
+int main(void)
+{
+    for (size_t i = 0; i < sizeof(payload); i++)
+        payload[i] = (uint8_t)(i * 13u + 1u);
+
+    CHECK(uart_io_init() == 0);
+    io = uart_io_ctx_get(0);
+    CHECK(io);
+
+    test_lone_frame();
+    test_burst();
+    test_budget();
+    test_timeout_coalesced();
+    printf("test_uart_io_coalesce: ok\n");
+    return 0;
+}
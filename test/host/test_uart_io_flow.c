@@ -0,0 +1,171 @@
+/* CONFIG_CUSTOM_UART_FLOW_CTRL, zsim üzerinde. rx callback'i uyurken karşıdan
+ * frame gelmeye devam eder: frame kuyruğu yüksek eşiğe varınca PAUSE, callback
+ * yetişip kuyruk boşalınca RESUME. In-band yapıda durum kabloda SEG_TYP_FLOW
+ * frame'idir, ZSIM_DT_HW_FLOW_CONTROL=1 yapısında RTS.
+ *
+ * Gönderim flow kilidi dışında olmalı: zsim, uart_tx veya uart_line_ctrl_set
+ * spinlock altında çağrılırsa durur. Gönderilemeyen durum (dolu TX kuyruğu,
+ * RTS hatası) FLOW_TX_ERR sayılır ve sonraki güncellemede son durumla tekrar
+ * denenir. */
+
+#include <zephyr/devicetree.h>
+
+#include "uart_io_test.h"
+
+#if !IS_ENABLED(CONFIG_CUSTOM_UART_FLOW_CTRL)
+#error "test_uart_io_flow needs CONFIG_CUSTOM_UART_FLOW_CTRL"
+#endif
+
+#if ZSIM_DT_HW_FLOW_CONTROL && defined(CONFIG_UART_LINE_CTRL)
+#define FLOW_RTS 1
+#else
+#define FLOW_RTS 0
+#endif
+#define NFRAMES  UART_MSGQ_DEPTH /* biri callback'te, gerisi kuyrukta: düşen yok */
+#define CB_SLEEP_MS 20
+#define MAX_FLOW 8
+
+BUILD_ASSERT(NFRAMES - 1 >= (UART_MSGQ_DEPTH * UART_FLOW_Q_HIGH_PCT + 99) / 100,
+             "queued frames must reach the high watermark");
+BUILD_ASSERT((NFRAMES - 1) * CB_SLEEP_MS < UART_FLOW_REFRESH_MS, "no PAUSE refresh expected");
+
+static uart_io_ctx_t *io;
+
+static struct
+{
+    uint32_t got;
+    uint8_t seq[NFRAMES * 3];
+    uint32_t rts_paused; /* callback sırasında RTS düşük görüldü */
+} rx;
+
+typedef struct
+{
+    uint32_t n, data;
+    uint8_t st[MAX_FLOW];
+} flow_seen_t;
+
+static void on_rx(uart_frame_t *f)
+{
+    CHECK(f->len == 20 && rx.got < ARRAY_SIZE(rx.seq));
+    rx.seq[rx.got++] = f->data[0];
+    if (FLOW_RTS && zsim_uart_rts() == 0)
+        rx.rts_paused++;
+    k_msleep(CB_SLEEP_MS);
+}
+
+static bool rx_done(void *arg)
+{
+    return rx.got == *(uint32_t *)arg;
+}
+
+/* Karşı taraf NFRAMES frame'i art arda yollar; callback'ler bitene kadar koş */
+static void peer_burst(uint8_t first)
+{
+    uint8_t p[20], f[FRAME_MAX_TOTAL];
+    uint32_t want = rx.got + NFRAMES;
+
+    for (uint32_t i = 0; i < NFRAMES; i++)
+    {
+        memset(p, first + i, sizeof(p));
+        zsim_uart_feed(f, build_frame(f, p, sizeof(p)));
+    }
+    CHECK(zsim_wait(rx_done, &want, K_SECONDS(1)));
+    for (uint32_t i = 0; i < NFRAMES; i++)
+        CHECK(rx.seq[want - NFRAMES + i] == (uint8_t)(first + i));
+}
+
+static void on_wire_frame(const uart_frame_t *f, void *user)
+{
+    flow_seen_t *s = user;
+    uint8_t typ, xid;
+    uint16_t total, off, clen;
+
+    if (f->len != SEG_HDR_SIZE + 1)
+    {
+        s->data++;
+        return;
+    }
+    seg_hdr_read(f->data, &typ, &xid, &total, &off, &clen);
+    CHECK(typ == SEG_TYP_FLOW && clen == 1 && s->n < MAX_FLOW);
+    s->st[s->n++] = f->data[SEG_HDR_SIZE];
+}
+
+static flow_seen_t wire_flow(void)
+{
+    flow_seen_t s = {0};
+    CHECK(zsim_wait(NULL, NULL, K_MSEC(5)) == false); /* son frame kabloya çıksın */
+    io_wire_frames(on_wire_frame, &s);
+    return s;
+}
+
+static void test_pause_resume(void)
+{
+    uint32_t pauses = io_stat(io, UART_STAT_FLOW_PAUSE);
+    uint32_t errs = io_stat(io, UART_STAT_FLOW_TX_ERR);
+
+    peer_burst(0x10);
+    CHECK(io_stat(io, UART_STAT_FLOW_PAUSE) == pauses + 1);
+    CHECK(io_stat(io, UART_STAT_FLOW_TX_ERR) == errs);
+#if FLOW_RTS
+    CHECK(rx.rts_paused > 0 && zsim_uart_rts() == 1);
+    CHECK(wire_flow().n == 0);
+#else
+    flow_seen_t s = wire_flow();
+    CHECK(s.n == 2 && s.data == 0 && s.st[0] == SEG_FLOW_PAUSE && s.st[1] == SEG_FLOW_RESUME);
+#endif
+    printf("pause/resume: ok\n");
+}
+
+static void test_send_error(void)
+{
+    uint32_t errs = io_stat(io, UART_STAT_FLOW_TX_ERR);
+
+    /* Bütün dönem boyunca gönderim başarısız: durum bekler */
+#if FLOW_RTS
+    zsim_uart_set_line_ctrl_rc(-EIO);
+#else
+    uint8_t p[4] = {0};
+    zsim_uart_tx_stuck(true);
+    for (int i = 0; i < UART_TX_QUEUE_DEPTH; i++)
+        CHECK(uart_io_ctx_send_frame_async(io, p, sizeof(p), NULL, NULL, K_NO_WAIT) == 0);
+#endif
+    rx.rts_paused = 0;
+    peer_burst(0x20);
+    CHECK(io_stat(io, UART_STAT_FLOW_TX_ERR) > errs);
+
+    /* Engel kalkınca ilk güncelleme bekleyen son durumu (RESUME) yollar,
+     * ardından yeni dönem normal işler */
+#if FLOW_RTS
+    CHECK(rx.rts_paused == 0 && zsim_uart_rts() == 1);
+    zsim_uart_set_line_ctrl_rc(0);
+#else
+    CHECK(wire_flow().n == 0);
+    zsim_uart_tx_stuck(false);
+    CHECK(zsim_wait(NULL, NULL, K_MSEC(10)) == false);
+#endif
+    errs = io_stat(io, UART_STAT_FLOW_TX_ERR);
+    peer_burst(0x30);
+    CHECK(io_stat(io, UART_STAT_FLOW_TX_ERR) == errs);
+#if FLOW_RTS
+    CHECK(zsim_uart_rts() == 1 && rx.rts_paused > 0);
+#else
+    flow_seen_t s = wire_flow();
+    CHECK(s.data == UART_TX_QUEUE_DEPTH && s.n == 3);
+    CHECK(s.st[0] == SEG_FLOW_RESUME && s.st[1] == SEG_FLOW_PAUSE && s.st[2] == SEG_FLOW_RESUME);
+#endif
+    printf("send error retried: ok\n");
+}
+
+int main(void)
+{
+    CHECK(uart_io_init() == 0);
+    io = uart_io_ctx_get(0);
+    CHECK(io);
+    uart_io_ctx_register_rx_cb(io, on_rx);
+    zsim_uart_wire_clear();
+
+    test_pause_resume();
+    test_send_error();
+    printf("test_uart_io_flow%s: ok\n", FLOW_RTS ? " (rts)" : "");
+    return 0;
+}
@@ -0,0 +1,304 @@
+/* RX taşma politikaları (drop-newest, drop-oldest, priority), zsim üzerinde.
+ * Aynı test üç yapılandırmayla derlenir; beklenen sonuç politikanın modelinden
+ * hesaplanır:
+ *  - burst: kayıt oynatılırken drain birkaç DMA buffer'ı boyunca çalışmaz ve
+ *    halka taşar. drop-newest halkadakileri tutar, sonrakiler kesinti kapanana
+ *    kadar düşer (rx_ovf_gaps); drop-oldest yeni baytlara en eski bütün
+ *    frame'leri atarak yer açar (rx_ovf_evict). İki durumda da kesintiye değen
+ *    yarım frame rx_ovf_cut'ta sayılır, CRC hatası olmaz. Jumbo açıksa akışta
+ *    jumbo frame'ler de vardır: tahliye onların SYNC'inde de durur, bir klasik
+ *    frame'den uzun taramada ise frame'i keser.
+ *  - slow: ilk callback uzun uyur ve bloğunu tutar; havuz dolar (rx_pool_empty).
+ *    priority'de düşük öncelikli frame'ler son RX_PRIO_RESERVE bloğu alamaz
+ *    (rx_prio_drop). Callback dönünce yeni frame'lerin hepsi gelmeli. */
+
+#include "uart_io_test.h"
+
+#define CH UART_RX_CHUNK_LEN
+#define RB UART_RB_SZ
+#define PLEN 40
+#define FLEN (PLEN + FRAME_OVERHEAD_BYTES)
+#define BURST_BUFS 14
+#define HOLD_END 8 /* buffer 2..7 drain'siz gelir */
+#define BURST_FRAMES (BURST_BUFS * CH / FLEN) /* burst id'leri için üst sınır */
+#define SLOW_FRAMES 40
+#define TAIL_FRAMES 10
+#define NFRAMES (BURST_FRAMES + SLOW_FRAMES + TAIL_FRAMES)
+#if IS_ENABLED(CONFIG_CUSTOM_UART_JUMBO)
+#define PLEN_JUMBO (UART_MAX_PACKET_SIZE + 190)
+#define WIRE_MAX (PLEN_JUMBO + FRAME_JUMBO_OVERHEAD_BYTES)
+BUILD_ASSERT(PLEN_JUMBO <= UART_FRAME_LEN_MAX && WIRE_MAX < UART_RB_SZ, "jumbo frames must fit the ring");
+#else
+#define WIRE_MAX FLEN
+#endif
+#define ID_HIGH 0x04
+#define ID_LOW 0x10
+#define CB_SLEEP_MS 1000
+
+BUILD_ASSERT(!IS_ENABLED(CONFIG_CUSTOM_UART_COBS), "frames use SYNC + LEN");
+BUILD_ASSERT(ID_HIGH < UART_RX_PRIO_LOW_ID_MIN && ID_LOW >= UART_RX_PRIO_LOW_ID_MIN &&
+                 ID_HIGH != SEG_TYP_DATA && ID_LOW != UART_STATS_TLV_ID,
+             "priority bytes must not be routed elsewhere");
+/* Drain'siz buffer'lar halkayı taşırır; drop-oldest'in son tahliyesi halkanın
+ * sarma noktasına denk gelir (varsayılan boyutlarda frame ortası) */
+BUILD_ASSERT((HOLD_END - 2) * CH > RB && RB - CH > FLEN, "burst must overflow the ring");
+/* Yavaş tüketicide havuz SLOW_FRAMES içinde dolar */
+BUILD_ASSERT(UART_MSGQ_DEPTH < SLOW_FRAMES / 2, "pool must run dry during the slow phase");
+
+static uart_io_ctx_t *io;
+static bool sleep_next;
+static uint16_t nburst;
+
+static struct
+{
+    uint32_t n;
+    uint16_t id[NFRAMES];
+} got;
+
+static struct
+{
+    uint8_t buf[BURST_BUFS * CH];
+    size_t start[NFRAMES];
+    uint16_t plen[NFRAMES], flen[NFRAMES];
+    uint8_t wire[NFRAMES][WIRE_MAX];
+} st;
+
+static bool is_high(uint16_t id)
+{
+    /* Burst'te hepsi yüksek öncelikli: priority orada drop-newest gibi davranır */
+    return id < BURST_FRAMES || (id - BURST_FRAMES) % 3 == 0;
+}
+
+static bool is_sync(uint8_t b)
+{
+    return b == SYNC_BYTE || (IS_ENABLED(CONFIG_CUSTOM_UART_JUMBO) && b == SYNC_BYTE_JUMBO);
+}
+
+/* Payload: öncelik baytı, id (BE), id'ye bağlı baytlar; SYNC yalnız frame başında.
+ * Jumbo'da burst'teki her dördüncü frame jumbo */
+static void frame_build(uint16_t id)
+{
+    uint8_t p[WIRE_MAX];
+    uint16_t l = PLEN;
+
+#if IS_ENABLED(CONFIG_CUSTOM_UART_JUMBO)
+    if (id < BURST_FRAMES && id % 4 == 1)
+        l = PLEN_JUMBO;
+#endif
+    p[0] = is_high(id) ? ID_HIGH : ID_LOW;
+    sys_put_be16(id, &p[1]);
+    for (uint16_t j = 3; j < l; j++)
+        p[j] = (uint8_t)((id * 11u + j * 5u) & 0x7F);
+    st.plen[id] = l;
+    for (;;)
+    {
+        uint16_t n = (uint16_t)build_frame(st.wire[id], p, l);
+        st.flen[id] = n;
+        if (!is_sync(st.wire[id][n - 2]) && !is_sync(st.wire[id][n - 1]))
+            break;
+        p[l - 1] = (uint8_t)((p[l - 1] + 1u) & 0x7F);
+    }
+}
+
+static void on_rx(uart_frame_t *f)
+{
+    CHECK(got.n < NFRAMES && f->len >= PLEN);
+    uint16_t id = sys_get_be16(&f->data[1]);
+    CHECK(id < NFRAMES && f->len == st.plen[id]);
+    CHECK(memcmp(f->data, &st.wire[id][st.flen[id] - 2 - f->len], f->len) == 0);
+    got.id[got.n++] = id;
+
+    if (sleep_next)
+    {
+        sleep_next = false;
+        k_msleep(CB_SLEEP_MS); /* blok callback'te, kuyruktakiler bekler */
+    }
+}
+
+/* framer q_admit: boş blok sayısı akıştaki frame'in bloğu hariç */
+static bool admit(uint16_t id, uint32_t free_blk)
+{
+#if IS_ENABLED(CONFIG_CUSTOM_UART_RX_OVF_PRIORITY)
+    return is_high(id) || free_blk >= UART_RX_PRIO_RESERVE;
+#else
+    ARG_UNUSED(id);
+    ARG_UNUSED(free_blk);
+    return true;
+#endif
+}
+
+static bool got_n(void *arg)
+{
+    return got.n >= *(uint32_t *)arg;
+}
+
+static void expect_ids(const uint16_t *want, uint32_t n)
+{
+    CHECK(got.n == n);
+    for (uint32_t k = 0; k < n; k++)
+        CHECK(got.id[k] == want[k]);
+}
+
+/* Kesinti noktası bir frame'in ortasındaysa framer onu rx_ovf_cut'ta sayar */
+static uint32_t mid_frame(size_t pos)
+{
+    for (uint16_t i = 0; i < nburst; i++)
+        if (st.start[i] < pos && pos < st.start[i] + st.flen[i])
+            return 1;
+    return 0;
+}
+
+static const zsim_rx_rec_t REC_BUF[] = {
+    {ZSIM_RX_RDY, 0, CH},
+    {.op = ZSIM_RX_NEXT},
+    {.op = ZSIM_RX_RELEASE},
+    {.op = ZSIM_RX_REQUEST},
+    {.op = ZSIM_RX_GAP, .len = 2000},
+};
+
+/* Buffer 0 ve 1'den sonra drain çalışır, 2..HOLD_END - 1 arka arkaya gelir */
+static void test_burst(void)
+{
+    size_t pos = 0;
+
+    for (nburst = 0; nburst < BURST_FRAMES && pos + st.flen[nburst] <= sizeof(st.buf); nburst++)
+    {
+        st.start[nburst] = pos;
+        memcpy(&st.buf[pos], st.wire[nburst], st.flen[nburst]);
+        pos += st.flen[nburst];
+    }
+    memset(&st.buf[pos], 0, sizeof(st.buf) - pos); /* SYNC'siz dolgu */
+
+    for (size_t b = 0; b < BURST_BUFS; b++)
+    {
+        bool gap = b < 2 || b >= HOLD_END - 1;
+        CHECK(zsim_uart_rx_replay(REC_BUF, gap ? ARRAY_SIZE(REC_BUF) : ARRAY_SIZE(REC_BUF) - 1, &st.buf[b * CH]) == CH);
+    }
+    CHECK(zsim_wait(NULL, NULL, K_MSEC(50)) == false);
+
+    /* Halkaya ulaşan akış: [0, lo) ve [hi, sonu); aradaki kesinti lo'da */
+    size_t lo, hi;
+    uint32_t evict = 0;
+#if IS_ENABLED(CONFIG_CUSTOM_UART_RX_OVF_DROP_OLDEST)
+    /* Okuma başı (h) 2 * CH'de; her yazmada yer yoksa h yer açılana kadar
+     * sonraki frame başlarına atlar. Tarama bir klasik frame'i geçerse
+     * h bütçenin sonunda, frame ortasında kalır. */
+    size_t h = 2 * CH;
+    for (size_t t = 2 * CH; t < HOLD_END * CH; t += CH)
+    {
+        if ((t - h) + CH <= RB)
+            continue;
+        size_t end = MIN(h + CH + FRAME_OVERHEAD_BYTES + UART_MAX_PACKET_SIZE, t), h0 = h;
+        h = end;
+        for (uint16_t i = 0; i < nburst && st.start[i] < end; i++)
+        {
+            if (st.start[i] <= h0)
+                continue;
+            evict++;
+            if ((t - st.start[i]) + CH <= RB)
+            {
+                h = st.start[i];
+                break;
+            }
+        }
+        CHECK((t - h) + CH <= RB);
+    }
+    lo = 2 * CH;
+    hi = h;
+    CHECK(io_stat(io, UART_STAT_RX_OVF_GAPS) == 0);
+#else
+    lo = 2 * CH + RB;
+    hi = HOLD_END * CH;
+    CHECK(io_stat(io, UART_STAT_RX_OVF_GAPS) == 1);
+#endif
+    uint16_t want[BURST_FRAMES];
+    uint32_t n = 0;
+    for (uint16_t i = 0; i < nburst; i++)
+        if (st.start[i] + st.flen[i] <= lo || st.start[i] >= hi)
+            want[n++] = i;
+    expect_ids(want, n);
+
+    CHECK(n < nburst && got.id[n - 1] == nburst - 1);
+    CHECK(io_stat(io, UART_STAT_RX_DROP_BYTES) == hi - lo);
+    CHECK(io_stat(io, UART_STAT_RX_OVF_EVICT) == evict);
+    CHECK(io_stat(io, UART_STAT_RX_OVF_CUT) == mid_frame(lo));
+    CHECK(io_stat(io, UART_STAT_RX_CRC_ERR) == 0 && io_stat(io, UART_STAT_RX_LEN_ERR) == 0);
+    CHECK(io_stat(io, UART_STAT_RX_FRAMES) == n);
+    printf("burst: ok (%u/%u frames, %zu bytes dropped, %u evicted)\n", n, nburst, hi - lo, evict);
+}
+
+/* Havuz modeli: akıştaki frame LEN'de blok alır (prio reddinden kalan blok
+ * yeniden kullanılır), CRC'de admit() kabul ederse teslim edilir. Teslim
+ * edilenlerin hiçbiri callback uyurken bırakılmaz. */
+static void test_slow(void)
+{
+    uint32_t base = got.n, drop0 = io_stat(io, UART_STAT_RX_DROP_BYTES);
+    uint32_t free_blk = UART_MSGQ_DEPTH, pool_empty = 0, prio_drop = 0, n = 0;
+    uint16_t want[SLOW_FRAMES];
+    bool spare = false;
+
+    for (uint16_t i = BURST_FRAMES; i < BURST_FRAMES + SLOW_FRAMES; i++)
+    {
+        if (!spare)
+        {
+            if (free_blk == 0)
+            {
+                pool_empty++;
+                continue;
+            }
+            free_blk--;
+        }
+        spare = !admit(i, free_blk);
+        if (spare)
+            prio_drop++;
+        else
+            want[n++] = i;
+    }
+    CHECK(pool_empty > 0 && IS_ENABLED(CONFIG_CUSTOM_UART_RX_OVF_PRIORITY) == (prio_drop > 0));
+
+    sleep_next = true;
+    for (uint16_t i = BURST_FRAMES; i < BURST_FRAMES + SLOW_FRAMES; i++)
+        zsim_uart_feed(st.wire[i], st.flen[i]);
+    uint32_t want_n = base + n;
+    CHECK(zsim_wait(got_n, &want_n, K_MSEC(CB_SLEEP_MS * 2)));
+    CHECK(zsim_wait(NULL, NULL, K_MSEC(50)) == false);
+    CHECK(got.n == want_n);
+    for (uint32_t k = 0; k < n; k++)
+        CHECK(got.id[base + k] == want[k]);
+    CHECK(io_stat(io, UART_STAT_RX_POOL_EMPTY) == pool_empty);
+    CHECK(io_stat(io, UART_STAT_RX_PRIO_DROP) == prio_drop);
+    CHECK(io_stat(io, UART_STAT_RX_Q_FULL) == 0 && io_stat(io, UART_STAT_RX_CRC_ERR) == 0);
+    CHECK(io_stat(io, UART_STAT_RX_DROP_BYTES) == drop0);
+
+    /* Havuz geri geldi: sonraki frame'lerin hepsi teslim edilir */
+    base = got.n;
+    for (uint16_t i = BURST_FRAMES + SLOW_FRAMES; i < NFRAMES; i++)
+        zsim_uart_feed(st.wire[i], st.flen[i]);
+    CHECK(zsim_wait(NULL, NULL, K_MSEC(200)) == false);
+    CHECK(got.n == base + TAIL_FRAMES);
+    for (uint16_t k = 0; k < TAIL_FRAMES; k++)
+        CHECK(got.id[base + k] == BURST_FRAMES + SLOW_FRAMES + k);
+    CHECK(io_stat(io, UART_STAT_RX_POOL_EMPTY) == pool_empty && io_stat(io, UART_STAT_RX_PRIO_DROP) == prio_drop);
+    printf("slow: ok (%u/%u frames, pool_empty %u, prio_drop %u)\n", n, SLOW_FRAMES, pool_empty, prio_drop);
+}
+
+int main(void)
+{
+    CHECK(uart_io_init() == 0);
+    io = uart_io_ctx_get(0);
+    CHECK(io);
+    uart_io_ctx_register_rx_cb(io, on_rx);
+    for (uint16_t i = 0; i < NFRAMES; i++)
+        frame_build(i);
+    /* Yavaş fazın bütün baytları callback uyurken gelir */
+    CHECK(SLOW_FRAMES * FLEN * zsim_uart_char_ns() < CB_SLEEP_MS * 1000000LL / 2);
+
+    test_burst();
+    test_slow();
+    printf("test_uart_io_ovf: ok (%s%s)\n",
+           IS_ENABLED(CONFIG_CUSTOM_UART_RX_OVF_DROP_OLDEST) ? "drop-oldest"
+           : IS_ENABLED(CONFIG_CUSTOM_UART_RX_OVF_PRIORITY)  ? "priority"
+                                                              : "drop-newest",
+           IS_ENABLED(CONFIG_CUSTOM_UART_JUMBO) ? ", jumbo" : "");
+    return 0;
+}
@@ -0,0 +1,368 @@
+/* uart_io.c RX yolu, sürücü olay kayıtlarının oynatılmasıyla (zsim_uart_rx_replay).
+ * Her kayıt bir DMA buffer'ını başından sonuna kadar anlatır ve tekrar
+ * tekrar oynatılarak aynı frame akışını taşır:
+ *  - idle: timeout'la bölünmüş RX_RDY'ler (1 baytlık ve boş dilim dahil),
+ *    dolunca RX_RDY, RX_BUF_RELEASED, RX_BUF_REQUEST sırası
+ *  - late: RX_BUF_RELEASED yeni buffer'daki RX_RDY'den sonra gelir
+ *  - bytewise: buffer bayt bayt RX_RDY'lerle dolar, arada drain çalışmaz
+ *  - stop: buffer ortasında RX_STOPPED; kayıp yalnız kesintiye değen frame'ler
+ * Her frame sırayla ve tam bir kez gelmeli.
+ *
+ * Parçalı transferde aynı şey seg_reasm için: sırasız ve tekrarlı parçalar,
+ * tamamlandıktan sonra bütün transferin yeniden gönderimi. Büyük mesaj
+ * callback'i bir kez çağrılır; güvenilir transferde her tekrar yeniden
+ * ACK'lenir. */
+
+#include "uart_io_test.h"
+
+#if !IS_ENABLED(CONFIG_CUSTOM_UART_REASM)
+#error "test_uart_io_replay needs CONFIG_CUSTOM_UART_REASM"
+#endif
+
+#define CH UART_RX_CHUNK_LEN
+#define NFRAMES 120
+#define MAX_GOT (NFRAMES + 8)
+#define STREAM_MAX (NFRAMES * FRAME_MAX_TOTAL + 2 * CH)
+#define PLEN_MIN 16
+
+BUILD_ASSERT(CH >= 48 && CH <= UART_RB_SZ / 2, "traces assume a 48+ byte DMA buffer");
+/* Drain'ler arası en çok bir buffer: tamamlanan frame'ler havuza sığar */
+BUILD_ASSERT(DIV_ROUND_UP(CH, PLEN_MIN + FRAME_OVERHEAD_BYTES) <= UART_MSGQ_DEPTH, "frames per buffer exceed the pool");
+
+static uart_io_ctx_t *io;
+
+static struct
+{
+    uint32_t n;
+    uint16_t id[MAX_GOT];
+    uint16_t len[MAX_GOT];
+} got;
+
+/* Akış: frame i'nin ilk iki baytı i (BE), kalanı i'ye bağlı; içerik SYNC içermez */
+static struct
+{
+    uint8_t buf[STREAM_MAX];
+    size_t len;
+    size_t start[NFRAMES + 1];
+    uint16_t plen[NFRAMES];
+} st;
+
+static uint8_t pbyte(uint16_t id, uint16_t j)
+{
+    return (uint8_t)((id * 7u + j * 13u) & 0x7F);
+}
+
+static void on_rx(uart_frame_t *f)
+{
+    CHECK(got.n < MAX_GOT && f->len >= 2);
+    uint16_t id = sys_get_be16(f->data);
+    CHECK(id < NFRAMES && f->len == st.plen[id]);
+    for (uint16_t j = 2; j < f->len; j++)
+        CHECK(f->data[j] == pbyte(id, j));
+    got.id[got.n] = id;
+    got.len[got.n] = f->len;
+    got.n++;
+}
+
+static void stream_build(uint32_t seed)
+{
+    uint8_t p[UART_MAX_PACKET_SIZE];
+
+    st.len = 0;
+    for (uint16_t i = 0; i < NFRAMES; i++)
+    {
+        uint16_t l = (uint16_t)host_rand_range(&seed, PLEN_MIN, MIN(UART_MAX_PACKET_SIZE, 3 * CH / 2));
+        sys_put_be16(i, p);
+        for (uint16_t j = 2; j < l; j++)
+            p[j] = pbyte(i, j);
+        st.start[i] = st.len;
+        st.plen[i] = l;
+        st.len += build_frame(&st.buf[st.len], p, l);
+    }
+    st.start[NFRAMES] = st.len;
+}
+
+/* Kaydı akış bitene kadar tekrar oynat; son buffer SYNC'siz dolguyla tamamlanır.
+ * cut: her tekrarda STOP'un akıştaki yeri (NULL değilse) */
+static size_t replay(const zsim_rx_rec_t *rec, size_t n, size_t per_cycle, size_t *cut, size_t *ncut)
+{
+    size_t pos = 0, c = 0;
+
+    memset(&st.buf[st.len], 0, sizeof(st.buf) - st.len);
+    while (pos < st.len)
+    {
+        CHECK(pos + per_cycle <= sizeof(st.buf));
+        if (cut)
+            cut[c++] = pos;
+        size_t used = zsim_uart_rx_replay(rec, n, &st.buf[pos]);
+        CHECK(used == per_cycle);
+        pos += used;
+    }
+    if (ncut)
+        *ncut = c;
+    CHECK(zsim_wait(NULL, NULL, K_MSEC(50)) == false);
+    return pos;
+}
+
+static void expect_all_but(const bool *lost)
+{
+    uint32_t k = 0;
+
+    for (uint16_t i = 0; i < NFRAMES; i++)
+    {
+        if (lost && lost[i])
+            continue;
+        CHECK(k < got.n && got.id[k] == i);
+        k++;
+    }
+    CHECK(k == got.n);
+}
+
+static const zsim_rx_rec_t TRACE_IDLE[] = {
+    {ZSIM_RX_RDY, 0, 5},
+    {ZSIM_RX_RDY, 5, 1},
+    {.op = ZSIM_RX_GAP, .len = 300},
+    {ZSIM_RX_RDY, 6, 0},
+    {ZSIM_RX_RDY, 6, 34},
+    {.op = ZSIM_RX_GAP, .len = 100},
+    {ZSIM_RX_RDY, 40, CH - 40},
+    {.op = ZSIM_RX_NEXT},
+    {.op = ZSIM_RX_RELEASE},
+    {.op = ZSIM_RX_REQUEST},
+    {.op = ZSIM_RX_GAP, .len = 500},
+};
+
+static const zsim_rx_rec_t TRACE_LATE[] = {
+    {ZSIM_RX_RDY, 0, CH},
+    {.op = ZSIM_RX_GAP, .len = 200},
+    {.op = ZSIM_RX_NEXT},
+    {ZSIM_RX_RDY, 0, 7},
+    {.op = ZSIM_RX_GAP, .len = 200},
+    {.op = ZSIM_RX_RELEASE},
+    {.op = ZSIM_RX_REQUEST},
+    {ZSIM_RX_RDY, 7, CH - 7},
+    {.op = ZSIM_RX_NEXT},
+    {.op = ZSIM_RX_RELEASE},
+    {.op = ZSIM_RX_REQUEST},
+    {.op = ZSIM_RX_GAP, .len = 500},
+};
+
+/* Buffer'ın 40. baytında drain çalışır, 50. baytta hat hatası */
+#define STOP_DRAINED 40
+#define STOP_AT 50
+BUILD_ASSERT(STOP_AT - STOP_DRAINED < PLEN_MIN + FRAME_OVERHEAD_BYTES && STOP_AT <= CH, "cut spans two frames at most");
+static const zsim_rx_rec_t TRACE_STOP[] = {
+    {ZSIM_RX_RDY, 0, STOP_DRAINED},
+    {.op = ZSIM_RX_GAP, .len = 500},
+    {ZSIM_RX_RDY, STOP_DRAINED, STOP_AT - STOP_DRAINED},
+    {.op = ZSIM_RX_STOP},
+    {.op = ZSIM_RX_GAP, .len = 100},
+    {ZSIM_RX_RDY, 0, CH},
+    {.op = ZSIM_RX_NEXT},
+    {.op = ZSIM_RX_RELEASE},
+    {.op = ZSIM_RX_REQUEST},
+    {.op = ZSIM_RX_GAP, .len = 500},
+    {ZSIM_RX_RDY, 0, CH},
+    {.op = ZSIM_RX_NEXT},
+    {.op = ZSIM_RX_RELEASE},
+    {.op = ZSIM_RX_REQUEST},
+    {.op = ZSIM_RX_GAP, .len = 500},
+};
+
+static void run_trace(const char *name, const zsim_rx_rec_t *rec, size_t n, size_t per_cycle, uint32_t seed)
+{
+    uint32_t rx_bytes = zsim_uart_stats()->rx_bytes;
+    uint32_t enables = zsim_uart_stats()->rx_enables;
+    uint32_t crc_err = io_stat(io, UART_STAT_RX_CRC_ERR);
+    uint32_t pool_empty = io_stat(io, UART_STAT_RX_POOL_EMPTY);
+
+    got.n = 0;
+    stream_build(seed);
+    size_t fed = replay(rec, n, per_cycle, NULL, NULL);
+
+    expect_all_but(NULL);
+    CHECK(zsim_uart_stats()->rx_bytes - rx_bytes == fed);
+    CHECK(zsim_uart_stats()->rx_enables == enables);
+    CHECK(io_stat(io, UART_STAT_RX_CRC_ERR) == crc_err);
+    CHECK(io_stat(io, UART_STAT_RX_POOL_EMPTY) == pool_empty);
+    CHECK(io_stat(io, UART_STAT_RX_DROP_BYTES) == 0);
+    printf("trace %s: ok (%u frames, %zu bytes)\n", name, got.n, fed);
+}
+
+static void test_bytewise(void)
+{
+    static zsim_rx_rec_t rec[CH + 4];
+    size_t n = 0;
+
+    for (uint16_t i = 0; i < CH; i++)
+        rec[n++] = (zsim_rx_rec_t){ZSIM_RX_RDY, i, 1};
+    rec[n++] = (zsim_rx_rec_t){.op = ZSIM_RX_NEXT};
+    rec[n++] = (zsim_rx_rec_t){.op = ZSIM_RX_RELEASE};
+    rec[n++] = (zsim_rx_rec_t){.op = ZSIM_RX_REQUEST};
+    rec[n++] = (zsim_rx_rec_t){.op = ZSIM_RX_GAP, .len = 1000};
+    run_trace("bytewise", rec, n, CH, 3);
+}
+
+static void test_stop(void)
+{
+    static size_t cut[STREAM_MAX / CH + 1];
+    static bool lost[NFRAMES];
+    size_t ncut;
+    uint32_t enables = zsim_uart_stats()->rx_enables;
+
+    got.n = 0;
+    stream_build(4);
+    replay(TRACE_STOP, ARRAY_SIZE(TRACE_STOP), STOP_AT + 2 * CH, cut, &ncut);
+    CHECK(zsim_uart_stats()->rx_enables == enables + ncut);
+
+    /* Drain'in gördüğü son bayt ile hata arasına değen frame kaybolur: yarısı
+     * parser'da, yarısı halkada sıfırlanır. Aralık en kısa frame'den kısa, hata
+     * başına en çok iki kayıp. Geri kalan her frame bir kez. */
+    uint32_t nlost = 0;
+    for (uint16_t i = 0; i < NFRAMES; i++)
+    {
+        lost[i] = false;
+        for (size_t c = 0; c < ncut; c++)
+            lost[i] |= st.start[i] < cut[c] + STOP_AT && st.start[i + 1] > cut[c] + STOP_DRAINED;
+        nlost += lost[i];
+    }
+    CHECK(nlost > 0 && nlost <= 2 * ncut);
+    expect_all_but(lost);
+    printf("trace stop: ok (%u frames, %u lost in %zu stops)\n", got.n, nlost, ncut);
+}
+
+/* ---- Parçalı transfer ---- */
+
+#define REL_XID 7
+#define REL_LEN (PAYLOAD_MAX * 5 + 20)
+#define REL_SEGS DIV_ROUND_UP(REL_LEN, PAYLOAD_MAX)
+#define RAW_XID 8
+#define RAW_LEN (PAYLOAD_MAX * 2 + 3)
+
+BUILD_ASSERT(REL_LEN <= UART_REASM_MAX_SIZE, "transfer must fit the reassembly buffer");
+
+static uint8_t xfer[REL_LEN];
+
+static struct
+{
+    uint32_t n;
+    uint8_t xid;
+    uint16_t len;
+    bool same;
+} large;
+
+typedef struct
+{
+    uint32_t acks, full, other;
+} acks_t;
+
+static void on_large(uint8_t xid, const uint8_t *buf, uint16_t len)
+{
+    large.n++;
+    large.xid = xid;
+    large.len = len;
+    large.same = memcmp(buf, xfer, len) == 0;
+}
+
+static void on_wire_frame(const uart_frame_t *f, void *user)
+{
+    acks_t *a = user;
+    uint8_t typ, xid;
+    uint16_t total, off, clen;
+
+    CHECK(f->len >= SEG_HDR_SIZE);
+    seg_hdr_read(f->data, &typ, &xid, &total, &off, &clen);
+    if (typ != SEG_TYP_ACK)
+    {
+        a->other++;
+        return;
+    }
+    CHECK(xid == REL_XID && total == REL_LEN);
+    a->acks++;
+    a->full += off == REL_LEN;
+}
+
+/* Parça sırasını frame'ler olarak akışa dizer */
+static void seg_stream(uint8_t typ, uint8_t xid, uint16_t total, const uint16_t *order, size_t n)
+{
+    uint8_t p[UART_MAX_PACKET_SIZE];
+
+    st.len = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        uint16_t off = order[i] * PAYLOAD_MAX;
+        uint16_t clen = (uint16_t)MIN(PAYLOAD_MAX, (size_t)(total - off));
+        seg_hdr_write(p, typ, xid, total, off, clen);
+        memcpy(&p[SEG_HDR_SIZE], &xfer[off], clen);
+        st.len += build_frame(&st.buf[st.len], p, SEG_HDR_SIZE + clen);
+    }
+}
+
+static void test_reasm_raw(void)
+{
+    /* ACK'siz transferde tekrar: sayılır, birleştirilmez, ACK gitmez */
+    static const uint16_t order[] = {1, 0, 1, 2};
+    uint32_t dup0 = io_stat(io, UART_STAT_REASM_DUP);
+    acks_t a = {0};
+
+    memset(&large, 0, sizeof(large));
+    zsim_uart_wire_clear();
+    seg_stream(SEG_TYP_DATA, RAW_XID, RAW_LEN, order, ARRAY_SIZE(order));
+    replay(TRACE_LATE, ARRAY_SIZE(TRACE_LATE), 2 * CH, NULL, NULL);
+
+    CHECK(large.n == 1 && large.xid == RAW_XID && large.len == RAW_LEN && large.same);
+    CHECK(io_stat(io, UART_STAT_REASM_DUP) - dup0 == 1);
+    CHECK(io_wire_frames(on_wire_frame, &a) == 0);
+    printf("unreliable reassembly: ok\n");
+}
+
+static void test_reasm_reliable(void)
+{
+    /* Sırasız, bir parça iki kez; tamamlandıktan sonra bütün transfer yeniden.
+     * Hat hızında beslenir: kayıtların sıkıştırılmış zamanında ACK'ler TX
+     * kuyruğunu taşırırdı, gerçek göndericide tekrarlar hattan hızlı gelemez. */
+    static const uint16_t order[] = {0, 2, 1, 1, 3, 5, 4, 0, 1, 2, 3, 4, 5};
+    const uint32_t dups = 1 + REL_SEGS;
+    uint32_t dup0 = io_stat(io, UART_STAT_REASM_DUP);
+    uint32_t done0 = io_stat(io, UART_STAT_REASM_DONE);
+    uint32_t nobufs = io_stat(io, UART_STAT_TX_NOBUFS);
+    acks_t a = {0};
+
+    BUILD_ASSERT(REL_SEGS == 6, "order covers six segments");
+    memset(&large, 0, sizeof(large));
+    zsim_uart_wire_clear();
+    seg_stream(SEG_TYP_DATA | SEG_F_ACKREQ, REL_XID, REL_LEN, order, ARRAY_SIZE(order));
+    zsim_uart_feed(st.buf, st.len);
+    CHECK(zsim_wait(NULL, NULL, K_NSEC((int64_t)st.len * zsim_uart_char_ns() + 20000000)) == false);
+
+    CHECK(large.n == 1 && large.xid == REL_XID && large.len == REL_LEN && large.same);
+    CHECK(io_stat(io, UART_STAT_REASM_DUP) - dup0 == dups);
+    CHECK(io_stat(io, UART_STAT_REASM_DONE) - done0 == 1);
+    CHECK(io_stat(io, UART_STAT_TX_NOBUFS) == nobufs);
+    io_wire_frames(on_wire_frame, &a);
+    /* Tamamlanınca bir, sonraki her tekrar için bir tam ACK */
+    CHECK(a.other == 0 && a.full == 1 + REL_SEGS && a.acks > a.full);
+    printf("reliable reassembly: ok (%u dups, %u acks)\n", dups, a.acks);
+}
+
+int main(void)
+{
+    for (size_t i = 0; i < sizeof(xfer); i++)
+        xfer[i] = (uint8_t)(i * 31u + 5u);
+
+    CHECK(uart_io_init() == 0);
+    io = uart_io_ctx_get(0);
+    CHECK(io);
+    uart_io_ctx_register_rx_cb(io, on_rx);
+    uart_io_ctx_register_rx_large_cb(io, on_large);
+    zsim_uart_wire_clear();
+
+    run_trace("idle", TRACE_IDLE, ARRAY_SIZE(TRACE_IDLE), CH, 1);
+    run_trace("late", TRACE_LATE, ARRAY_SIZE(TRACE_LATE), 2 * CH, 2);
+    test_bytewise();
+    test_stop();
+    test_reasm_raw();
+    test_reasm_reliable(); /* hat modeli: oynatmalardan sonra */
+    printf("test_uart_io_replay: ok\n");
+    return 0;
+}
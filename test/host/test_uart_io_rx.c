@@ -0,0 +1,180 @@
+/* uart_io.c RX yolu, zsim üzerinde. Aynı kaynak kopyasız (RX_ZERO_COPY, halka
+ * içinde claim) ve kopyalı drain ile iki hedef olarak derlenir; ikisi de aynı
+ * beklenen sonucu doğrular ve aynı özeti basar:
+ *  - karışık akış: rastgele boylu frame'ler, arada çöp ve CRC'si bozuk frame'ler;
+ *    sağlam frame'lerin hepsi sırayla ve bir kez gelir
+ *  - drain halkadan okurken (claim tutulurken) RX hatası: ISR halkayı ve
+ *    parser'ı sıfırlamaz, drain sıfırlar (zsim claim varken ring_buf_reset'te
+ *    durur); kayıp yalnız kesintideki frame'ler, sonrası eksiksiz. */
+
+#include "uart_io_test.h"
+
+#define STREAM_FRAMES 240
+#define CUT_FRAMES 40
+#define MAX_GOT (STREAM_FRAMES + CUT_FRAMES * 2)
+
+static uart_io_ctx_t *io;
+
+static struct
+{
+    uint32_t n;
+    uint16_t len[MAX_GOT];
+    uint16_t crc[MAX_GOT];
+    uint8_t first[MAX_GOT];
+} got;
+
+static void on_rx(uart_frame_t *f)
+{
+    CHECK(got.n < MAX_GOT);
+    got.len[got.n] = f->len;
+    got.crc[got.n] = crc16_ccitt_update(UART_CRC_INT, f->data, f->len);
+    got.first[got.n] = f->data[0];
+    got.n++;
+}
+
+static bool got_n(void *arg)
+{
+    return got.n >= *(uint32_t *)arg;
+}
+
+static bool got_last(void *arg)
+{
+    return got.n && got.first[got.n - 1] == *(uint8_t *)arg;
+}
+
+/* Hat boşalana ve son frame dağıtılana kadar */
+static void settle(void)
+{
+    CHECK(zsim_wait(NULL, NULL, K_MSEC(50)) == false);
+}
+
+static void test_stream(void)
+{
+    static uint8_t line[STREAM_FRAMES * (FRAME_MAX_TOTAL + 8)];
+    uint16_t want_len[STREAM_FRAMES], want_crc[STREAM_FRAMES];
+    uint8_t p[UART_MAX_PACKET_SIZE];
+    uint32_t seed = 0xC0FFEE, nwant = 0, nbad = 0;
+    size_t n = 0;
+    uint32_t crc_err = io_stat(io, UART_STAT_RX_CRC_ERR);
+
+    for (uint32_t i = 0; i < STREAM_FRAMES; i++)
+    {
+        /* Çöp: SYNC'siz, frame sınırında */
+        for (uint32_t g = host_rand_range(&seed, 0, 3) ? 0 : host_rand_range(&seed, 1, 6); g; g--)
+        {
+            uint8_t b = (uint8_t)host_rand(&seed);
+            line[n++] = b == SYNC_BYTE ? 0 : b;
+        }
+
+        uint16_t l = (uint16_t)host_rand_range(&seed, 1, UART_MAX_PACKET_SIZE);
+        for (uint16_t j = 0; j < l; j++)
+            p[j] = (uint8_t)host_rand(&seed);
+        size_t fl = build_frame(&line[n], p, l);
+        if (i % 7 == 3)
+        {
+            line[n + 2 + host_rand_range(&seed, 0, l - 1)] ^= 0x01; /* DATA'da tek bit */
+            nbad++;
+        }
+        else
+        {
+            want_len[nwant] = l;
+            want_crc[nwant] = crc16_ccitt_update(UART_CRC_INT, p, l);
+            nwant++;
+        }
+        n += fl;
+    }
+
+    got.n = 0;
+    zsim_uart_feed(line, n);
+    CHECK(zsim_wait(got_n, &nwant, K_SECONDS(5)));
+    settle();
+    CHECK(got.n == nwant);
+
+    uint16_t digest = UART_CRC_INT;
+    for (uint32_t i = 0; i < nwant; i++)
+    {
+        CHECK(got.len[i] == want_len[i] && got.crc[i] == want_crc[i]);
+        digest = crc16_ccitt_update(digest, (const uint8_t *)&got.crc[i], sizeof(got.crc[i]));
+    }
+    CHECK(io_stat(io, UART_STAT_RX_CRC_ERR) - crc_err >= nbad);
+    CHECK(io_stat(io, UART_STAT_RX_DROP_BYTES) == 0);
+    printf("stream: ok (%u frames, %u corrupt, digest %04x)\n", nwant, nbad, digest);
+}
+
+/* Belirli bir okumada (claim tutulurken) RX hatası ver */
+static struct
+{
+    uint32_t at, calls;
+} cut;
+
+static void cut_hook(void *arg)
+{
+    ARG_UNUSED(arg);
+    if (++cut.calls == cut.at)
+        zsim_uart_rx_error(UART_ERROR_FRAMING);
+}
+
+static void feed_ids(uint8_t first, uint32_t count)
+{
+    uint8_t p[30], f[FRAME_MAX_TOTAL];
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        /* İçerik SYNC içermez: kesintiden sonra yeniden eşleme gerçek SYNC'te */
+        for (size_t j = 0; j < sizeof(p); j++)
+            p[j] = (uint8_t)((first + i + j) & 0x7F);
+        zsim_uart_feed(f, build_frame(f, p, sizeof(p)));
+    }
+}
+
+static void test_error_mid_claim(void)
+{
+    uint32_t enables = zsim_uart_stats()->rx_enables;
+
+    got.n = 0;
+    cut.calls = 0;
+    cut.at = 6;
+    zsim_ring_buf_get_hook(cut_hook, NULL);
+    feed_ids(0, CUT_FRAMES);
+    uint8_t last = CUT_FRAMES - 1;
+    CHECK(zsim_wait(got_last, &last, K_SECONDS(1)));
+    settle();
+    zsim_ring_buf_get_hook(NULL, NULL);
+    CHECK(cut.calls >= cut.at);
+    CHECK(zsim_uart_stats()->rx_enables == enables + 1);
+
+    /* Sırayla, tekrarsız; eksikler tek bir kesintide ve en fazla iki frame */
+    uint32_t missing = 0, holes = 0;
+    for (uint32_t i = 0; i < got.n; i++)
+    {
+        CHECK(got.len[i] == 30);
+        uint32_t prev = i ? got.first[i - 1] + 1u : 0u;
+        CHECK(got.first[i] >= prev);
+        missing += got.first[i] - prev;
+        holes += got.first[i] != prev;
+    }
+    CHECK(missing <= 2 && holes <= 1);
+
+    /* Halka ve parser tutarlı: sonraki akış eksiksiz */
+    uint32_t before = got.n, want = got.n + CUT_FRAMES;
+    feed_ids(CUT_FRAMES, CUT_FRAMES);
+    CHECK(zsim_wait(got_n, &want, K_SECONDS(1)));
+    settle();
+    CHECK(got.n == want);
+    for (uint32_t i = 0; i < CUT_FRAMES; i++)
+        CHECK(got.first[before + i] == CUT_FRAMES + i);
+    printf("rx error mid-claim: ok (%u lost)\n", missing);
+}
+
+int main(void)
+{
+    CHECK(uart_io_init() == 0);
+    io = uart_io_ctx_get(0);
+    CHECK(io);
+    uart_io_ctx_register_rx_cb(io, on_rx);
+
+    test_stream();
+    test_error_mid_claim();
+    printf("test_uart_io_rx (%s): ok\n", IS_ENABLED(CONFIG_CUSTOM_UART_RX_ZERO_COPY) ? "zero-copy" : "copy");
+    return 0;
+}
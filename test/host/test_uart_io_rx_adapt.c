@@ -0,0 +1,154 @@
+/* CONFIG_CUSTOM_UART_RX_ADAPTIVE, zsim hat modeli üzerinde. Trafik sırayla:
+ *  - istek/yanıt: uzun boşluklu tek frame'ler; düşük gecikme profili kalır,
+ *    yeniden başlatma yok, frame kısa timeout'la teslim edilir
+ *  - akış: aralarında GAP_CHARS'tan kısa boşluk olan frame'ler; art arda kısa
+ *    boşluklardan sonra timeout olayında akış profiline geçilir (bir
+ *    rx_retune). Sonra yalnız dolan tam buffer'lar gelir: kısa boşlukların
+ *    toplamı uzun boşluk sayılıp küçük buffer'lara dönülmez
+ *  - istek/yanıt: ilk frame uzun timeout'la gelir ve düşük gecikmeye döner
+ *    (ikinci rx_retune), sonrakiler yine kısa timeout'la gelir
+ * Yeniden başlatma frame'in kuyruğu halkada, başı parser'dayken yapılır
+ * (frame küçük buffer'dan uzun): her frame sırayla ve bir kez gelmeli, hat
+ * baytlarının hepsi DMA'ya yazılmalı. */
+
+#include "uart_io_test.h"
+
+#if !IS_ENABLED(CONFIG_CUSTOM_UART_RX_ADAPTIVE)
+#error "test_uart_io_rx_adapt needs CONFIG_CUSTOM_UART_RX_ADAPTIVE"
+#endif
+
+#define PLEN 20
+#define FLEN (PLEN + FRAME_OVERHEAD_BYTES)
+#define REQS 5
+#define STREAM 40
+#define NFRAMES (2 * REQS + STREAM)
+#define STREAM_GAP_CHARS (UART_RX_ADAPT_GAP_CHARS / 2)
+
+BUILD_ASSERT(FLEN > UART_RX_ADAPT_SMALL_CHUNK && FLEN < UART_RX_CHUNK_LEN,
+             "frames must span a low-latency buffer and fit a throughput buffer");
+BUILD_ASSERT(STREAM_GAP_CHARS > UART_RX_IDLE_CHARS, "stream gaps must end a low-latency burst");
+
+static uart_io_ctx_t *io;
+static int64_t char_ns;
+
+static struct
+{
+    uint32_t n;
+    uint8_t id[NFRAMES];
+    int64_t at_ns[NFRAMES];
+} got;
+
+static void on_rx(uart_frame_t *f)
+{
+    CHECK(got.n < NFRAMES && f->len == PLEN);
+    for (uint8_t j = 1; j < PLEN; j++)
+        CHECK(f->data[j] == (uint8_t)((f->data[0] + j) & 0x7F));
+    got.id[got.n] = f->data[0];
+    got.at_ns[got.n] = zsim_now_ns();
+    got.n++;
+}
+
+static bool got_n(void *arg)
+{
+    return got.n >= *(uint32_t *)arg;
+}
+
+/* İçerik SYNC içermez; id sırası kayıp ve tekrarı gösterir */
+static int64_t feed_id(uint8_t id)
+{
+    uint8_t p[PLEN], f[FRAME_MAX_TOTAL];
+
+    for (uint8_t j = 0; j < PLEN; j++)
+        p[j] = (uint8_t)((id + j) & 0x7F);
+    CHECK(build_frame(f, p, PLEN) == FLEN);
+    int64_t t0 = zsim_now_ns();
+    zsim_uart_feed(f, FLEN);
+    return t0;
+}
+
+/* Frame'in son baytından teslimine kadar geçen karakter süresi */
+static int64_t latency_chars(uint32_t i, int64_t t0)
+{
+    return (got.at_ns[i] - t0) / char_ns - FLEN;
+}
+
+/* Uzun boşluklu tek frame'ler; döner: ilk frame'in gecikmesi */
+static int64_t requests(uint8_t first)
+{
+    int64_t lat0 = 0;
+
+    for (uint32_t k = 0; k < REQS; k++)
+    {
+        uint32_t want = got.n + 1;
+        int64_t t0 = feed_id((uint8_t)(first + k));
+        CHECK(zsim_wait(got_n, &want, K_MSEC(5)));
+        int64_t lat = latency_chars(got.n - 1, t0);
+        if (k == 0)
+            lat0 = lat;
+        else
+            CHECK(lat <= UART_RX_IDLE_CHARS + 1);
+        CHECK(zsim_wait(NULL, NULL, K_MSEC(20)) == false);
+    }
+    return lat0;
+}
+
+static void test_adapt(void)
+{
+    const zsim_uart_stats_t *zs = zsim_uart_stats();
+    uint32_t enables = zs->rx_enables;
+
+    /* istek/yanıt: profil değişmez */
+    CHECK(requests(0) <= UART_RX_IDLE_CHARS + 1);
+    CHECK(io_stat(io, UART_STAT_RX_RETUNE) == 0);
+
+    /* akış: kısa boşluklarla; son frame'den sonra uzun timeout */
+    uint32_t rdy0 = 0, k_bulk = STREAM;
+    int64_t t_last = 0;
+    for (uint32_t k = 0; k < STREAM; k++)
+    {
+        t_last = feed_id((uint8_t)(REQS + k));
+        CHECK(zsim_wait(NULL, NULL, K_NSEC((FLEN + STREAM_GAP_CHARS) * char_ns)) == false);
+        if (k_bulk == STREAM && io_stat(io, UART_STAT_RX_RETUNE) == 1)
+        {
+            k_bulk = k;
+            rdy0 = zs->rx_rdy;
+        }
+    }
+    uint32_t want = REQS + STREAM;
+    CHECK(zsim_wait(got_n, &want, K_MSEC(5)));
+    CHECK(io_stat(io, UART_STAT_RX_RETUNE) == 1 && k_bulk <= STREAM / 4);
+    CHECK(latency_chars(got.n - 1, t_last) >= UART_RX_ADAPT_GAP_CHARS);
+    /* Akış profilinde yalnız dolan tam buffer'lar ve sondaki timeout: kısa
+     * boşluklar toplanıp düşük gecikmeye dönülmez */
+    uint32_t stream_rdy = zs->rx_rdy - rdy0;
+    CHECK(stream_rdy <= DIV_ROUND_UP((STREAM - 1u - k_bulk) * FLEN, UART_RX_CHUNK_LEN) + 1u);
+    CHECK(zsim_wait(NULL, NULL, K_MSEC(20)) == false);
+
+    /* istek/yanıt: ilki akış profilinin timeout'uyla gelir ve geri döndürür */
+    CHECK(requests(REQS + STREAM) >= UART_RX_ADAPT_GAP_CHARS);
+    CHECK(io_stat(io, UART_STAT_RX_RETUNE) == 2);
+
+    /* Kayıp ve tekrar yok; RX yalnız profil değişiminde yeniden açıldı */
+    CHECK(got.n == NFRAMES);
+    for (uint32_t i = 0; i < NFRAMES; i++)
+        CHECK(got.id[i] == i);
+    CHECK(zs->rx_lost == 0 && zs->rx_bytes == NFRAMES * FLEN);
+    CHECK(io_stat(io, UART_STAT_RX_BYTES) == NFRAMES * FLEN);
+    CHECK(io_stat(io, UART_STAT_RX_DROP_BYTES) == 0 && io_stat(io, UART_STAT_RX_CRC_ERR) == 0);
+    CHECK(io_stat(io, UART_STAT_RX_BUF_NONE) == 0);
+    CHECK(zs->rx_enables - enables == 2);
+    printf("adapt: ok (%u frames, throughput after frame %u, %u RX_RDY after it)\n", got.n, k_bulk, stream_rdy);
+}
+
+int main(void)
+{
+    CHECK(uart_io_init() == 0);
+    io = uart_io_ctx_get(0);
+    CHECK(io);
+    uart_io_ctx_register_rx_cb(io, on_rx);
+    char_ns = zsim_uart_char_ns();
+
+    test_adapt();
+    printf("test_uart_io_rx_adapt: ok\n");
+    return 0;
+}
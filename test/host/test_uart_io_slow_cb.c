@@ -0,0 +1,69 @@
+/* Yavaş tüketici, zsim üzerinde (native_sim'deki app.uart.loopback_bench.slow_cb
+ * senaryosunun host karşılığı). rx callback'i her frame'de uyur; karşı taraf
+ * cevapsız en çok havuz - 1 frame tutar ve her callback sonunda bir frame daha
+ * yollar. Pencere RX halkasından büyüktür: callback uyurken halka yalnız RX
+ * workqueue'su drain'e devam ederse taşmaz. Hiçbir bayt ve frame düşmemeli. */
+
+#include "uart_io_test.h"
+
+#define WINDOW (UART_MSGQ_DEPTH - 1)
+#define NFRAMES 200
+#define CB_SLEEP_MS 20
+
+BUILD_ASSERT(WINDOW * (UART_MAX_PACKET_SIZE + FRAME_OVERHEAD_BYTES) > UART_RB_SZ,
+             "window must not fit the ring buffer");
+
+static uart_io_ctx_t *io;
+static uint32_t sent, got, bad;
+
+static void peer_send(void)
+{
+    uint8_t p[UART_MAX_PACKET_SIZE], f[FRAME_MAX_TOTAL];
+
+    for (size_t j = 0; j < sizeof(p); j++)
+        p[j] = (uint8_t)(sent + j);
+    zsim_uart_feed(f, build_frame(f, p, sizeof(p)));
+    sent++;
+}
+
+static void on_rx(uart_frame_t *f)
+{
+    bool ok = f->len == UART_MAX_PACKET_SIZE;
+    for (size_t j = 0; ok && j < f->len; j++)
+        ok = f->data[j] == (uint8_t)(got + j);
+    bad += !ok;
+    got++;
+
+    k_msleep(CB_SLEEP_MS);
+    if (sent < NFRAMES)
+        peer_send(); /* karşı tarafa kredi */
+}
+
+static bool all_got(void *arg)
+{
+    ARG_UNUSED(arg);
+    return got == NFRAMES;
+}
+
+int main(void)
+{
+    CHECK(uart_io_init() == 0);
+    io = uart_io_ctx_get(0);
+    CHECK(io);
+    uart_io_ctx_register_rx_cb(io, on_rx);
+    /* Callback hattan yavaş: pencere dolu kalır */
+    CHECK(CB_SLEEP_MS * 1000000LL > 2LL * (UART_MAX_PACKET_SIZE + FRAME_OVERHEAD_BYTES) * zsim_uart_char_ns());
+
+    while (sent < WINDOW)
+        peer_send();
+    CHECK(zsim_wait(all_got, NULL, K_MSEC(NFRAMES * CB_SLEEP_MS * 2)));
+    CHECK(zsim_wait(NULL, NULL, K_MSEC(50)) == false);
+
+    uint32_t hwm = io_stat(io, UART_STAT_RB_HWM);
+    CHECK(got == NFRAMES && bad == 0);
+    CHECK(io_stat(io, UART_STAT_RX_DROP_BYTES) == 0 && io_stat(io, UART_STAT_RX_OVF_GAPS) == 0);
+    CHECK(io_stat(io, UART_STAT_RX_POOL_EMPTY) == 0 && io_stat(io, UART_STAT_RX_Q_FULL) == 0);
+    CHECK(io_stat(io, UART_STAT_RXQ_HWM) >= WINDOW - 1 && hwm < UART_RB_SZ);
+    printf("test_uart_io_slow_cb: ok (%u frames, window %u, ring hwm %u/%u)\n", got, WINDOW, hwm, UART_RB_SZ);
+    return 0;
+}
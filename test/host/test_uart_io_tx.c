@@ -0,0 +1,298 @@
+/* uart_io.c TX kuyruğu, zsim üzerinde: senkron ve async gönderim, dolu kuyruk,
+ * takılı hat (timeout + iptal) ve uart_tx hatası. Her senaryodan sonra kuyruk
+ * boşalmış ve slot havuzu tam dönmüş olmalı: derinlik kadar frame yeniden
+ * K_NO_WAIT ile kuyruğa girer. */
+
+#include "uart_io_test.h"
+
+#define MAX_FRAMES 32
+
+typedef struct
+{
+    uint32_t n;
+    uint16_t len[MAX_FRAMES];
+    uint8_t first[MAX_FRAMES];
+} got_t;
+
+typedef struct
+{
+    uint32_t n;
+    int id[MAX_FRAMES];
+    int rc[MAX_FRAMES];
+} done_t;
+
+typedef struct
+{
+    done_t *d;
+    int id;
+} tag_t;
+
+static uart_io_ctx_t *io;
+static uint8_t payload[UART_FRAME_LEN_MAX];
+
+static void on_frame(const uart_frame_t *f, void *user)
+{
+    got_t *g = user;
+
+    CHECK(g->n < MAX_FRAMES);
+    CHECK(memcmp(&f->data[1], &payload[1], f->len - 1u) == 0);
+    g->len[g->n] = f->len;
+    g->first[g->n] = f->data[0];
+    g->n++;
+}
+
+static void wire(got_t *g)
+{
+    memset(g, 0, sizeof(*g));
+    CHECK(io_wire_frames(on_frame, g) == g->n);
+}
+
+static void on_sent(int result, void *user)
+{
+    tag_t *t = user;
+
+    CHECK(k_is_in_isr() || result != 0); /* uart_tx reddi çağıranın bağlamında tamamlanır */
+    CHECK(t->d->n < MAX_FRAMES);
+    t->d->id[t->d->n] = t->id;
+    t->d->rc[t->d->n] = result;
+    t->d->n++;
+}
+
+static bool all_done(void *arg)
+{
+    tag_t *t = arg;
+    return t->d->n == (uint32_t)t->id;
+}
+
+/* Kimliği ilk bayta yazılmış frame; kablodan ayırt etmek için */
+static int send_async(tag_t *t, done_t *d, int id, uint16_t len, k_timeout_t timeout)
+{
+    t->d = d;
+    t->id = id;
+    payload[0] = (uint8_t)id;
+    return uart_io_ctx_send_frame_async(io, payload, len, on_sent, t, timeout);
+}
+
+static void wait_done(done_t *d, uint32_t n)
+{
+    tag_t want = {.d = d, .id = (int)n};
+    CHECK(zsim_wait(all_done, &want, K_SECONDS(1)));
+}
+
+/* Kuyruk boş ve havuz tam: derinlik kadar frame K_NO_WAIT ile girer, hepsi gider */
+static void check_queue_drained(void)
+{
+    tag_t t[UART_TX_QUEUE_DEPTH];
+    done_t d = {0};
+    got_t g;
+
+    zsim_run_idle();
+    zsim_uart_wire_clear();
+    for (int i = 0; i < UART_TX_QUEUE_DEPTH; i++)
+        CHECK(send_async(&t[i], &d, 0x40 + i, 8, K_NO_WAIT) == 0);
+    wait_done(&d, UART_TX_QUEUE_DEPTH);
+    for (int i = 0; i < UART_TX_QUEUE_DEPTH; i++)
+        CHECK(d.id[i] == 0x40 + i && d.rc[i] == 0);
+    wire(&g);
+    CHECK(g.n == UART_TX_QUEUE_DEPTH);
+}
+
+static void test_sync(void)
+{
+    uint32_t frames = io_stat(io, UART_STAT_TX_FRAMES);
+    got_t g;
+
+    payload[0] = 0x01;
+    CHECK(uart_io_ctx_send_frame(io, payload, 10, K_MSEC(100)) == 0);
+    /* TX_DONE'u gördükten sonra döner: frame kabloda */
+    wire(&g);
+    CHECK(g.n == 1 && g.len[0] == 10 && g.first[0] == 0x01);
+    CHECK(io_stat(io, UART_STAT_TX_FRAMES) == frames + 1);
+
+    /* Boyut sınırları */
+    CHECK(uart_io_ctx_send_frame(io, payload, 0, K_MSEC(100)) == -EINVAL);
+    CHECK(uart_io_ctx_send_frame(io, payload, UART_FRAME_LEN_MAX + 1, K_MSEC(100)) == -EINVAL);
+    /* Segment header'ında toplam boy 16 bit; buffer okunmadan reddedilir */
+    CHECK(uart_io_ctx_send_large(io, payload, 0, 1) == -EINVAL);
+    CHECK(uart_io_ctx_send_large(io, payload, UINT16_MAX + 1u, 1) == -EINVAL);
+    CHECK(io_stat(io, UART_STAT_TX_FRAMES) == frames + 1);
+    CHECK(uart_io_ctx_send_frame(io, payload, UART_MAX_PACKET_SIZE, K_MSEC(100)) == 0);
+    wire(&g);
+    CHECK(g.n == 1 && g.len[0] == UART_MAX_PACKET_SIZE);
+#if IS_ENABLED(CONFIG_CUSTOM_UART_JUMBO)
+    /* Klasik frame'e sığmayan DATA jumbo SYNC ve 16-bit LEN ile gider */
+    size_t n;
+    CHECK(uart_io_ctx_send_frame(io, payload, UART_MAX_PACKET_SIZE + 1, K_MSEC(100)) == 0);
+    CHECK(zsim_uart_wire(&n)[0] == SYNC_BYTE_JUMBO);
+    wire(&g);
+    CHECK(g.n == 1 && g.len[0] == UART_MAX_PACKET_SIZE + 1);
+    CHECK(uart_io_ctx_send_frame(io, payload, UART_FRAME_LEN_MAX, K_MSEC(1000)) == 0); /* 115200 bps: ~180 ms */
+    wire(&g);
+    CHECK(g.n == 1 && g.len[0] == UART_FRAME_LEN_MAX);
+#endif
+
+    /* Scatter-gather: parçalar tek frame'in DATA'sı olur */
+    const uart_iovec_t v[] = {{.buf = payload, .len = 3}, {.buf = &payload[3], .len = 20}};
+    CHECK(uart_io_ctx_sendv(io, v, ARRAY_SIZE(v), K_MSEC(100)) == 0);
+    wire(&g);
+    CHECK(g.n == 1 && g.len[0] == 23);
+    printf("sync: ok\n");
+}
+
+static void test_async_order(void)
+{
+    tag_t t[3];
+    done_t d = {0};
+    got_t g;
+
+    int64_t t0 = zsim_now_ns();
+    for (int i = 0; i < 3; i++)
+        CHECK(send_async(&t[i], &d, 0x10 + i, (uint16_t)(5 + i), K_NO_WAIT) == 0);
+    /* Çağıran beklemez: TX_DONE henüz gelmedi */
+    CHECK(d.n == 0);
+    wait_done(&d, 3);
+    /* Sıradaki transfer TX_DONE'dan başlar: hat frame'ler arasında boş kalmaz */
+    CHECK(zsim_now_ns() - t0 == (5 + 6 + 7 + 3 * FRAME_OVERHEAD_BYTES) * zsim_uart_char_ns());
+    for (int i = 0; i < 3; i++)
+        CHECK(d.id[i] == 0x10 + i && d.rc[i] == 0);
+    wire(&g);
+    CHECK(g.n == 3);
+    for (int i = 0; i < 3; i++)
+        CHECK(g.first[i] == 0x10 + i && g.len[i] == 5 + i);
+    printf("async: ok\n");
+}
+
+static void test_queue_full(void)
+{
+    tag_t t[UART_TX_QUEUE_DEPTH + 1];
+    done_t d = {0};
+    uint32_t nobufs = io_stat(io, UART_STAT_TX_NOBUFS);
+
+    /* Hat takılı: ilk frame DMA'da kalır, kuyruk derinlik kadar dolar */
+    zsim_uart_tx_stuck(true);
+    for (int i = 0; i < UART_TX_QUEUE_DEPTH; i++)
+        CHECK(send_async(&t[i], &d, 0x20 + i, 8, K_NO_WAIT) == 0);
+    CHECK(send_async(&t[UART_TX_QUEUE_DEPTH], &d, 0x2f, 8, K_NO_WAIT) == -ENOBUFS);
+
+    /* Süreli bekleme de boş slot bulamaz; süre simüle zamanda geçer */
+    int64_t t0 = zsim_now_ns();
+    CHECK(send_async(&t[UART_TX_QUEUE_DEPTH], &d, 0x2f, 8, K_MSEC(5)) == -ENOBUFS);
+    CHECK(zsim_now_ns() - t0 == 5000000);
+    CHECK(io_stat(io, UART_STAT_TX_NOBUFS) == nobufs + 2);
+    CHECK(io_stat(io, UART_STAT_TXQ_HWM) == UART_TX_QUEUE_DEPTH);
+    CHECK(d.n == 0);
+
+    /* Hat açılınca bekleyen gönderim ilk TX_DONE ile slot alır */
+    zsim_uart_tx_stuck(false);
+    CHECK(send_async(&t[UART_TX_QUEUE_DEPTH], &d, 0x2f, 8, K_MSEC(100)) == 0);
+    CHECK(d.n >= 1);
+    wait_done(&d, UART_TX_QUEUE_DEPTH + 1);
+    for (int i = 0; i < UART_TX_QUEUE_DEPTH + 1; i++)
+        CHECK(d.rc[i] == 0);
+    CHECK(d.id[UART_TX_QUEUE_DEPTH] == 0x2f);
+    zsim_uart_wire_clear();
+    printf("queue full: ok\n");
+}
+
+static void test_stuck_line(void)
+{
+    uint32_t timeouts = io_stat(io, UART_STAT_TX_TIMEOUTS);
+    uint32_t aborts = io_stat(io, UART_STAT_TX_ABORTS);
+    tag_t other;
+    done_t d = {0};
+    got_t g;
+
+    /* Tek frame DMA'da takılır: timeout'ta abort edilir, callback'i ayrılmıştır */
+    zsim_uart_tx_stuck(true);
+    payload[0] = 0x30;
+    int64_t t0 = zsim_now_ns();
+    CHECK(uart_io_ctx_send_frame(io, payload, 12, K_MSEC(10)) == -ETIMEDOUT);
+    CHECK(zsim_now_ns() - t0 == 10000000);
+    CHECK(io_stat(io, UART_STAT_TX_TIMEOUTS) == timeouts + 1);
+    CHECK(io_stat(io, UART_STAT_TX_ABORTS) == aborts + 1);
+    CHECK(zsim_uart_stats()->tx_aborts == 1);
+
+    /* Başkasının frame'i DMA'da, bizimki arkasında bekliyor: yalnız bizimki
+     * kuyruktan çıkar, DMA'daki abort edilmez */
+    CHECK(send_async(&other, &d, 0x31, 9, K_NO_WAIT) == 0);
+    payload[0] = 0x32;
+    CHECK(uart_io_ctx_send_frame(io, payload, 12, K_MSEC(10)) == -ETIMEDOUT);
+    CHECK(zsim_uart_stats()->tx_aborts == 1);
+    CHECK(d.n == 0);
+
+    zsim_uart_tx_stuck(false);
+    wait_done(&d, 1);
+    CHECK(d.id[0] == 0x31 && d.rc[0] == 0);
+    wire(&g);
+    CHECK(g.n == 1 && g.first[0] == 0x31);
+
+    /* Kuyruk takılı kalmadı */
+    payload[0] = 0x33;
+    CHECK(uart_io_ctx_send_frame(io, payload, 12, K_MSEC(10)) == 0);
+    wire(&g);
+    CHECK(g.n == 1 && g.first[0] == 0x33);
+    printf("stuck line: ok\n");
+}
+
+static void test_tx_error(void)
+{
+    uint32_t errors = io_stat(io, UART_STAT_TX_ERRORS);
+    tag_t t[2];
+    done_t d = {0};
+    got_t g;
+
+    /* Senkron: uart_tx reddi doğrudan döner */
+    zsim_uart_tx_fail(1, -EIO);
+    payload[0] = 0x50;
+    CHECK(uart_io_ctx_send_frame(io, payload, 6, K_MSEC(10)) == -EIO);
+    CHECK(io_stat(io, UART_STAT_TX_ERRORS) == errors + 1);
+
+    /* Async: reddedilen frame -EIO ile tamamlanır, sıradaki yine gider */
+    zsim_uart_tx_fail(1, -EIO);
+    CHECK(send_async(&t[0], &d, 0x51, 6, K_NO_WAIT) == 0);
+    CHECK(d.n == 1 && d.id[0] == 0x51 && d.rc[0] == -EIO);
+    CHECK(send_async(&t[1], &d, 0x52, 6, K_NO_WAIT) == 0);
+    wait_done(&d, 2);
+    CHECK(d.id[1] == 0x52 && d.rc[1] == 0);
+    wire(&g);
+    CHECK(g.n == 1 && g.first[0] == 0x52);
+    CHECK(io_stat(io, UART_STAT_TX_ERRORS) == errors + 2);
+
+    /* DMA'da frame varken sıradaki reddedilirse o da tek başına tamamlanır.
+     * TX_DONE'da sıradaki önce başlatılır: reddin callback'i önce gelir. */
+    CHECK(send_async(&t[0], &d, 0x53, 6, K_NO_WAIT) == 0);
+    CHECK(send_async(&t[1], &d, 0x54, 6, K_NO_WAIT) == 0);
+    zsim_uart_tx_fail(1, -EIO);
+    wait_done(&d, 4);
+    CHECK(d.id[2] == 0x54 && d.rc[2] == -EIO);
+    CHECK(d.id[3] == 0x53 && d.rc[3] == 0);
+    wire(&g);
+    CHECK(g.n == 1 && g.first[0] == 0x53);
+    printf("tx error: ok\n");
+}
+
+int main(void)
+{
+    for (size_t i = 0; i < sizeof(payload); i++)
+        payload[i] = (uint8_t)(i * 7u + 3u);
+
+    CHECK(uart_io_init() == 0);
+    io = uart_io_ctx_get(0);
+    CHECK(io);
+
+    test_sync();
+    check_queue_drained();
+    test_async_order();
+    check_queue_drained();
+    test_queue_full();
+    check_queue_drained();
+    test_stuck_line();
+    check_queue_drained();
+    test_tx_error();
+    check_queue_drained();
+
+    /* Her frame ya kabloda ya da sayılmış bir hata/iptal */
+    CHECK(io_stat(io, UART_STAT_TX_FRAMES) == zsim_uart_stats()->tx_done + zsim_uart_stats()->tx_aborts);
+    printf("test_uart_io_tx: ok\n");
+    return 0;
+}
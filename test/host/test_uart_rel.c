@@ -0,0 +1,234 @@
+/* uart_rel.c sliding window, zsim üzerinde. Karşı taraf testin içindedir:
+ * kabloya çıkan frame'ler ayrılıp seg_reasm'e verilir (cihaz bu testte DATA
+ * parçası almaz, birleştirici karşı tarafındır),
+ * ürettiği ACK'ler frame olarak RX hattına geri beslenir. Kayıp, seçilen DATA
+ * parçalarını veya ACK'leri karşıya hiç vermeyerek kurulur.
+ *
+ * Her senaryoda transfer karşıda bir kez ve doğru içerikle tamamlanmalı;
+ * yeniden gönderim yalnız gerçekten onaylanmamış parçalar için olmalı. */
+
+#include "uart_io_test.h"
+#include "seg_reasm.h"
+
+#if !IS_ENABLED(CONFIG_CUSTOM_UART_RELIABLE) || !IS_ENABLED(CONFIG_CUSTOM_UART_REASM)
+#error "test_uart_rel needs CONFIG_CUSTOM_UART_RELIABLE and CONFIG_CUSTOM_UART_REASM"
+#endif
+
+#define XFER_LEN (PAYLOAD_MAX * 17 + 11)
+#define XFER_SEGS DIV_ROUND_UP(XFER_LEN, PAYLOAD_MAX)
+#define RTO_NS ((int64_t)UART_REL_RTO_MS * 1000000)
+
+BUILD_ASSERT(XFER_SEGS > 2 * UART_REL_WINDOW, "transfer must slide the window");
+BUILD_ASSERT(XFER_LEN <= UART_REASM_MAX_SIZE, "peer must hold the transfer");
+
+/* Karşı taraf */
+typedef struct
+{
+    seg_reasm_t ra;
+    reasm_slot_t slot;
+    uart_stats_t st;
+
+    uint32_t drop_seg_mask; /* bu indeksli parçaların ilk gönderimi kaybolur */
+    uint32_t drop_acks;     /* ilk n ACK kaybolur */
+    bool dead;              /* hiçbir şey karşıya ulaşmaz */
+
+    uint32_t seg_tx[XFER_SEGS]; /* parça başına kabloya çıkış */
+    int64_t first_at[XFER_SEGS];
+    uint32_t acks;
+    uint32_t done;
+    uint8_t done_xid;
+    uint8_t buf[XFER_LEN];
+} peer_t;
+
+static uart_io_ctx_t *io;
+static peer_t peer;
+static uint8_t payload[XFER_LEN];
+
+static uint32_t pstat(uart_stat_id_t id)
+{
+    return (uint32_t)atomic_get(&peer.st.cnt[id]);
+}
+
+static void on_done(uint8_t xid, const uint8_t *buf, uint16_t len)
+{
+    CHECK(len == XFER_LEN);
+    memcpy(peer.buf, buf, len);
+    peer.done_xid = xid;
+    peer.done++;
+}
+
+static void on_ack(void *user, const uint8_t *ack, size_t len)
+{
+    uint8_t f[FRAME_MAX_TOTAL];
+
+    ARG_UNUSED(user);
+    peer.acks++;
+    if (peer.drop_acks)
+    {
+        peer.drop_acks--;
+        return;
+    }
+    zsim_uart_feed(f, build_frame(f, ack, (uint16_t)len));
+}
+
+static void on_frame(const uart_frame_t *f, void *user)
+{
+    uint8_t typ, xid;
+    uint16_t total, off, clen;
+
+    ARG_UNUSED(user);
+    CHECK(f->len >= SEG_HDR_SIZE);
+    seg_hdr_read(f->data, &typ, &xid, &total, &off, &clen);
+    CHECK(typ == (SEG_TYP_DATA | SEG_F_ACKREQ) && total == XFER_LEN && off % PAYLOAD_MAX == 0);
+
+    uint16_t idx = off / PAYLOAD_MAX;
+    if (!peer.seg_tx[idx]++)
+        peer.first_at[idx] = zsim_now_ns();
+    if (peer.dead || (peer.seg_tx[idx] == 1 && idx < 32 && (peer.drop_seg_mask & BIT(idx))))
+        return;
+    CHECK(seg_reasm_push(&peer.ra, f->data, f->len) == 0);
+}
+
+/* Tamamlanan her TX transferi karşının hattına */
+static void on_wire(const uint8_t *buf, size_t len, void *user)
+{
+    ARG_UNUSED(user);
+    io_split_frames(buf, len, on_frame, NULL);
+}
+
+static void peer_reset(void)
+{
+    memset(&peer.st, 0, sizeof(peer.st));
+    seg_reasm_init(&peer.ra, &peer.slot, 1, &peer.st);
+    seg_reasm_set_cb(&peer.ra, on_done);
+    seg_reasm_set_ack_fn(&peer.ra, on_ack, NULL);
+    peer.drop_seg_mask = peer.drop_acks = 0;
+    peer.dead = false;
+    memset(peer.seg_tx, 0, sizeof(peer.seg_tx));
+    peer.acks = peer.done = 0;
+    memset(peer.buf, 0, sizeof(peer.buf));
+}
+
+static uint32_t retx_total(void)
+{
+    uint32_t n = 0;
+    for (uint16_t i = 0; i < XFER_SEGS; i++)
+        n += peer.seg_tx[i] ? peer.seg_tx[i] - 1 : 0;
+    return n;
+}
+
+static void expect_delivered(uint8_t xid)
+{
+    CHECK(peer.done == 1 && peer.done_xid == xid);
+    CHECK(memcmp(peer.buf, payload, XFER_LEN) == 0);
+    for (uint16_t i = 0; i < XFER_SEGS; i++)
+        CHECK(peer.seg_tx[i] >= 1);
+}
+
+static void test_clean(void)
+{
+    /* Kayıpsız hat: her parça bir kez, RTO beklenmez */
+    uint32_t segs = io_stat(io, UART_STAT_REL_SEGS);
+    uint32_t retx = io_stat(io, UART_STAT_REL_RETX);
+    uint32_t acks = io_stat(io, UART_STAT_REL_ACKS);
+
+    peer_reset();
+    int64_t t0 = zsim_now_ns();
+    CHECK(uart_io_ctx_send_reliable(io, payload, XFER_LEN, 1) == 0);
+    expect_delivered(1);
+    CHECK(retx_total() == 0 && peer.acks > 0 && pstat(UART_STAT_REASM_DUP) == 0);
+    CHECK(io_stat(io, UART_STAT_REL_SEGS) == segs + XFER_SEGS);
+    CHECK(io_stat(io, UART_STAT_REL_RETX) == retx);
+    CHECK(io_stat(io, UART_STAT_REL_ACKS) > acks);
+    CHECK(zsim_now_ns() - t0 < RTO_NS);
+    printf("clean: ok (%u acks, %lld us)\n", peer.acks, (long long)((zsim_now_ns() - t0) / 1000));
+}
+
+static void test_window(void)
+{
+    /* İlk pencerenin ACK'leri kaybolur: RTO'ya kadar hatta pencere kadar
+     * parça çıkar, RTO'da hepsi tekrar gider. Karşı taraf tekrarları
+     * birleştirmez, yeniden ACK'ler; transfer yine bir kez tamamlanır. */
+    uint32_t retx = io_stat(io, UART_STAT_REL_RETX);
+
+    peer_reset();
+    peer.drop_acks = 2; /* sıralı parçalarda WINDOW/2'de bir ACK */
+    int64_t t0 = zsim_now_ns();
+    CHECK(uart_io_ctx_send_reliable(io, payload, XFER_LEN, 2) == 0);
+    expect_delivered(2);
+
+    uint32_t early = 0;
+    for (uint16_t i = 0; i < XFER_SEGS; i++)
+        early += peer.first_at[i] - t0 < RTO_NS;
+    CHECK(early == UART_REL_WINDOW);
+    for (uint16_t i = 0; i < XFER_SEGS; i++)
+        CHECK(peer.seg_tx[i] == (i < UART_REL_WINDOW ? 2u : 1u));
+    CHECK(retx_total() == UART_REL_WINDOW);
+    CHECK(pstat(UART_STAT_REASM_DUP) == UART_REL_WINDOW);
+    CHECK(io_stat(io, UART_STAT_REL_RETX) == retx + UART_REL_WINDOW);
+    printf("window: ok\n");
+}
+
+static void test_selective(void)
+{
+    /* Biri ilk pencerede, biri kaydıktan sonra iki parça kaybolur: sonrakiler
+     * seçici ACK'le onaylanır, RTO'da yalnız kayıplar gider ve deliği kapatan
+     * parça hemen ACK'lenir (her kayıp tam bir kez yeniden gönderilir) */
+    uint32_t retx = io_stat(io, UART_STAT_REL_RETX);
+
+    peer_reset();
+    peer.drop_seg_mask = BIT(3) | BIT(UART_REL_WINDOW + 1);
+    CHECK(uart_io_ctx_send_reliable(io, payload, XFER_LEN, 3) == 0);
+    expect_delivered(3);
+    for (uint16_t i = 0; i < XFER_SEGS; i++)
+        CHECK(peer.seg_tx[i] == ((peer.drop_seg_mask & BIT(i)) ? 2u : 1u));
+    CHECK(retx_total() == 2 && pstat(UART_STAT_REASM_DUP) == 0);
+    CHECK(io_stat(io, UART_STAT_REL_RETX) == retx + 2);
+    printf("selective retransmit: ok\n");
+}
+
+static void test_dead_link(void)
+{
+    /* Karşı taraf yok: her RTO'da pencere yeniden gider, MAX_RETRIES'ı
+     * aşan RTO'da -ETIMEDOUT */
+    uint32_t retx = io_stat(io, UART_STAT_REL_RETX);
+    uint32_t fail = io_stat(io, UART_STAT_REL_FAIL);
+
+    peer_reset();
+    peer.dead = true;
+    int64_t t0 = zsim_now_ns();
+    CHECK(uart_io_ctx_send_reliable(io, payload, XFER_LEN, 4) == -ETIMEDOUT);
+    int64_t dt = zsim_now_ns() - t0;
+    int64_t win_ns = (int64_t)UART_REL_WINDOW * FRAME_MAX_TOTAL * zsim_uart_char_ns();
+    CHECK(dt >= (UART_REL_MAX_RETRIES + 1) * RTO_NS && dt < (UART_REL_MAX_RETRIES + 1) * (RTO_NS + win_ns));
+    CHECK(retx_total() == UART_REL_MAX_RETRIES * UART_REL_WINDOW);
+    CHECK(peer.seg_tx[UART_REL_WINDOW] == 0);
+    CHECK(peer.done == 0);
+    CHECK(io_stat(io, UART_STAT_REL_RETX) == retx + UART_REL_MAX_RETRIES * UART_REL_WINDOW);
+    CHECK(io_stat(io, UART_STAT_REL_FAIL) == fail + 1);
+
+    /* Sonraki transfer etkilenmez */
+    peer_reset();
+    CHECK(uart_io_ctx_send_reliable(io, payload, XFER_LEN, 5) == 0);
+    expect_delivered(5);
+    CHECK(retx_total() == 0);
+    printf("dead link: ok\n");
+}
+
+int main(void)
+{
+    for (size_t i = 0; i < sizeof(payload); i++)
+        payload[i] = (uint8_t)(i * 29u + 7u);
+
+    CHECK(uart_io_init() == 0);
+    io = uart_io_ctx_get(0);
+    CHECK(io);
+    zsim_uart_set_sink(on_wire, NULL);
+
+    test_clean();
+    test_window();
+    test_selective();
+    test_dead_link();
+    printf("test_uart_rel: ok\n");
+    return 0;
+}
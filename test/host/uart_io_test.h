@@ -0,0 +1,62 @@
+#pragma once
+
+/* uart_io.c testlerinin ortak parçaları (zsim üzerinde): port sayaçları ve
+ * kabloya giden baytların frame'lere ayrılması. */
+
+#include "host_common.h"
+#include "zsim.h"
+#include "uart_io.h"
+
+static inline uint32_t io_stat(uart_io_ctx_t *ctx, uart_stat_id_t id)
+{
+    uart_io_stats_t st;
+    CHECK(uart_io_ctx_get_stats(ctx, &st) == 0);
+    return st.cnt[id];
+}
+
+typedef void (*io_frame_fn_t)(const uart_frame_t *f, void *user);
+
+/* Bütün frame'lerden oluşan bayt dizisini sırayla fn'e verir; frame sayısını döner.
+ * Bozuk veya yarım kalan bayt varsa test durur: TX her zaman bütün frame yazar. */
+static inline uint32_t io_split_frames(const uint8_t *w, size_t n, io_frame_fn_t fn, void *user)
+{
+    static uart_frame_t f;
+    uint32_t got = 0;
+
+    for (size_t i = 0; i < n;)
+    {
+        /* SYNC LEN veya (jumbo) SYNC_JUMBO LEN_H LEN_L */
+        size_t h = 2;
+        CHECK(n - i >= FRAME_OVERHEAD_BYTES);
+        if (IS_ENABLED(CONFIG_CUSTOM_UART_JUMBO) && w[i] == SYNC_BYTE_JUMBO)
+        {
+            h = 3;
+            f.len = sys_get_be16(&w[i + 1]);
+            CHECK(f.len > UART_MAX_PACKET_SIZE);
+        }
+        else
+        {
+            CHECK(w[i] == SYNC_BYTE);
+            f.len = w[i + 1];
+        }
+        CHECK(f.len >= 1 && f.len <= UART_FRAME_LEN_MAX && n - i >= h + 2u + f.len);
+        uint16_t crc = crc16_ccitt_update(UART_CRC_INT, &w[i + 1], h - 1 + f.len);
+        CHECK(w[i + h + f.len] == (uint8_t)(crc >> 8) && w[i + h + 1 + f.len] == (uint8_t)crc);
+        memcpy(f.data, &w[i + h], f.len);
+        fn(&f, user);
+        got++;
+        i += h + 2u + f.len;
+    }
+    return got;
+}
+
+/* Kablodaki frame'leri sırayla fn'e verir ve kabloyu temizler */
+static inline uint32_t io_wire_frames(io_frame_fn_t fn, void *user)
+{
+    size_t n;
+    const uint8_t *w = zsim_uart_wire(&n);
+    uint32_t got = io_split_frames(w, n, fn, user);
+
+    zsim_uart_wire_clear();
+    return got;
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+/* zsim: tek UART düğümü (uart-com), custom,uart-io örneği yok. Okunan
+ * özellikler açıkça listelenir; ZSIM_DT_HW_FLOW_CONTROL=1 ile düğüm
+ * hw-flow-control'lü olur. */
+
+#ifndef ZSIM_DT_HW_FLOW_CONTROL
+#define ZSIM_DT_HW_FLOW_CONTROL 0
+#endif
+
+#define ZSIM_DT_current_speed(default_value)   (default_value)
+#define ZSIM_DT_hw_flow_control(default_value) ZSIM_DT_HW_FLOW_CONTROL
+
+#define DT_ALIAS(alias)                       zsim_uart
+#define DT_PROP_OR(node, prop, default_value) ZSIM_DT_##prop(default_value)
+#define DT_HAS_COMPAT_STATUS_OKAY(compat)     0
@@ -0,0 +1,254 @@
+#pragma once
+
+/* zsim: UART katmanının kaynaklarını değiştirmeden host'ta koşturmak için
+ * Zephyr çekirdeğinin tek thread'lik, simüle zamanlı modeli.
+ *
+ * Zaman yalnızca biri beklerken (k_sem_take, k_msleep, bekleyen slab/msgq,
+ * zsim_run) ilerler; bekleme sırasında önce işi olan work queue'lar (öncelik
+ * sırasıyla), sonra zamanı gelen olaylar (timer, sürücü modelleri) ISR bağlamında
+ * çalışır. Hiçbir şey kalmadığı halde K_FOREVER beklenirse test "deadlock" ile
+ * durur. ISR'de, spinlock veya irq_lock altında bekleme de aynı şekilde durur. */
+
+#include <errno.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/sys/util.h>
+
+void zsim_fatal(const char *fmt, ...) __attribute__((format(printf, 1, 2), noreturn));
+
+#define __ASSERT(cond, msg)                                                    \
+    do                                                                         \
+    {                                                                          \
+        if (!(cond))                                                           \
+            zsim_fatal("%s:%d: ASSERT(%s) %s", __FILE__, __LINE__, #cond, msg); \
+    } while (0)
+#define __ASSERT_NO_MSG(cond) __ASSERT(cond, "")
+
+/* ---- zaman: ns, simüle ---- */
+typedef struct
+{
+    int64_t ns; /* -1: sonsuz */
+} k_timeout_t;
+
+#define K_NO_WAIT        ((k_timeout_t){0})
+#define K_FOREVER        ((k_timeout_t){-1})
+#define K_NSEC(t)        ((k_timeout_t){(int64_t)(t)})
+#define K_USEC(t)        ((k_timeout_t){(int64_t)(t) * 1000})
+#define K_MSEC(t)        ((k_timeout_t){(int64_t)(t) * 1000000})
+#define K_SECONDS(t)     ((k_timeout_t){(int64_t)(t) * 1000000000})
+#define K_TIMEOUT_EQ(a, b) ((a).ns == (b).ns)
+
+#define USEC_PER_SEC     1000000u
+#define MSEC_PER_SEC     1000u
+#define SYS_FOREVER_MS   (-1)
+#define K_SEM_MAX_LIMIT  UINT_MAX
+
+#define ZSIM_CYC_PER_SEC 64000000u
+
+int64_t zsim_now_ns(void);
+
+static inline uint32_t k_uptime_get_32(void) { return (uint32_t)(zsim_now_ns() / 1000000); }
+static inline int64_t k_uptime_get(void) { return zsim_now_ns() / 1000000; }
+static inline uint32_t k_cycle_get_32(void) { return (uint32_t)(zsim_now_ns() * (ZSIM_CYC_PER_SEC / 1000000u) / 1000); }
+static inline uint32_t sys_clock_hw_cycles_per_sec(void) { return ZSIM_CYC_PER_SEC; }
+static inline uint32_t k_us_to_cyc_ceil32(uint32_t us) { return us * (ZSIM_CYC_PER_SEC / USEC_PER_SEC); }
+
+int32_t k_msleep(int32_t ms);
+int32_t k_usleep(int32_t us);
+
+/* ---- kesme ve spinlock ---- */
+unsigned int irq_lock(void);
+void irq_unlock(unsigned int key);
+bool k_is_in_isr(void);
+
+struct k_spinlock
+{
+    bool locked;
+};
+
+typedef struct
+{
+    int key;
+} k_spinlock_key_t;
+
+k_spinlock_key_t k_spin_lock(struct k_spinlock *l);
+void k_spin_unlock(struct k_spinlock *l, k_spinlock_key_t key);
+
+/* ---- olay: zamanı gelince ISR bağlamında fn(arg) ---- */
+struct zsim_event
+{
+    int64_t at;
+    uint64_t seq;
+    bool armed;
+    bool registered;
+    void (*fn)(void *arg);
+    void *arg;
+};
+
+void zsim_event_init(struct zsim_event *ev, void (*fn)(void *), void *arg);
+void zsim_event_at(struct zsim_event *ev, int64_t at_ns);
+void zsim_event_cancel(struct zsim_event *ev);
+
+/* ---- sabit bloklu havuz ---- */
+struct k_mem_slab
+{
+    char *buffer;
+    size_t block_size;
+    uint32_t num_blocks, num_used;
+    void *free_list;
+    bool inited;
+};
+
+/* Bloklar 8 bayta yuvarlanır: host'ta işaretçi ve uint64 hizası */
+#define K_MEM_SLAB_DEFINE_STATIC(name, bsize, num, align)                      \
+    static char _k_mem_slab_buf_##name[(num) * ROUND_UP(bsize, 8)] __aligned(8); \
+    static struct k_mem_slab name = {                                          \
+        .buffer = _k_mem_slab_buf_##name, .block_size = ROUND_UP(bsize, 8), .num_blocks = (num)}
+
+int k_mem_slab_init(struct k_mem_slab *slab, void *buffer, size_t block_size, uint32_t num_blocks);
+int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout);
+void k_mem_slab_free(struct k_mem_slab *slab, void *mem);
+uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab);
+
+/* ---- mesaj kuyruğu ---- */
+struct k_msgq
+{
+    char *buffer;
+    size_t msg_size;
+    uint32_t max_msgs, read, used;
+};
+
+#define K_MSGQ_DEFINE(name, msize, max, align)                                 \
+    static char _k_msgq_buf_##name[(msize) * (max)] __aligned(8);              \
+    struct k_msgq name = {.buffer = _k_msgq_buf_##name, .msg_size = (msize), .max_msgs = (max)}
+
+void k_msgq_init(struct k_msgq *q, char *buffer, size_t msg_size, uint32_t max_msgs);
+int k_msgq_put(struct k_msgq *q, const void *data, k_timeout_t timeout);
+int k_msgq_get(struct k_msgq *q, void *data, k_timeout_t timeout);
+uint32_t k_msgq_num_used_get(struct k_msgq *q);
+
+/* ---- semafor ve mutex ---- */
+struct k_sem
+{
+    unsigned int count, limit;
+};
+
+#define K_SEM_DEFINE(name, initial, max) struct k_sem name = {.count = (initial), .limit = (max)}
+
+int k_sem_init(struct k_sem *sem, unsigned int initial, unsigned int limit);
+int k_sem_take(struct k_sem *sem, k_timeout_t timeout);
+void k_sem_give(struct k_sem *sem);
+void k_sem_reset(struct k_sem *sem);
+unsigned int k_sem_count_get(struct k_sem *sem);
+
+struct k_mutex
+{
+    const void *owner;
+    unsigned int lock_count;
+};
+
+#define K_MUTEX_DEFINE(name) struct k_mutex name = {0}
+
+int k_mutex_init(struct k_mutex *m);
+int k_mutex_lock(struct k_mutex *m, k_timeout_t timeout);
+int k_mutex_unlock(struct k_mutex *m);
+
+/* ---- timer ---- */
+struct k_timer;
+typedef void (*k_timer_expiry_t)(struct k_timer *timer);
+typedef void (*k_timer_stop_t)(struct k_timer *timer);
+
+struct k_timer
+{
+    struct zsim_event ev;
+    k_timer_expiry_t expiry;
+    k_timer_stop_t stop;
+    int64_t period_ns;
+};
+
+void k_timer_init(struct k_timer *t, k_timer_expiry_t expiry, k_timer_stop_t stop);
+void k_timer_start(struct k_timer *t, k_timeout_t duration, k_timeout_t period);
+void k_timer_stop(struct k_timer *t);
+
+/* ---- iş kuyrukları ---- */
+#define K_THREAD_STACK_DEFINE(sym, size) static char sym[size]
+#define K_THREAD_STACK_SIZEOF(sym)       sizeof(sym)
+#define K_PRIO_COOP(x)                   (-16 + (x))
+#define K_PRIO_PREEMPT(x)                (x)
+
+struct k_work;
+typedef void (*k_work_handler_t)(struct k_work *work);
+
+struct k_work
+{
+    k_work_handler_t handler;
+    struct k_work *next;
+    bool pending;
+};
+
+struct k_work_q
+{
+    const char *name;
+    int prio;
+    bool started;
+    bool active; /* handler çalışıyor (iç içe beklemede tekrar girilmez) */
+    struct k_work *head, **tail;
+    struct k_work_q *next;
+};
+
+struct k_work_queue_config
+{
+    const char *name;
+    bool no_yield;
+};
+
+void k_work_init(struct k_work *work, k_work_handler_t handler);
+int k_work_submit_to_queue(struct k_work_q *q, struct k_work *work);
+void k_work_queue_init(struct k_work_q *q);
+void k_work_queue_start(struct k_work_q *q, char *stack, size_t stack_size, int prio,
+                        const struct k_work_queue_config *cfg);
+
+/* Sistem iş kuyruğu (CONFIG_SYSTEM_WORKQUEUE_PRIORITY=-1); ilk gönderimde başlar */
+extern struct k_work_q k_sys_work_q;
+int k_work_submit(struct k_work *work);
+
+/* ---- k_poll / k_work_poll: yalnız MSGQ_DATA_AVAILABLE ---- */
+enum
+{
+    K_POLL_TYPE_MSGQ_DATA_AVAILABLE = 1,
+};
+enum
+{
+    K_POLL_MODE_NOTIFY_ONLY = 0,
+};
+
+struct k_poll_event
+{
+    int type;
+    int mode;
+    void *obj;
+};
+
+struct k_work_poll
+{
+    struct k_work work;
+    struct k_work_q *q;
+    struct k_poll_event *events;
+    int num_events;
+    bool armed;
+    bool registered;
+    struct k_work_poll *next;
+};
+
+void k_poll_event_init(struct k_poll_event *ev, uint32_t type, int mode, void *obj);
+void k_work_poll_init(struct k_work_poll *wp, k_work_handler_t handler);
+int k_work_poll_submit_to_queue(struct k_work_q *q, struct k_work_poll *wp, struct k_poll_event *events,
+                                int num_events, k_timeout_t timeout);
+int k_work_poll_submit(struct k_work_poll *wp, struct k_poll_event *events, int num_events,
+                       k_timeout_t timeout);
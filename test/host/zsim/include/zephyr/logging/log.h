@@ -0,0 +1,21 @@
+#pragma once
+
+/* zsim: log satırları yalnızca zsim_log_level'e göre stdout'a */
+
+#define LOG_LEVEL_NONE 0
+#define LOG_LEVEL_ERR  1
+#define LOG_LEVEL_WRN  2
+#define LOG_LEVEL_INF  3
+#define LOG_LEVEL_DBG  4
+
+#define LOG_MODULE_REGISTER(...)
+#define LOG_MODULE_DECLARE(...)
+
+void zsim_log(int level, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+
+#define LOG_ERR(...) zsim_log(LOG_LEVEL_ERR, __VA_ARGS__)
+#define LOG_WRN(...) zsim_log(LOG_LEVEL_WRN, __VA_ARGS__)
+#define LOG_INF(...) zsim_log(LOG_LEVEL_INF, __VA_ARGS__)
+#define LOG_DBG(...) zsim_log(LOG_LEVEL_DBG, __VA_ARGS__)
+#define LOG_HEXDUMP_INF(data, len, str) ((void)(data), (void)(len), (void)(str))
+#define LOG_HEXDUMP_DBG(data, len, str) ((void)(data), (void)(len), (void)(str))
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <stdint.h>
+
+static inline void sys_put_be16(uint16_t v, uint8_t dst[2])
+{
+    dst[0] = (uint8_t)(v >> 8);
+    dst[1] = (uint8_t)v;
+}
+
+static inline uint16_t sys_get_be16(const uint8_t src[2])
+{
+    return (uint16_t)((src[0] << 8) | src[1]);
+}
+
+static inline void sys_put_be32(uint32_t v, uint8_t dst[4])
+{
+    sys_put_be16((uint16_t)(v >> 16), &dst[0]);
+    sys_put_be16((uint16_t)v, &dst[2]);
+}
+
+static inline uint32_t sys_get_be32(const uint8_t src[4])
+{
+    return ((uint32_t)sys_get_be16(&src[0]) << 16) | sys_get_be16(&src[2]);
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+/* zsim: Zephyr ring_buf'ın bayt API'si, aynı claim/finish kurallarıyla:
+ * get_finish claim edilenden fazlasını bitiremez (-EINVAL), claim edilmiş ama
+ * bitirilmemiş baytlar yazılamaz. */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+struct ring_buf
+{
+    uint8_t *buffer;
+    uint32_t size;
+    uint32_t head;        /* okuma, mutlak */
+    uint32_t tail;        /* yazma, mutlak */
+    uint32_t get_claimed; /* head'den itibaren claim edilen */
+    uint32_t put_claimed; /* tail'den itibaren claim edilen */
+};
+
+#define RING_BUF_DECLARE(name, size8)                                          \
+    static uint8_t _ring_buf_mem_##name[size8];                                \
+    struct ring_buf name = {.buffer = _ring_buf_mem_##name, .size = (size8)}
+
+void ring_buf_init(struct ring_buf *rb, uint32_t size, uint8_t *data);
+void ring_buf_reset(struct ring_buf *rb);
+uint32_t ring_buf_size_get(struct ring_buf *rb);
+uint32_t ring_buf_space_get(struct ring_buf *rb);
+uint32_t ring_buf_capacity_get(struct ring_buf *rb);
+bool ring_buf_is_empty(struct ring_buf *rb);
+uint32_t ring_buf_put(struct ring_buf *rb, const uint8_t *data, uint32_t size);
+uint32_t ring_buf_get(struct ring_buf *rb, uint8_t *data, uint32_t size);
+uint32_t ring_buf_put_claim(struct ring_buf *rb, uint8_t **data, uint32_t size);
+int ring_buf_put_finish(struct ring_buf *rb, uint32_t size);
+uint32_t ring_buf_get_claim(struct ring_buf *rb, uint8_t **data, uint32_t size);
+int ring_buf_get_finish(struct ring_buf *rb, uint32_t size);
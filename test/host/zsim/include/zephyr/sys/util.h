@@ -0,0 +1,33 @@
+#pragma once
+
+/* zsim: Zephyr sys/util.h'nin host testlerinde kullanılan kadarı */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define BUILD_ASSERT(expr, ...) _Static_assert(expr, "" __VA_ARGS__)
+
+#define IS_ENABLED(config_macro)         Z_IS_ENABLED1(config_macro)
+#define Z_IS_ENABLED1(config_macro)      Z_IS_ENABLED2(_XXXX##config_macro)
+#define _XXXX1                           _YYYY,
+#define Z_IS_ENABLED2(one_or_two_args)   Z_IS_ENABLED3(one_or_two_args 1, 0)
+#define Z_IS_ENABLED3(ignore_this, val, ...) val
+
+#define ARG_UNUSED(x)             (void)(x)
+#define ARRAY_SIZE(a)             (sizeof(a) / sizeof((a)[0]))
+#define MIN(a, b)                 (((a) < (b)) ? (a) : (b))
+#define MAX(a, b)                 (((a) > (b)) ? (a) : (b))
+#define CLAMP(v, lo, hi)          MIN(MAX(v, lo), hi)
+#define DIV_ROUND_UP(n, d)        (((n) + (d) - 1) / (d))
+#define ROUND_UP(x, align)        (DIV_ROUND_UP((x), (align)) * (align))
+#define BIT(n)                    (1UL << (n))
+#define CONTAINER_OF(ptr, type, field) ((type *)(((char *)(ptr)) - offsetof(type, field)))
+
+#define __packed                  __attribute__((__packed__))
+#define __aligned(x)              __attribute__((__aligned__(x)))
+#define __noinit
+
+static inline unsigned int find_msb_set(uint32_t x)
+{
+    return x ? 32u - (unsigned int)__builtin_clz(x) : 0u;
+}
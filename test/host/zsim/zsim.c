@@ -0,0 +1,1112 @@
+/* zsim: simüle Zephyr çekirdeği (zaman, iş kuyrukları, senkronizasyon),
+ * ring_buf ve tek UART'ın async sürücü modeli. Tek host thread'i: "eşzamanlılık"
+ * yalnızca bekleme noktalarında araya giren iş ve olaylardır. */
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/uart.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/ring_buffer.h>
+
+#include "zsim.h"
+
+#define ZSIM_EVENTS_MAX 64
+#define ZSIM_LINE_MAX   (1u << 18)
+#define ZSIM_WIRE_MAX   (1u << 18)
+
+static int64_t now_ns;
+static int isr_depth, irq_depth, spin_depth;
+static const char main_ctx[] = "main";
+static const void *cur_ctx = main_ctx; /* main ya da çalışan k_work_q */
+
+static struct zsim_event *events[ZSIM_EVENTS_MAX];
+static size_t nevents;
+static uint64_t event_seq;
+static struct k_work_q *queues;
+static struct k_work_poll *polls;
+
+int zsim_log_level = -1;
+
+void zsim_fatal(const char *fmt, ...)
+{
+    va_list ap;
+    va_start(ap, fmt);
+    fprintf(stderr, "zsim @%lld ns: ", (long long)now_ns);
+    vfprintf(stderr, fmt, ap);
+    fputc('\n', stderr);
+    va_end(ap);
+    abort();
+}
+
+void zsim_log(int level, const char *fmt, ...)
+{
+    if (zsim_log_level < 0)
+    {
+        const char *e = getenv("ZSIM_LOG");
+        zsim_log_level = e ? atoi(e) : LOG_LEVEL_NONE;
+    }
+    if (level > zsim_log_level)
+        return;
+
+    va_list ap;
+    va_start(ap, fmt);
+    printf("[%9.3f ms] ", (double)now_ns / 1e6);
+    vprintf(fmt, ap);
+    putchar('\n');
+    va_end(ap);
+}
+
+int64_t zsim_now_ns(void)
+{
+    return now_ns;
+}
+
+/* ============================================ * olaylar * ============================================*/
+
+void zsim_event_init(struct zsim_event *ev, void (*fn)(void *), void *arg)
+{
+    ev->fn = fn;
+    ev->arg = arg;
+    ev->armed = false;
+    if (ev->registered)
+        return;
+    if (nevents == ZSIM_EVENTS_MAX)
+        zsim_fatal("too many events");
+    events[nevents++] = ev;
+    ev->registered = true;
+}
+
+void zsim_event_at(struct zsim_event *ev, int64_t at_ns)
+{
+    ev->at = at_ns;
+    ev->seq = ++event_seq;
+    ev->armed = true;
+}
+
+void zsim_event_cancel(struct zsim_event *ev)
+{
+    ev->armed = false;
+}
+
+static struct zsim_event *event_next(void)
+{
+    struct zsim_event *best = NULL;
+
+    for (size_t i = 0; i < nevents; i++)
+    {
+        struct zsim_event *ev = events[i];
+        if (ev->armed && (!best || ev->at < best->at || (ev->at == best->at && ev->seq < best->seq)))
+            best = ev;
+    }
+    return best;
+}
+
+static void event_fire(struct zsim_event *ev)
+{
+    if (ev->at > now_ns)
+        now_ns = ev->at;
+    ev->armed = false;
+    isr_depth++;
+    ev->fn(ev->arg);
+    isr_depth--;
+}
+
+/* ============================================ * zamanlayıcı * ============================================*/
+
+static bool poll_ready(const struct k_work_poll *wp)
+{
+    for (int i = 0; i < wp->num_events; i++)
+        if (wp->events[i].type == K_POLL_TYPE_MSGQ_DATA_AVAILABLE && k_msgq_num_used_get(wp->events[i].obj))
+            return true;
+    return false;
+}
+
+/* Çalışmayan kuyruklardan en yüksek öncelikli (küçük sayı) işi çalıştır */
+static bool run_one_work(void)
+{
+    for (struct k_work_poll *wp = polls; wp; wp = wp->next)
+    {
+        if (wp->armed && poll_ready(wp))
+        {
+            wp->armed = false;
+            k_work_submit_to_queue(wp->q, &wp->work);
+        }
+    }
+
+    struct k_work_q *q = NULL;
+    for (struct k_work_q *c = queues; c; c = c->next)
+        if (!c->active && c->head && (!q || c->prio < q->prio))
+            q = c;
+    if (!q)
+        return false;
+
+    struct k_work *w = q->head;
+    q->head = w->next;
+    if (!q->head)
+        q->tail = &q->head;
+    w->pending = false;
+
+    const void *prev = cur_ctx;
+    q->active = true;
+    cur_ctx = q;
+    w->handler(w);
+    cur_ctx = prev;
+    q->active = false;
+    return true;
+}
+
+bool zsim_wait(bool (*cond)(void *arg), void *arg, k_timeout_t timeout)
+{
+    int64_t deadline = timeout.ns < 0 ? -1 : now_ns + timeout.ns;
+
+    for (;;)
+    {
+        if (cond && cond(arg))
+            return true;
+        if (deadline >= 0 && now_ns >= deadline)
+            return false;
+        if (isr_depth || spin_depth || irq_depth)
+            zsim_fatal("blocking wait in %s", isr_depth ? "ISR" : spin_depth ? "spinlock" : "irq_lock");
+        if (run_one_work())
+            continue;
+
+        struct zsim_event *ev = event_next();
+        if (ev && (deadline < 0 || ev->at <= deadline))
+        {
+            event_fire(ev);
+            continue;
+        }
+        if (deadline >= 0)
+        {
+            now_ns = deadline;
+            continue;
+        }
+        zsim_fatal("deadlock: waiting forever in %s with no pending work or events",
+                   cur_ctx == main_ctx ? "main" : ((const struct k_work_q *)cur_ctx)->name);
+    }
+}
+
+void zsim_run_idle(void)
+{
+    for (;;)
+    {
+        if (run_one_work())
+            continue;
+        struct zsim_event *ev = event_next();
+        if (!ev)
+            return;
+        event_fire(ev);
+    }
+}
+
+int32_t k_msleep(int32_t ms)
+{
+    zsim_wait(NULL, NULL, K_MSEC(ms));
+    return 0;
+}
+
+int32_t k_usleep(int32_t us)
+{
+    zsim_wait(NULL, NULL, K_USEC(us));
+    return 0;
+}
+
+/* ============================================ * kilitler * ============================================*/
+
+unsigned int irq_lock(void)
+{
+    return (unsigned int)irq_depth++;
+}
+
+void irq_unlock(unsigned int key)
+{
+    if (--irq_depth != (int)key)
+        zsim_fatal("irq_unlock out of order");
+}
+
+bool k_is_in_isr(void)
+{
+    return isr_depth > 0;
+}
+
+k_spinlock_key_t k_spin_lock(struct k_spinlock *l)
+{
+    if (l->locked)
+        zsim_fatal("spinlock %p taken recursively", (void *)l);
+    l->locked = true;
+    return (k_spinlock_key_t){spin_depth++};
+}
+
+void k_spin_unlock(struct k_spinlock *l, k_spinlock_key_t key)
+{
+    if (!l->locked || --spin_depth != key.key)
+        zsim_fatal("spinlock %p released out of order", (void *)l);
+    l->locked = false;
+}
+
+/* ============================================ * havuz, kuyruk, semafor, mutex * ============================================*/
+
+int k_mem_slab_init(struct k_mem_slab *slab, void *buffer, size_t block_size, uint32_t num_blocks)
+{
+    if (block_size < sizeof(void *) || block_size % sizeof(void *))
+        return -EINVAL;
+    slab->buffer = buffer;
+    slab->block_size = block_size;
+    slab->num_blocks = num_blocks;
+    slab->num_used = 0;
+    slab->free_list = NULL;
+    for (uint32_t i = num_blocks; i-- > 0;)
+    {
+        void *blk = slab->buffer + i * block_size;
+        memcpy(blk, &slab->free_list, sizeof(void *));
+        slab->free_list = blk;
+    }
+    slab->inited = true;
+    return 0;
+}
+
+static bool slab_has_free(void *arg)
+{
+    return ((struct k_mem_slab *)arg)->free_list != NULL;
+}
+
+int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
+{
+    if (!slab->inited)
+        k_mem_slab_init(slab, slab->buffer, slab->block_size, slab->num_blocks);
+    if (!zsim_wait(slab_has_free, slab, timeout))
+    {
+        *mem = NULL;
+        return timeout.ns == 0 ? -ENOMEM : -EAGAIN;
+    }
+    *mem = slab->free_list;
+    memcpy(&slab->free_list, *mem, sizeof(void *));
+    slab->num_used++;
+    return 0;
+}
+
+void k_mem_slab_free(struct k_mem_slab *slab, void *mem)
+{
+    size_t off = (size_t)((char *)mem - slab->buffer);
+    if (!slab->inited || off >= (size_t)slab->num_blocks * slab->block_size || off % slab->block_size)
+        zsim_fatal("k_mem_slab_free: %p is not a block of slab %p", mem, (void *)slab);
+    if (!slab->num_used)
+        zsim_fatal("k_mem_slab_free: slab %p double free", (void *)slab);
+    memcpy(mem, &slab->free_list, sizeof(void *));
+    slab->free_list = mem;
+    slab->num_used--;
+}
+
+uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
+{
+    return slab->num_blocks - slab->num_used;
+}
+
+void k_msgq_init(struct k_msgq *q, char *buffer, size_t msg_size, uint32_t max_msgs)
+{
+    q->buffer = buffer;
+    q->msg_size = msg_size;
+    q->max_msgs = max_msgs;
+    q->read = q->used = 0;
+}
+
+static bool msgq_has_space(void *arg)
+{
+    struct k_msgq *q = arg;
+    return q->used < q->max_msgs;
+}
+
+static bool msgq_has_data(void *arg)
+{
+    return ((struct k_msgq *)arg)->used > 0;
+}
+
+int k_msgq_put(struct k_msgq *q, const void *data, k_timeout_t timeout)
+{
+    if (!zsim_wait(msgq_has_space, q, timeout))
+        return timeout.ns == 0 ? -ENOMSG : -EAGAIN;
+    memcpy(&q->buffer[((q->read + q->used) % q->max_msgs) * q->msg_size], data, q->msg_size);
+    q->used++;
+    return 0;
+}
+
+int k_msgq_get(struct k_msgq *q, void *data, k_timeout_t timeout)
+{
+    if (!zsim_wait(msgq_has_data, q, timeout))
+        return timeout.ns == 0 ? -ENOMSG : -EAGAIN;
+    memcpy(data, &q->buffer[q->read * q->msg_size], q->msg_size);
+    q->read = (q->read + 1) % q->max_msgs;
+    q->used--;
+    return 0;
+}
+
+uint32_t k_msgq_num_used_get(struct k_msgq *q)
+{
+    return q->used;
+}
+
+int k_sem_init(struct k_sem *sem, unsigned int initial, unsigned int limit)
+{
+    sem->count = initial;
+    sem->limit = limit;
+    return 0;
+}
+
+static bool sem_available(void *arg)
+{
+    return ((struct k_sem *)arg)->count > 0;
+}
+
+int k_sem_take(struct k_sem *sem, k_timeout_t timeout)
+{
+    if (!zsim_wait(sem_available, sem, timeout))
+        return timeout.ns == 0 ? -EBUSY : -EAGAIN;
+    sem->count--;
+    return 0;
+}
+
+void k_sem_give(struct k_sem *sem)
+{
+    if (sem->count < sem->limit)
+        sem->count++;
+}
+
+void k_sem_reset(struct k_sem *sem)
+{
+    sem->count = 0;
+}
+
+unsigned int k_sem_count_get(struct k_sem *sem)
+{
+    return sem->count;
+}
+
+int k_mutex_init(struct k_mutex *m)
+{
+    m->owner = NULL;
+    m->lock_count = 0;
+    return 0;
+}
+
+static bool mutex_free(void *arg)
+{
+    return ((struct k_mutex *)arg)->owner == NULL;
+}
+
+int k_mutex_lock(struct k_mutex *m, k_timeout_t timeout)
+{
+    if (isr_depth)
+        zsim_fatal("k_mutex_lock in ISR");
+    if (m->owner == cur_ctx)
+    {
+        m->lock_count++;
+        return 0;
+    }
+    if (!zsim_wait(mutex_free, m, timeout))
+        return timeout.ns == 0 ? -EBUSY : -EAGAIN;
+    m->owner = cur_ctx;
+    m->lock_count = 1;
+    return 0;
+}
+
+int k_mutex_unlock(struct k_mutex *m)
+{
+    if (m->owner != cur_ctx)
+        return -EPERM;
+    if (--m->lock_count == 0)
+        m->owner = NULL;
+    return 0;
+}
+
+/* ============================================ * timer * ============================================*/
+
+static void timer_fire(void *arg)
+{
+    struct k_timer *t = arg;
+
+    if (t->period_ns > 0)
+        zsim_event_at(&t->ev, now_ns + t->period_ns);
+    if (t->expiry)
+        t->expiry(t);
+}
+
+void k_timer_init(struct k_timer *t, k_timer_expiry_t expiry, k_timer_stop_t stop)
+{
+    t->expiry = expiry;
+    t->stop = stop;
+    t->period_ns = 0;
+    zsim_event_init(&t->ev, timer_fire, t);
+}
+
+void k_timer_start(struct k_timer *t, k_timeout_t duration, k_timeout_t period)
+{
+    t->period_ns = period.ns > 0 ? period.ns : 0;
+    zsim_event_at(&t->ev, now_ns + MAX(duration.ns, 0));
+}
+
+void k_timer_stop(struct k_timer *t)
+{
+    bool was = t->ev.armed;
+    zsim_event_cancel(&t->ev);
+    if (was && t->stop)
+        t->stop(t);
+}
+
+/* ============================================ * iş kuyrukları * ============================================*/
+
+void k_work_init(struct k_work *work, k_work_handler_t handler)
+{
+    memset(work, 0, sizeof(*work));
+    work->handler = handler;
+}
+
+struct k_work_q k_sys_work_q;
+
+/* Zephyr'de açılışta başlar; burada ilk kullanımda */
+static struct k_work_q *sys_work_q(void)
+{
+    static const struct k_work_queue_config cfg = {.name = "sysworkq"};
+
+    if (!k_sys_work_q.started)
+    {
+        k_work_queue_init(&k_sys_work_q);
+        k_work_queue_start(&k_sys_work_q, NULL, 0, -1, &cfg);
+    }
+    return &k_sys_work_q;
+}
+
+int k_work_submit_to_queue(struct k_work_q *q, struct k_work *work)
+{
+    if (q == &k_sys_work_q)
+        q = sys_work_q();
+    if (!q->started)
+        zsim_fatal("work submitted to a queue that was not started");
+    if (work->pending)
+        return 0;
+    work->pending = true;
+    work->next = NULL;
+    *q->tail = work;
+    q->tail = &work->next;
+    return 1;
+}
+
+void k_work_queue_init(struct k_work_q *q)
+{
+    memset(q, 0, sizeof(*q));
+    q->tail = &q->head;
+}
+
+void k_work_queue_start(struct k_work_q *q, char *stack, size_t stack_size, int prio,
+                        const struct k_work_queue_config *cfg)
+{
+    ARG_UNUSED(stack);
+    ARG_UNUSED(stack_size);
+    q->name = cfg && cfg->name ? cfg->name : "workq";
+    q->prio = prio;
+    q->started = true;
+    q->next = queues;
+    queues = q;
+}
+
+int k_work_submit(struct k_work *work)
+{
+    return k_work_submit_to_queue(sys_work_q(), work);
+}
+
+void k_poll_event_init(struct k_poll_event *ev, uint32_t type, int mode, void *obj)
+{
+    ev->type = (int)type;
+    ev->mode = mode;
+    ev->obj = obj;
+}
+
+void k_work_poll_init(struct k_work_poll *wp, k_work_handler_t handler)
+{
+    k_work_init(&wp->work, handler);
+    wp->armed = false;
+    if (!wp->registered)
+    {
+        wp->next = polls;
+        polls = wp;
+        wp->registered = true;
+    }
+}
+
+int k_work_poll_submit_to_queue(struct k_work_q *q, struct k_work_poll *wp, struct k_poll_event *events,
+                                int num_events, k_timeout_t timeout)
+{
+    ARG_UNUSED(timeout);
+    wp->q = q == &k_sys_work_q ? sys_work_q() : q;
+    wp->events = events;
+    wp->num_events = num_events;
+    wp->armed = true;
+    return 0;
+}
+
+
+int k_work_poll_submit(struct k_work_poll *wp, struct k_poll_event *events, int num_events,
+                       k_timeout_t timeout)
+{
+    return k_work_poll_submit_to_queue(sys_work_q(), wp, events, num_events, timeout);
+}
+
+/* ============================================ * ring_buf * ============================================*/
+
+static void (*rb_get_hook)(void *arg);
+static void *rb_get_hook_arg;
+
+void zsim_ring_buf_get_hook(void (*fn)(void *arg), void *arg)
+{
+    rb_get_hook = fn;
+    rb_get_hook_arg = arg;
+}
+
+void ring_buf_init(struct ring_buf *rb, uint32_t size, uint8_t *data)
+{
+    rb->buffer = data;
+    rb->size = size;
+    rb->get_claimed = rb->put_claimed = 0;
+    ring_buf_reset(rb);
+}
+
+void ring_buf_reset(struct ring_buf *rb)
+{
+    /* Zephyr: okuyucu veya yazıcı ortasındayken sıfırlama tanımsız */
+    if (rb->get_claimed || rb->put_claimed)
+        zsim_fatal("ring_buf_reset with an outstanding claim");
+    rb->head = rb->tail = 0;
+    rb->get_claimed = rb->put_claimed = 0;
+}
+
+uint32_t ring_buf_capacity_get(struct ring_buf *rb)
+{
+    return rb->size;
+}
+
+/* Zephyr gibi: claim edilmiş veri "okunmuş", bitirilmemiş yer "dolu" sayılır */
+uint32_t ring_buf_size_get(struct ring_buf *rb)
+{
+    return rb->tail - rb->head - rb->get_claimed;
+}
+
+uint32_t ring_buf_space_get(struct ring_buf *rb)
+{
+    return rb->size - (rb->tail + rb->put_claimed - rb->head);
+}
+
+bool ring_buf_is_empty(struct ring_buf *rb)
+{
+    return rb->tail == rb->head;
+}
+
+uint32_t ring_buf_put_claim(struct ring_buf *rb, uint8_t **data, uint32_t size)
+{
+    uint32_t pos = rb->tail + rb->put_claimed;
+    uint32_t idx = pos % rb->size;
+    uint32_t n = MIN(MIN(size, ring_buf_space_get(rb)), rb->size - idx);
+
+    *data = &rb->buffer[idx];
+    rb->put_claimed += n;
+    return n;
+}
+
+int ring_buf_put_finish(struct ring_buf *rb, uint32_t size)
+{
+    if (size > rb->put_claimed)
+        return -EINVAL;
+    rb->tail += size;
+    rb->put_claimed = 0;
+    return 0;
+}
+
+uint32_t ring_buf_get_claim(struct ring_buf *rb, uint8_t **data, uint32_t size)
+{
+    uint32_t pos = rb->head + rb->get_claimed;
+    uint32_t idx = pos % rb->size;
+    uint32_t n = MIN(MIN(size, rb->tail - pos), rb->size - idx);
+
+    *data = &rb->buffer[idx];
+    rb->get_claimed += n;
+
+    /* Claim tutulurken kesme: spinlock altında ve ISR içinde gelmez */
+    if (n && rb_get_hook && !spin_depth && !irq_depth && !isr_depth)
+        rb_get_hook(rb_get_hook_arg);
+    return n;
+}
+
+int ring_buf_get_finish(struct ring_buf *rb, uint32_t size)
+{
+    if (size > rb->get_claimed)
+        return -EINVAL;
+    rb->head += size;
+    rb->get_claimed = 0;
+    return 0;
+}
+
+uint32_t ring_buf_put(struct ring_buf *rb, const uint8_t *data, uint32_t size)
+{
+    uint32_t total = 0;
+
+    while (total < size)
+    {
+        uint8_t *p;
+        uint32_t n = ring_buf_put_claim(rb, &p, size - total);
+        if (!n)
+            break;
+        memcpy(p, &data[total], n);
+        total += n;
+    }
+    (void)ring_buf_put_finish(rb, total);
+    return total;
+}
+
+uint32_t ring_buf_get(struct ring_buf *rb, uint8_t *data, uint32_t size)
+{
+    uint32_t total = 0;
+
+    while (total < size)
+    {
+        uint8_t *p;
+        uint32_t n = ring_buf_get_claim(rb, &p, size - total);
+        if (!n)
+            break;
+        if (data)
+            memcpy(&data[total], p, n);
+        total += n;
+    }
+    (void)ring_buf_get_finish(rb, total);
+    return total;
+}
+
+/* ============================================ * UART modeli * ============================================*/
+
+const struct device zsim_uart_dev = {.name = "zsim_uart"};
+
+static struct
+{
+    uart_callback_t cb;
+    void *user;
+    int64_t char_ns;
+
+    /* TX */
+    bool tx_busy, tx_stuck, loopback;
+    const uint8_t *tx_buf;
+    size_t tx_len;
+    unsigned int tx_fail;
+    int tx_fail_rc;
+    struct zsim_event tx_ev;
+    zsim_uart_sink_t sink;
+    void *sink_user;
+    uint8_t wire[ZSIM_WIRE_MAX];
+    size_t wire_n;
+
+    /* RX */
+    bool rx_on;
+    uint8_t *rx_buf, *rx_next;
+    uint8_t *rx_prev; /* oynatma: NEXT'ten sonra RELEASE bekleyen buffer */
+    size_t rx_len, rx_next_len, rx_pos, rx_rdy;
+    int64_t rx_tmo_ns;
+    struct zsim_event rx_byte_ev, rx_idle_ev;
+    uint8_t line[ZSIM_LINE_MAX];
+    size_t line_head, line_n;
+
+    uint32_t rts;
+    int line_ctrl_rc;
+
+    zsim_uart_stats_t st;
+} u = {.char_ns = 10000000000 / 115200};
+
+static void uart_deliver(struct uart_event *evt)
+{
+    if (!u.cb)
+        zsim_fatal("UART event %d without callback", evt->type);
+    isr_depth++;
+    u.cb(&zsim_uart_dev, evt, u.user);
+    isr_depth--;
+}
+
+static void tx_done_fire(void *arg);
+static void rx_byte_fire(void *arg);
+static void rx_idle_fire(void *arg);
+
+static void uart_model_init(void)
+{
+    if (u.tx_ev.registered)
+        return;
+    zsim_event_init(&u.tx_ev, tx_done_fire, NULL);
+    zsim_event_init(&u.rx_byte_ev, rx_byte_fire, NULL);
+    zsim_event_init(&u.rx_idle_ev, rx_idle_fire, NULL);
+}
+
+int uart_callback_set(const struct device *dev, uart_callback_t callback, void *user_data)
+{
+    ARG_UNUSED(dev);
+    uart_model_init();
+    u.cb = callback;
+    u.user = user_data;
+    return 0;
+}
+
+int uart_tx(const struct device *dev, const uint8_t *buf, size_t len, int32_t timeout)
+{
+    ARG_UNUSED(dev);
+    ARG_UNUSED(timeout);
+    uart_model_init();
+
+    if (spin_depth)
+        zsim_fatal("uart_tx under spinlock");
+    u.st.tx_calls++;
+    if (u.tx_busy)
+    {
+        u.st.tx_busy++;
+        return -EBUSY;
+    }
+    if (u.tx_fail)
+    {
+        u.tx_fail--;
+        u.st.tx_errors++;
+        return u.tx_fail_rc;
+    }
+    u.tx_busy = true;
+    u.tx_buf = buf;
+    u.tx_len = len;
+    if (!u.tx_stuck)
+        zsim_event_at(&u.tx_ev, now_ns + (int64_t)len * u.char_ns);
+    return 0;
+}
+
+static void tx_done_fire(void *arg)
+{
+    ARG_UNUSED(arg);
+    size_t n = MIN(u.tx_len, ZSIM_WIRE_MAX - u.wire_n);
+
+    /* Buffer TX_DONE'da sürücüye döner: önce kopyala */
+    memcpy(&u.wire[u.wire_n], u.tx_buf, n);
+    u.wire_n += n;
+    if (u.sink)
+        u.sink(u.tx_buf, u.tx_len, u.sink_user);
+    if (u.loopback)
+        zsim_uart_feed(u.tx_buf, u.tx_len);
+
+    u.tx_busy = false;
+    u.st.tx_done++;
+    struct uart_event evt = {.type = UART_TX_DONE, .data.tx = {.buf = u.tx_buf, .len = u.tx_len}};
+    uart_deliver(&evt);
+}
+
+int uart_tx_abort(const struct device *dev)
+{
+    ARG_UNUSED(dev);
+    if (!u.tx_busy)
+        return -EFAULT;
+    zsim_event_cancel(&u.tx_ev);
+    u.tx_busy = false;
+    u.st.tx_aborts++;
+    struct uart_event evt = {.type = UART_TX_ABORTED, .data.tx = {.buf = u.tx_buf, .len = 0}};
+    uart_deliver(&evt);
+    return 0;
+}
+
+/* Bildirilmemiş baytlar için artımlı RX_RDY */
+static void rx_flush(void)
+{
+    if (u.rx_pos <= u.rx_rdy)
+        return;
+    struct uart_event evt = {.type = UART_RX_RDY,
+                             .data.rx = {.buf = u.rx_buf, .offset = u.rx_rdy, .len = u.rx_pos - u.rx_rdy}};
+    u.rx_rdy = u.rx_pos;
+    u.st.rx_rdy++;
+    uart_deliver(&evt);
+}
+
+/* RX'i kapat: elde kalan buffer'lar bırakılır, ardından RX_DISABLED */
+static void rx_shutdown(void)
+{
+    uint8_t *cur = u.rx_buf, *nxt = u.rx_next, *prev = u.rx_prev;
+
+    u.rx_on = false;
+    u.rx_buf = u.rx_next = u.rx_prev = NULL;
+    u.rx_pos = u.rx_rdy = 0;
+    zsim_event_cancel(&u.rx_idle_ev);
+
+    struct uart_event evt = {.type = UART_RX_BUF_RELEASED, .data.rx_buf.buf = prev};
+    if (prev)
+        uart_deliver(&evt);
+    evt.data.rx_buf.buf = cur;
+    uart_deliver(&evt);
+    if (nxt)
+    {
+        evt.data.rx_buf.buf = nxt;
+        uart_deliver(&evt);
+    }
+    evt = (struct uart_event){.type = UART_RX_DISABLED};
+    uart_deliver(&evt);
+}
+
+int uart_rx_enable(const struct device *dev, uint8_t *buf, size_t len, int32_t timeout)
+{
+    ARG_UNUSED(dev);
+    uart_model_init();
+    if (u.rx_on)
+        return -EBUSY;
+    u.rx_on = true;
+    u.rx_buf = buf;
+    u.rx_len = len;
+    u.rx_next = NULL;
+    u.rx_pos = u.rx_rdy = 0;
+    u.rx_tmo_ns = timeout < 0 ? -1 : (int64_t)timeout * 1000;
+    u.st.rx_enables++;
+
+    struct uart_event evt = {.type = UART_RX_BUF_REQUEST};
+    uart_deliver(&evt);
+    return 0;
+}
+
+int uart_rx_buf_rsp(const struct device *dev, uint8_t *buf, size_t len)
+{
+    ARG_UNUSED(dev);
+    if (!u.rx_on)
+        return -EACCES;
+    if (u.rx_next)
+        return -EBUSY;
+    u.rx_next = buf;
+    u.rx_next_len = len;
+    return 0;
+}
+
+int uart_rx_disable(const struct device *dev)
+{
+    ARG_UNUSED(dev);
+    if (!u.rx_on)
+        return -EFAULT;
+    zsim_event_cancel(&u.rx_idle_ev);
+    rx_flush();
+    if (u.rx_on)
+        rx_shutdown();
+    return 0;
+}
+
+int uart_line_ctrl_set(const struct device *dev, uint32_t ctrl, uint32_t val)
+{
+    ARG_UNUSED(dev);
+    if (spin_depth)
+        zsim_fatal("uart_line_ctrl_set under spinlock");
+    if (u.line_ctrl_rc)
+        return u.line_ctrl_rc;
+    if (ctrl == UART_LINE_CTRL_RTS)
+        u.rts = val;
+    return 0;
+}
+
+static void rx_buffer_full(void)
+{
+    uint8_t *old = u.rx_buf;
+
+    zsim_event_cancel(&u.rx_idle_ev);
+    rx_flush();
+    if (!u.rx_on || u.rx_buf != old)
+        return; /* callback RX'i kapattı/yeniden açtı */
+
+    if (!u.rx_next)
+    {
+        rx_shutdown();
+        return;
+    }
+    u.rx_buf = u.rx_next;
+    u.rx_len = u.rx_next_len;
+    u.rx_next = NULL;
+    u.rx_pos = u.rx_rdy = 0;
+
+    struct uart_event evt = {.type = UART_RX_BUF_RELEASED, .data.rx_buf.buf = old};
+    uart_deliver(&evt);
+    if (!u.rx_on)
+        return;
+    evt = (struct uart_event){.type = UART_RX_BUF_REQUEST};
+    uart_deliver(&evt);
+}
+
+static void rx_byte_fire(void *arg)
+{
+    ARG_UNUSED(arg);
+    uint8_t b = u.line[u.line_head];
+
+    u.line_head = (u.line_head + 1) % ZSIM_LINE_MAX;
+    u.line_n--;
+    if (u.line_n)
+        zsim_event_at(&u.rx_byte_ev, now_ns + u.char_ns);
+
+    if (!u.rx_on)
+    {
+        u.st.rx_lost++;
+        return;
+    }
+    u.rx_buf[u.rx_pos++] = b;
+    u.st.rx_bytes++;
+    if (u.rx_tmo_ns >= 0)
+        zsim_event_at(&u.rx_idle_ev, now_ns + u.rx_tmo_ns);
+    if (u.rx_pos == u.rx_len)
+        rx_buffer_full();
+}
+
+static void rx_idle_fire(void *arg)
+{
+    ARG_UNUSED(arg);
+    if (u.rx_on)
+        rx_flush();
+}
+
+/* ---- test API'si ---- */
+
+void zsim_uart_set_baud(uint32_t baud)
+{
+    u.char_ns = 10000000000 / baud;
+}
+
+int64_t zsim_uart_char_ns(void)
+{
+    return u.char_ns;
+}
+
+void zsim_uart_tx_fail(unsigned int n, int rc)
+{
+    u.tx_fail = n;
+    u.tx_fail_rc = rc;
+}
+
+void zsim_uart_tx_stuck(bool stuck)
+{
+    u.tx_stuck = stuck;
+    /* Hat açıldı: takılı transfer şimdiden itibaren tamamlanır */
+    if (!stuck && u.tx_busy && !u.tx_ev.armed)
+        zsim_event_at(&u.tx_ev, now_ns + (int64_t)u.tx_len * u.char_ns);
+}
+
+void zsim_uart_set_sink(zsim_uart_sink_t sink, void *user)
+{
+    u.sink = sink;
+    u.sink_user = user;
+}
+
+void zsim_uart_set_loopback(bool on)
+{
+    u.loopback = on;
+}
+
+const uint8_t *zsim_uart_wire(size_t *len)
+{
+    *len = u.wire_n;
+    return u.wire;
+}
+
+void zsim_uart_wire_clear(void)
+{
+    u.wire_n = 0;
+}
+
+void zsim_uart_feed(const uint8_t *buf, size_t len)
+{
+    uart_model_init();
+    if (u.line_n + len > ZSIM_LINE_MAX)
+        zsim_fatal("line buffer overflow");
+    for (size_t i = 0; i < len; i++)
+        u.line[(u.line_head + u.line_n + i) % ZSIM_LINE_MAX] = buf[i];
+    u.line_n += len;
+    if (len && !u.rx_byte_ev.armed)
+        zsim_event_at(&u.rx_byte_ev, now_ns + u.char_ns);
+}
+
+void zsim_uart_rx_error(enum uart_rx_stop_reason reason)
+{
+    if (!u.rx_on)
+        return;
+    zsim_event_cancel(&u.rx_idle_ev);
+    rx_flush();
+    if (!u.rx_on)
+        return;
+    struct uart_event evt = {.type = UART_RX_STOPPED,
+                             .data.rx_stop = {.reason = reason, .data = {.buf = u.rx_buf, .offset = u.rx_rdy}}};
+    uart_deliver(&evt);
+    if (u.rx_on)
+        rx_shutdown();
+}
+
+void zsim_uart_event(struct uart_event *evt)
+{
+    uart_deliver(evt);
+}
+
+size_t zsim_uart_rx_replay(const zsim_rx_rec_t *rec, size_t n, const uint8_t *bytes)
+{
+    size_t used = 0;
+
+    for (size_t i = 0; i < n; i++)
+    {
+        const zsim_rx_rec_t *r = &rec[i];
+        struct uart_event evt;
+
+        if (!u.rx_on && r->op != ZSIM_RX_GAP)
+            zsim_fatal("replay #%zu: RX is off", i);
+        switch (r->op)
+        {
+        case ZSIM_RX_RDY:
+            if (r->offset != u.rx_pos || r->offset + r->len > u.rx_len)
+                zsim_fatal("replay #%zu: RX_RDY %u+%u, buffer at %zu/%zu", i, r->offset, r->len, u.rx_pos,
+                           u.rx_len);
+            memcpy(&u.rx_buf[r->offset], &bytes[used], r->len);
+            used += r->len;
+            u.rx_pos = u.rx_rdy = r->offset + r->len;
+            u.st.rx_bytes += r->len;
+            u.st.rx_rdy++;
+            evt = (struct uart_event){.type = UART_RX_RDY,
+                                      .data.rx = {.buf = u.rx_buf, .offset = r->offset, .len = r->len}};
+            uart_deliver(&evt);
+            break;
+        case ZSIM_RX_NEXT:
+            if (!u.rx_next || u.rx_prev)
+                zsim_fatal("replay #%zu: no next buffer or previous not released", i);
+            u.rx_prev = u.rx_buf;
+            u.rx_buf = u.rx_next;
+            u.rx_len = u.rx_next_len;
+            u.rx_next = NULL;
+            u.rx_pos = u.rx_rdy = 0;
+            break;
+        case ZSIM_RX_RELEASE:
+            if (!u.rx_prev)
+                zsim_fatal("replay #%zu: nothing to release", i);
+            evt = (struct uart_event){.type = UART_RX_BUF_RELEASED, .data.rx_buf.buf = u.rx_prev};
+            u.rx_prev = NULL;
+            uart_deliver(&evt);
+            break;
+        case ZSIM_RX_REQUEST:
+            evt = (struct uart_event){.type = UART_RX_BUF_REQUEST};
+            uart_deliver(&evt);
+            break;
+        case ZSIM_RX_STOP:
+            zsim_uart_rx_error(UART_ERROR_OVERRUN);
+            break;
+        case ZSIM_RX_GAP:
+            zsim_wait(NULL, NULL, K_USEC(r->len));
+            break;
+        }
+    }
+    return used;
+}
+
+uint32_t zsim_uart_rts(void)
+{
+    return u.rts;
+}
+
+void zsim_uart_set_line_ctrl_rc(int rc)
+{
+    u.line_ctrl_rc = rc;
+}
+
+const zsim_uart_stats_t *zsim_uart_stats(void)
+{
+    return &u.st;
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+/* zsim test API'si: simüle zamanı ilerletme ve tek UART'ın (uart-com) hat
+ * modeli. Çekirdek modeli için bkz. include/zephyr/kernel.h.
+ *
+ * UART modeli STM32 async sürücüsü gibi davranır: callback'ler ISR bağlamında
+ * ve uart_tx_abort / uart_rx_enable / uart_rx_disable içinden eşzamanlı gelir.
+ *  TX: len x karakter süresi sonra TX_DONE; meşgulken -EBUSY. Gönderilen baytlar
+ *      "kablo" tamponunda birikir, istenirse sink'e ve loopback'te RX'e gider.
+ *  RX: zsim_uart_feed() baytları karakter süresi arayla hatta koyar. Buffer
+ *      dolunca RX_RDY + RX_BUF_RELEASED, sıradaki buffer yoksa RX_DISABLED;
+ *      inactivity timeout'ta kısmi RX_RDY. RX kapalıyken gelen bayt kaybolur.
+ * uart_tx ve uart_line_ctrl_set spinlock altında çağrılırsa test durur. */
+
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/uart.h>
+
+/* cond sağlanana (true) veya timeout dolana (false) kadar simülasyonu koştur;
+ * cond NULL: timeout kadar */
+bool zsim_wait(bool (*cond)(void *arg), void *arg, k_timeout_t timeout);
+
+/* İş ve olay kalmayana kadar koştur (takılı TX veya periyodik timer varsa dönmez) */
+void zsim_run_idle(void);
+
+/* 0: sessiz (varsayılan), LOG_LEVEL_ERR..DBG; ZSIM_LOG ortam değişkeni de ayarlar */
+extern int zsim_log_level;
+
+typedef struct
+{
+    uint32_t tx_calls;   /* uart_tx çağrısı */
+    uint32_t tx_busy;    /* -EBUSY ile reddedilen */
+    uint32_t tx_errors;  /* zsim_uart_tx_fail ile reddedilen */
+    uint32_t tx_done;
+    uint32_t tx_aborts;
+    uint32_t rx_enables;
+    uint32_t rx_bytes;   /* DMA buffer'ına yazılan */
+    uint32_t rx_lost;    /* RX kapalıyken hattan düşen */
+    uint32_t rx_rdy;     /* RX_RDY olayı */
+} zsim_uart_stats_t;
+
+typedef void (*zsim_uart_sink_t)(const uint8_t *buf, size_t len, void *user);
+
+void zsim_uart_set_baud(uint32_t baud);
+/* Bir karakterin (8N1, 10 bit) hattaki süresi */
+int64_t zsim_uart_char_ns(void);
+/* Sonraki n uart_tx çağrısı rc ile reddedilir */
+void zsim_uart_tx_fail(unsigned int n, int rc);
+/* true: başlatılan transfer hiç tamamlanmaz (CTS'i düşük kalan hat); false
+ * takılı transferi normal süresinde bitirir */
+void zsim_uart_tx_stuck(bool stuck);
+/* Tamamlanan her TX transferi: kabloya, sink'e ve loopback'te kendi RX'ine */
+void zsim_uart_set_sink(zsim_uart_sink_t sink, void *user);
+void zsim_uart_set_loopback(bool on);
+const uint8_t *zsim_uart_wire(size_t *len);
+void zsim_uart_wire_clear(void);
+
+/* Karşı taraftan gelen baytlar: şimdiden itibaren karakter süresi arayla */
+void zsim_uart_feed(const uint8_t *buf, size_t len);
+/* RX hatası: RX_STOPPED ve ardından RX kapanışı (RX_BUF_RELEASED, RX_DISABLED) */
+void zsim_uart_rx_error(enum uart_rx_stop_reason reason);
+/* Kayıtlı olay dizisini oynatmak için: olayı doğrudan ISR bağlamında ver */
+void zsim_uart_event(struct uart_event *evt);
+
+/* Sürücü kaydı (ör. gerçek kartta loglanan olaylar), hat beslenmezken uart_io'nun
+ * verdiği DMA buffer'larıyla oynatılır:
+ *  RDY     bytes'ın sıradaki len baytını kullanımdaki buffer'a offset'ten yazar ve
+ *          RX_RDY(offset, len) verir; offset buffer'da yazılan son konum olmalı
+ *  NEXT    sıradaki buffer'a geçer (olay yok); eskisi RELEASE'e kadar tutulur
+ *  RELEASE tutulan eski buffer için RX_BUF_RELEASED (NEXT'ten sonra RDY'ler: geç bırakma)
+ *  REQUEST RX_BUF_REQUEST; uart_io yanıtı sıradaki buffer olur
+ *  STOP    zsim_uart_rx_error(UART_ERROR_OVERRUN); tutulan eski buffer da bırakılır
+ *  GAP     len mikrosaniye geçer (drain ve dağıtım çalışır)
+ * Kayıt sürücüyle çelişirse test durur. bytes'tan kullanılan bayt sayısını döner. */
+typedef enum
+{
+    ZSIM_RX_RDY,
+    ZSIM_RX_NEXT,
+    ZSIM_RX_RELEASE,
+    ZSIM_RX_REQUEST,
+    ZSIM_RX_STOP,
+    ZSIM_RX_GAP,
+} zsim_rx_op_t;
+
+typedef struct
+{
+    zsim_rx_op_t op;
+    uint16_t offset, len;
+} zsim_rx_rec_t;
+
+size_t zsim_uart_rx_replay(const zsim_rx_rec_t *rec, size_t n, const uint8_t *bytes);
+
+/* Son uart_line_ctrl_set(RTS) değeri; rc: sonraki çağrıların dönüşü */
+uint32_t zsim_uart_rts(void);
+void zsim_uart_set_line_ctrl_rc(int rc);
+
+const zsim_uart_stats_t *zsim_uart_stats(void);
+
+/* Thread bağlamında her ring_buf okuma claim'inden sonra (ring_buf_get dahil)
+ * çağrılır: claim tutulurken gelen kesmeyi taklit eder. NULL kapatır. */
+void zsim_ring_buf_get_hook(void (*fn)(void *arg), void *arg);
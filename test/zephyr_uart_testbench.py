@@ -7,6 +7,12 @@ Zephyr Async UART Testbench (TX/RX) - Python
 - CRC is computed over LEN + DATA, with init=0xFFFF, poly=0x1021 (no final XOR)
 - Supports large transfers using a 7-byte segmentation header inside DATA:
     typ(1), xid(1), total(2BE), offset(2BE), clen(1)
+- With --jumbo (CONFIG_CUSTOM_UART_JUMBO), DATA longer than 64B goes in a jumbo
+  frame [SYNC=0xAB][LEN(2BE)][DATA...][CRC16] and segments carry SEG_F_JUMBO
+  with an 8-byte header (clen is 2BE)
+- With --lz (CONFIG_CUSTOM_UART_LZ), segmented sends compress each segment
+  against the transfer so far and flag it SEG_F_LZ; received SEG_F_LZ
+  segments are always decoded, in order only
 - Receives and parses incoming frames, verifies CRC, and reassembles segments.
 
 Requires: pyserial  (pip install pyserial)
@@ -17,10 +23,16 @@ Usage examples:
   python zephyr_uart_testbench.py --port /dev/ttyUSB0 --send-hex "01 02 AA FF"
   python zephyr_uart_testbench.py --port /dev/ttyUSB0 --send-file sample.bin --xid 3
   python zephyr_uart_testbench.py --port /dev/ttyUSB0 --send-hex "00 01 ... 70B" --buffer-mode
+  python zephyr_uart_testbench.py --port /dev/ttyUSB0 --send-file sample.bin --jumbo
+  python zephyr_uart_testbench.py --port /dev/ttyUSB0 --send-file config.txt --lz
   python zephyr_uart_testbench.py --port /dev/ttyUSB0 --send-hex "20 0D 48 65 6C 6C 6F 20 54 4C 56 21" # 0x20=TEXT, 0x0D=13, "Hello TLV!"
+  python zephyr_uart_testbench.py --port /dev/ttyUSB0 --send-tlv 02:80 --send-tlv 03:01 --send-tlv 04:02 --tlv  # LED, BUZZER, RISK in one frame
+  python zephyr_uart_testbench.py --port /dev/ttyUSB0 --stats --exit-after-send
 """
 
 import argparse
+import queue
+import struct
 import sys
 import threading
 import time
@@ -37,12 +49,62 @@ except Exception as e:  # pragma: no cover
 SYNC_BYTE = 0xAA
 UART_MAX_PACKET_SIZE = 64          # len(DATA) upper bound
 SEG_HDR_SIZE = 7                   # typ(1), xid(1), total(2), offset(2), clen(1)
+SEG_HDR_JUMBO_SIZE = 8             # SEG_F_JUMBO: clen is 2 bytes
+JUMBO_SYNC_BYTE = 0xAB             # CONFIG_CUSTOM_UART_JUMBO_SYNC_BYTE, LEN is 2BE
+JUMBO_MAX_SIZE = 2048              # CONFIG_CUSTOM_UART_JUMBO_MAX_SIZE (set by --jumbo-max)
+LZ_HASH_BITS = 8                   # CONFIG_CUSTOM_UART_LZ_HASH_BITS; only affects the ratio
+LZ_MIN_MATCH = 4
 SEG_TYP_DATA = 0x01
+SEG_TYP_ACK = 0x02
+SEG_TYP_FLOW = 0x03                # device RX backpressure (CONFIG_CUSTOM_UART_FLOW_CTRL)
+SEG_FLOW_RESUME = 0x00
+SEG_FLOW_PAUSE = 0x01
+SEG_TYP_MASK = 0x0F
+SEG_F_ACKREQ = 0x80                # sender wants cumulative/selective ACKs
+SEG_F_LZ = 0x40                    # LZ segment: clen is the compressed size, offset stays raw-aligned
+SEG_F_JUMBO = 0x20                 # jumbo segment: 8-byte header, PAYLOAD_JUMBO_MAX alignment
+SEG_ACK_BITMAP_SIZE = 4            # ACK DATA: seg header + BE32 selective bitmap
 CRC_INIT = 0xFFFF                  # CRC16-CCITT initial value
+COBS_DELIM = 0x00                  # CONFIG_CUSTOM_UART_COBS frame delimiter
+USE_COBS = False                   # set by --cobs; must match the firmware build
+USE_JUMBO = False                  # set by --jumbo; must match the firmware build
+STATS_TLV_ID = 0x07                # CONFIG_CUSTOM_UART_STATS_TLV_ID
+STATS_PAGE_HDR = 4                 # page(1), npages(1), total words(2BE), then BE32 words
+STATS_HIST_BUCKETS = 32            # log2 cycle buckets per histogram
+STATS_HISTS = ("rx_lat", "tx_lat") # RX_RDY -> rx_cb, enqueue -> TX_DONE
+# Counter order of UART_STATS_LIST in uart_stats.h; new counters are appended there
+STATS_FIELDS = (
+    "rx_bytes", "rx_frames", "rx_len_err", "rx_crc_err", "rx_budget_err", "rx_cobs_err",
+    "rx_drop_bytes", "rx_ovf_gaps", "rx_ovf_evict", "rx_ovf_cut", "rx_pool_empty", "rx_q_full",
+    "rx_prio_drop",
+    "tx_bytes", "tx_frames", "tx_xfers", "tx_max_batch", "tx_timeouts", "tx_aborts", "tx_errors",
+    "tx_nobufs",
+    "rb_hwm", "rxq_hwm", "txq_hwm",
+    "flow_pause", "flow_tx_err",
+    "reasm_done", "reasm_dup", "reasm_bad", "reasm_too_big", "reasm_no_slot", "reasm_timeout",
+    "reasm_acks",
+    "rel_segs", "rel_retx", "rel_acks", "rel_fail",
+    "rx_retune", "rx_buf_none",
+    "reasm_lz_err",
+)
 
 # Derived
 PAYLOAD_MAX = UART_MAX_PACKET_SIZE - SEG_HDR_SIZE
 
+def frame_len_max() -> int:
+    """Largest DATA one frame may carry (UART_FRAME_LEN_MAX)."""
+    return JUMBO_MAX_SIZE if USE_JUMBO else UART_MAX_PACKET_SIZE
+
+def payload_jumbo_max() -> int:
+    return JUMBO_MAX_SIZE - SEG_HDR_JUMBO_SIZE
+
+def seg_hdr_size(typ: int) -> int:
+    return SEG_HDR_JUMBO_SIZE if typ & SEG_F_JUMBO else SEG_HDR_SIZE
+
+def seg_payload_max(typ: int) -> int:
+    """Segment alignment: every segment but the last carries exactly this much."""
+    return payload_jumbo_max() if typ & SEG_F_JUMBO else PAYLOAD_MAX
+
 # ---- CRC16-CCITT (False) ----
 def crc16_ccitt_step(crc: int, b: int) -> int:
     """Single-byte CCITT step. Poly 0x1021, init 0xFFFF, no final xor, no reflection."""
@@ -66,37 +128,194 @@ def seg_hdr_write(typ: int, xid: int, total: int, offset: int, clen: int) -> byt
     assert 0 <= xid <= 0xFF
     assert 0 <= total <= 0xFFFF
     assert 0 <= offset <= 0xFFFF
+    hdr = bytes([typ, xid, (total >> 8) & 0xFF, total & 0xFF, (offset >> 8) & 0xFF, offset & 0xFF])
+    if typ & SEG_F_JUMBO:
+        assert 0 <= clen <= 0xFFFF
+        return hdr + struct.pack(">H", clen)
     assert 0 <= clen <= 0xFF
-    return bytes([typ, xid, (total >> 8) & 0xFF, total & 0xFF, (offset >> 8) & 0xFF, offset & 0xFF, clen])
+    return hdr + bytes([clen])
 
 def seg_hdr_read(buf: bytes) -> Tuple[int,int,int,int,int]:
-    """Returns (typ, xid, total, offset, clen). Expects at least 7 bytes."""
+    """Returns (typ, xid, total, offset, clen). Expects at least seg_hdr_size(buf[0]) bytes."""
     typ = buf[0]
     xid = buf[1]
     total = (buf[2] << 8) | buf[3]
     offset = (buf[4] << 8) | buf[5]
-    clen = buf[6]
+    if typ & SEG_F_JUMBO:
+        clen = (buf[6] << 8) | buf[7]
+    else:
+        clen = buf[6]
     return typ, xid, total, offset, clen
 
+# ---- COBS (same encoder as include/cobs.h) ----
+def cobs_encode(data: bytes) -> bytes:
+    out = bytearray([0])
+    code_pos = 0
+    for b in data:
+        if b == 0:
+            out[code_pos] = len(out) - code_pos
+            code_pos = len(out)
+            out.append(0)
+            continue
+        out.append(b)
+        if len(out) - code_pos == 0xFF:
+            out[code_pos] = 0xFF
+            code_pos = len(out)
+            out.append(0)
+    out[code_pos] = len(out) - code_pos
+    return bytes(out)
+
+def cobs_decode(enc: bytes) -> Optional[bytes]:
+    """Decode one frame body (no delimiters). None if malformed."""
+    out = bytearray()
+    i = 0
+    while i < len(enc):
+        code = enc[i]
+        if code == 0 or i + code > len(enc):
+            return None
+        out += enc[i + 1:i + code]
+        i += code
+        if code != 0xFF and i < len(enc):
+            out.append(0)
+    return bytes(out)
+
 # ---- Frame builder/parser ----
 def build_frame(payload: bytes) -> bytes:
-    """Construct a single frame: SYNC, LEN, DATA=payload, CRC (big-endian)."""
-    if not (0 < len(payload) <= UART_MAX_PACKET_SIZE):
-        raise ValueError(f"payload length must be 1..{UART_MAX_PACKET_SIZE}, got {len(payload)}")
+    """Construct a single frame: SYNC, LEN, DATA=payload, CRC (big-endian).
+    With USE_COBS: 0x00, COBS(LEN, DATA, CRC), 0x00.
+    With USE_JUMBO and DATA > 64B: JUMBO_SYNC, LEN(2BE), DATA, CRC over both LEN bytes."""
+    if not (0 < len(payload) <= frame_len_max()):
+        raise ValueError(f"payload length must be 1..{frame_len_max()}, got {len(payload)}")
+    if len(payload) > UART_MAX_PACKET_SIZE:
+        hdr = struct.pack(">H", len(payload))
+        crc = crc16_ccitt(hdr + payload, init=CRC_INIT)
+        return bytes([JUMBO_SYNC_BYTE]) + hdr + payload + struct.pack(">H", crc)
     # CRC covers LEN + DATA (per Zephyr framer.c logic)
     crc = crc16_ccitt(bytes([len(payload)]) + payload, init=CRC_INIT)
-    return bytes([SYNC_BYTE, len(payload)]) + payload + bytes([(crc >> 8) & 0xFF, crc & 0xFF])
-
-def build_large_frames(data: bytes, xid: int = 1) -> List[bytes]:
-    """Split 'data' into multiple frames using 7-byte segment header inside DATA."""
+    body = bytes([len(payload)]) + payload + bytes([(crc >> 8) & 0xFF, crc & 0xFF])
+    if USE_COBS:
+        return bytes([COBS_DELIM]) + cobs_encode(body) + bytes([COBS_DELIM])
+    return bytes([SYNC_BYTE]) + body
+
+# ---- LZ segment compression (lz.h / lz.c) ----
+# seq := token [ext*] literals [ofs(2BE) [ext*]], token = (nlit << 4) | (mlen - 4),
+# a nibble of 15 continues in ext bytes (255 = more). Matches reach back into
+# earlier segments of the same transfer.
+def _lz_hash(b: bytes, i: int) -> int:
+    v = b[i] | (b[i+1] << 8) | (b[i+2] << 16) | (b[i+3] << 24)
+    return ((v * 2654435761) & 0xFFFFFFFF) >> (32 - LZ_HASH_BITS)
+
+def _lz_ext(out: bytearray, n: int):
+    if n < 15:
+        return
+    n -= 15
+    while n >= 255:
+        out.append(255)
+        n -= 255
+    out.append(n)
+
+def _lz_emit(out: bytearray, lit: bytes, ofs: int, mlen: int):
+    m = mlen - LZ_MIN_MATCH if mlen else 0
+    out.append((min(len(lit), 15) << 4) | min(m, 15))
+    _lz_ext(out, len(lit))
+    out += lit
+    if mlen:
+        out += struct.pack(">H", ofs)
+        _lz_ext(out, m)
+
+class LzEncoder:
+    """Same greedy single-candidate search as lz_enc_block(); one per transfer."""
+    def __init__(self, base: bytes):
+        self.base = base
+        self.table: Dict[int, int] = {}
+
+    def block(self, pos: int, n: int, cap: int) -> Optional[bytes]:
+        """Compress base[pos:pos+n]; None when the result exceeds cap (send raw)."""
+        src, end, anchor, i = self.base, pos + n, pos, pos
+        out = bytearray()
+        while i + LZ_MIN_MATCH <= end:
+            h = _lz_hash(src, i)
+            cand = self.table.get(h)
+            self.table[h] = i
+            if cand is None or src[cand:cand+LZ_MIN_MATCH] != src[i:i+LZ_MIN_MATCH]:
+                i += 1
+                continue
+            m = LZ_MIN_MATCH
+            while i + m < end and src[cand+m] == src[i+m]:
+                m += 1
+            _lz_emit(out, src[anchor:i], i - cand, m)
+            if len(out) > cap:
+                return None
+            for k in range(i + 1, min(i + m, end - LZ_MIN_MATCH + 1)):
+                self.table[_lz_hash(src, k)] = k
+            i += m
+            anchor = i
+        if anchor < end:
+            _lz_emit(out, src[anchor:end], 0, 0)
+        return bytes(out) if len(out) <= cap else None
+
+def lz_decompress_into(src: bytes, buf: bytearray, pos: int, cap: int) -> Optional[int]:
+    """Decode src into buf[pos:pos+cap] with buf[:pos] as history; length or None if malformed."""
+    i, o, n = 0, pos, len(src)
+    def ext(v: int) -> Optional[int]:
+        nonlocal i
+        if v < 15:
+            return v
+        while True:
+            if i >= n:
+                return None
+            b = src[i]
+            i += 1
+            v += b
+            if b != 255:
+                return v
+    while i < n:
+        tok = src[i]
+        i += 1
+        nlit = ext(tok >> 4)
+        if nlit is None or n - i < nlit or pos + cap - o < nlit:
+            return None
+        buf[o:o+nlit] = src[i:i+nlit]
+        i += nlit
+        o += nlit
+        if i == n:
+            break
+        if n - i < 2:
+            return None
+        ofs = (src[i] << 8) | src[i+1]
+        i += 2
+        m = ext(tok & 15)
+        if m is None:
+            return None
+        m += LZ_MIN_MATCH
+        if ofs == 0 or ofs > o or pos + cap - o < m:
+            return None
+        for k in range(m):  # overlapping copy is intended (ofs < m repeats)
+            buf[o+k] = buf[o+k-ofs]
+        o += m
+    return o - pos
+
+def build_large_frames(data: bytes, xid: int = 1, lz: bool = False) -> List[bytes]:
+    """Split 'data' into multiple frames using 7-byte segment header inside DATA.
+    With USE_JUMBO, transfers that do not fit one legacy segment use jumbo segments.
+    With lz, segments that shrink go compressed with SEG_F_LZ, the rest raw."""
     frames = []
     total = len(data)
+    typ = SEG_TYP_DATA
+    if USE_JUMBO and total > PAYLOAD_MAX:
+        typ |= SEG_F_JUMBO
+    seg = seg_payload_max(typ)
+    enc = LzEncoder(data) if lz else None
     off = 0
     while off < total:
-        chunk = min(PAYLOAD_MAX, total - off)
-        hdr = seg_hdr_write(SEG_TYP_DATA, xid, total, off, chunk)
-        payload = hdr + data[off:off+chunk]
-        frames.append(build_frame(payload))
+        chunk = min(seg, total - off)
+        body = enc.block(off, chunk, chunk - 1) if enc else None
+        if body is not None:
+            hdr = seg_hdr_write(typ | SEG_F_LZ, xid, total, off, len(body))
+        else:
+            hdr = seg_hdr_write(typ, xid, total, off, chunk)
+            body = data[off:off+chunk]
+        frames.append(build_frame(hdr + body))
         off += chunk
     return frames
 
@@ -106,7 +325,7 @@ def build_buffer_frames(data: bytes) -> List[bytes]:
     off = 0
     total = len(data)
     while off < total:
-        chunk = min(UART_MAX_PACKET_SIZE, total - off)
+        chunk = min(frame_len_max(), total - off)
         payload = data[off:off+chunk]
         frames.append(build_frame(payload))
         off += chunk
@@ -119,11 +338,14 @@ class ParsedFrame:
 
 # Stream parser (same state order as the Zephyr framer)
 class StreamParser:
-    ST_SYNC, ST_LEN, ST_DATA, ST_CRC_H, ST_CRC_L = range(5)
+    ST_SYNC, ST_LEN, ST_DATA, ST_CRC_H, ST_CRC_L, ST_LEN_H = range(6)
 
-    def __init__(self, on_frame):
+    def __init__(self, on_frame, cobs: Optional[bool] = None):
+        self.cobs = USE_COBS if cobs is None else cobs
+        self.enc_buf = bytearray()
         self.state = self.ST_SYNC
         self.len = 0
+        self.sync = SYNC_BYTE
         self.data_buf = bytearray()
         self.crc_calc = CRC_INIT
         self.crc_hi_tmp = 0
@@ -132,27 +354,57 @@ class StreamParser:
     def reset(self):
         self.state = self.ST_SYNC
         self.len = 0
+        self.sync = SYNC_BYTE
         self.data_buf.clear()
         self.crc_calc = CRC_INIT
         self.crc_hi_tmp = 0
 
     def feed(self, chunk: bytes):
+        if self.cobs:
+            self._feed_cobs(chunk)
+            return
         for b in chunk:
             self._push_byte(b)
 
+    def _feed_cobs(self, chunk: bytes):
+        # every 0x00 is a frame boundary; junk between frames fails the checks below
+        parts = bytes(chunk).split(bytes([COBS_DELIM]))
+        self.enc_buf += parts[0]
+        for part in parts[1:]:
+            if self.enc_buf:
+                body = cobs_decode(bytes(self.enc_buf))
+                if body and len(body) >= 4 and body[0] == len(body) - 3 and 0 < body[0] <= UART_MAX_PACKET_SIZE:
+                    crc = crc16_ccitt(body[:-2], init=CRC_INIT)
+                    if crc == ((body[-2] << 8) | body[-1]):
+                        raw = bytes([COBS_DELIM]) + bytes(self.enc_buf) + bytes([COBS_DELIM])
+                        try:
+                            self.on_frame(ParsedFrame(data=body[1:-2], raw=raw))
+                        except Exception as e:
+                            print(f"[parser] on_frame error: {e}", file=sys.stderr)
+            self.enc_buf = bytearray(part)
+
     def _push_byte(self, b: int):
         if self.state == self.ST_SYNC:
-            if b == SYNC_BYTE:
-                self.state = self.ST_LEN
+            if b == SYNC_BYTE or (USE_JUMBO and b == JUMBO_SYNC_BYTE):
+                self.sync = b
+                self.state = self.ST_LEN if b == SYNC_BYTE else self.ST_LEN_H
+                self.len = 0
                 self.crc_calc = CRC_INIT
                 self.data_buf.clear()
             return
 
+        if self.state == self.ST_LEN_H:
+            self.len = b << 8
+            self.crc_calc = crc16_ccitt_step(self.crc_calc, b)
+            self.state = self.ST_LEN
+            return
+
         if self.state == self.ST_LEN:
-            if b == 0 or b > UART_MAX_PACKET_SIZE:
+            n = self.len | b
+            if n == 0 or n > (UART_MAX_PACKET_SIZE if self.sync == SYNC_BYTE else JUMBO_MAX_SIZE):
                 self.reset()
                 return
-            self.len = b
+            self.len = n
             self.crc_calc = crc16_ccitt_step(self.crc_calc, b)  # include LEN
             self.state = self.ST_DATA
             return
@@ -172,7 +424,11 @@ class StreamParser:
         if self.state == self.ST_CRC_L:
             recv_crc = ((self.crc_hi_tmp << 8) | b) & 0xFFFF
             if recv_crc == self.crc_calc:
-                raw = bytes([SYNC_BYTE, self.len]) + bytes(self.data_buf) + bytes([self.crc_hi_tmp, b])
+                if self.sync == SYNC_BYTE:
+                    hdr = bytes([SYNC_BYTE, self.len])
+                else:
+                    hdr = bytes([self.sync]) + struct.pack(">H", self.len)
+                raw = hdr + bytes(self.data_buf) + bytes([self.crc_hi_tmp, b])
                 try:
                     self.on_frame(ParsedFrame(data=bytes(self.data_buf), raw=raw))
                 except Exception as e:
@@ -180,49 +436,224 @@ class StreamParser:
             self.reset()
             return
 
+# ---- Multi-record TLV (same layout as tlv_append / tlv_iter_next) ----
+def tlv_pack(records: List[Tuple[int, bytes]]) -> List[bytes]:
+    """Pack (id, value) records back to back into as few frame payloads as possible."""
+    payloads: List[bytes] = []
+    cur = bytearray()
+    for tid, value in records:
+        if not (0 <= tid <= 0xFF) or len(value) > UART_MAX_PACKET_SIZE - 2:
+            raise ValueError(f"bad TLV id={tid} len={len(value)}")
+        rec = bytes([tid, len(value)]) + value
+        if cur and len(cur) + len(rec) > frame_len_max():
+            payloads.append(bytes(cur))
+            cur = bytearray()
+        cur += rec
+    if cur:
+        payloads.append(bytes(cur))
+    return payloads
+
+def tlv_records(data: bytes) -> Optional[List[Tuple[int, bytes]]]:
+    """Every record of a frame DATA, or None if a record runs past the end."""
+    out = []
+    i = 0
+    while i < len(data):
+        if len(data) - i < 2 or data[i + 1] > len(data) - i - 2:
+            return None
+        n = data[i + 1]
+        out.append((data[i], bytes(data[i + 2:i + 2 + n])))
+        i += 2 + n
+    return out
+
+def parse_tlv_arg(s: str) -> Tuple[int, bytes]:
+    """'ID:HEX' -> (id, value), e.g. '02:80' or '0x20:48 69'."""
+    tid, _, value = s.partition(":")
+    return int(tid, 16), parse_hex_bytes(value) if value.strip() else b""
+
 # ---- Reassembly for segmented payloads ----
 @dataclass
 class Reassembly:
     total: int
     buf: bytearray = field(default_factory=bytearray)
     received: int = 0
+    segs: set = field(default_factory=set)
+    rel: bool = False
+    cum: int = 0                   # first missing segment index
+    seg: int = PAYLOAD_MAX         # segment alignment, seg_payload_max(typ)
+    since_ack: int = 0
+    done: bool = False             # reliable transfer finished, re-ACK late duplicates
+
+def build_ack(xid: int, total: int, cum_off: int, sack: int) -> bytes:
+    return seg_hdr_write(SEG_TYP_ACK, xid, total, cum_off, SEG_ACK_BITMAP_SIZE) + struct.pack(">I", sack)
+
+def parse_ack(data: bytes) -> Optional[Tuple[int, int, int, int]]:
+    """Return (xid, total, cum_off, sack) for an ACK frame, else None."""
+    if len(data) != SEG_HDR_SIZE + SEG_ACK_BITMAP_SIZE:
+        return None
+    typ, xid, total, offset, clen = seg_hdr_read(data[:SEG_HDR_SIZE])
+    if typ != SEG_TYP_ACK or clen != SEG_ACK_BITMAP_SIZE:
+        return None
+    (sack,) = struct.unpack(">I", data[SEG_HDR_SIZE:])
+    return (xid, total, offset, sack)
+
+def parse_flow(data: bytes) -> Optional[bool]:
+    """Return True for PAUSE, False for RESUME, None if not a FLOW frame."""
+    if len(data) != SEG_HDR_SIZE + 1:
+        return None
+    typ, _xid, _total, _offset, clen = seg_hdr_read(data[:SEG_HDR_SIZE])
+    if typ != SEG_TYP_FLOW or clen != 1:
+        return None
+    return data[SEG_HDR_SIZE] == SEG_FLOW_PAUSE
+
+def parse_stats_page(data: bytes) -> Optional[Tuple[int, int, int, List[int]]]:
+    """Return (page, npages, total_words, words) for a stats reply, else None."""
+    if len(data) < 2 + STATS_PAGE_HDR or data[0] != STATS_TLV_ID or data[1] != len(data) - 2:
+        return None
+    page, npages, total = struct.unpack(">BBH", data[2:2 + STATS_PAGE_HDR])
+    body = data[2 + STATS_PAGE_HDR:]
+    if len(body) % 4:
+        return None
+    words = list(struct.unpack(f">{len(body) // 4}I", body))
+    return (page, npages, total, words)
+
+def print_stats(words: List[int]):
+    """words: cyc_per_sec, counters (STATS_FIELDS order), optional histograms."""
+    cyc = words[0] or 1
+    counters = words[1:1 + len(STATS_FIELDS)]
+    rest = words[1 + len(STATS_FIELDS):]
+    for name, v in zip(STATS_FIELDS, counters):
+        print(f"[STATS] {name:<14} {v}")
+    if len(rest) != len(STATS_HISTS) * STATS_HIST_BUCKETS:
+        if rest:
+            print(f"[STATS] {len(rest)} extra words (firmware newer than testbench?)")
+        return
+    for h, name in enumerate(STATS_HISTS):
+        hist = rest[h * STATS_HIST_BUCKETS:(h + 1) * STATS_HIST_BUCKETS]
+        for i, n in enumerate(hist):
+            if n:
+                print(f"[STATS] {name} < {(2 << i) * 1e6 / cyc:10.2f} us: {n}")
+
+class FlowGate:
+    """
+    Honours the device's PAUSE/RESUME frames. wait() blocks new frames while
+    paused; a PAUSE expires after `timeout` seconds so a lost RESUME cannot
+    stall the link (the device re-sends PAUSE while it is still full).
+    """
+    def __init__(self, timeout: float = 0.5, enabled: bool = True):
+        self.timeout = timeout
+        self.enabled = enabled
+        self.pauses = 0
+        self._cv = threading.Condition()
+        self._until = 0.0
+
+    def pause(self):
+        with self._cv:
+            self.pauses += 1
+            self._until = time.monotonic() + self.timeout
+
+    def resume(self):
+        with self._cv:
+            self._until = 0.0
+            self._cv.notify_all()
+
+    def wait(self):
+        if not self.enabled:
+            return
+        with self._cv:
+            while True:
+                left = self._until - time.monotonic()
+                if left <= 0:
+                    return
+                self._cv.wait(left)
+
+FLOW = FlowGate()                  # shared by the TX helpers; ACKs bypass it
+
+def write_frame(ser: serial.Serial, frame: bytes, lock: Optional[threading.Lock] = None):
+    FLOW.wait()
+    if lock is None:
+        ser.write(frame)
+        ser.flush()
+        return
+    with lock:
+        ser.write(frame)
+        ser.flush()
 
 class SegmentReassembler:
     """
-    Detects 7-byte segment headers inside the frame DATA and reassembles
-    multi-frame transfers keyed by (xid).
+    Detects 7/8-byte segment headers inside the frame DATA and reassembles
+    multi-frame transfers keyed by (xid). Segments flagged SEG_F_ACKREQ are
+    acknowledged through ack_cb(bytes) the same way the device does it.
     """
-    def __init__(self):
+    def __init__(self, ack_cb=None, window: int = 8):
         self.active: Dict[int, Reassembly] = {}
+        self.ack_cb = ack_cb
+        self.ack_every = max(1, window // 2)
+
+    def _send_ack(self, xid: int, R: Reassembly):
+        sack = 0
+        for i in range(32):
+            if R.cum + 1 + i in R.segs:
+                sack |= 1 << i
+        R.since_ack = 0
+        if self.ack_cb:
+            self.ack_cb(build_ack(xid, R.total, min(R.cum * R.seg, R.total), sack))
 
     def try_handle(self, data: bytes) -> Optional[Tuple[int, bytes, bool]]:
         """
         If data looks like a segmented payload, accumulate and return (xid, full_bytes, done).
         If not segmented, return None.
         """
-        if len(data) < SEG_HDR_SIZE:
+        if len(data) < SEG_HDR_SIZE or len(data) < seg_hdr_size(data[0]):
             return None
-        typ, xid, total, offset, clen = seg_hdr_read(data[:SEG_HDR_SIZE])
-        if typ != SEG_TYP_DATA:
+        typ, xid, total, offset, clen = seg_hdr_read(data)
+        hl = seg_hdr_size(typ)
+        seg = seg_payload_max(typ)
+        if (typ & SEG_TYP_MASK) != SEG_TYP_DATA:
             return None
-        if clen != len(data) - SEG_HDR_SIZE:
+        if clen != len(data) - hl:
             return None
-        if offset + clen > total:
+        if offset + clen > total or offset % seg:
             return None
+        rel = bool(typ & SEG_F_ACKREQ)
+        lz = bool(typ & SEG_F_LZ)
+        ulen = min(seg, total - offset) if lz else clen
 
         R = self.active.get(xid)
-        if R is None:
-            R = Reassembly(total=total, buf=bytearray(total), received=0)
+        if R is None or R.total != total or R.seg != seg or (R.done and not rel):
+            R = Reassembly(total=total, buf=bytearray(total), received=0, rel=rel, seg=seg)
             self.active[xid] = R
 
-        R.buf[offset:offset+clen] = data[SEG_HDR_SIZE:SEG_HDR_SIZE+clen]
-        R.received += clen
+        idx = offset // seg
+        if R.done or idx in R.segs:
+            # duplicate: the sender may have missed our ACK
+            if R.rel:
+                self._send_ack(xid, R)
+            return (xid, bytes(R.buf), False)
+
+        if lz:
+            # history is buf[:offset]: only the next missing segment can be decoded
+            if idx != R.cum or lz_decompress_into(data[hl:hl+clen], R.buf, offset, ulen) != ulen:
+                return (xid, bytes(R.buf), False)
+        else:
+            R.buf[offset:offset+clen] = data[hl:hl+clen]
+        R.received += ulen
+        R.segs.add(idx)
+        R.since_ack += 1
+        gap = idx != R.cum
+        while R.cum in R.segs:
+            R.cum += 1
 
         done = (R.received >= R.total)
         if done:
             payload = bytes(R.buf[:R.total])
-            del self.active[xid]
+            if R.rel:
+                self._send_ack(xid, R)
+                R.done = True
+            else:
+                del self.active[xid]
             return (xid, payload, True)
+        if R.rel and (gap or R.since_ack >= self.ack_every):
+            self._send_ack(xid, R)
         return (xid, bytes(R.buf), False)
 
 # ---- Hex helpers ----
@@ -245,19 +676,45 @@ def parse_hex_bytes(s: str) -> bytes:
 
 # ---- Worker threads ----
 class RXWorker(threading.Thread):
-    def __init__(self, ser: serial.Serial, reasm: SegmentReassembler, verbose: bool = True):
+    def __init__(self, ser: serial.Serial, reasm: SegmentReassembler, verbose: bool = True, show_tlv: bool = False):
         super().__init__(daemon=True)
         self.ser = ser
         self.reasm = reasm
         self.verbose = verbose
+        self.show_tlv = show_tlv
+        self.acks: "queue.Queue[Tuple[int, int, int, int]]" = queue.Queue()
+        self.stats: "queue.Queue[Tuple[int, int, int, List[int]]]" = queue.Queue()
+        self.tx_lock = threading.Lock()   # RX thread writes ACKs while main thread sends
         self.parser = StreamParser(on_frame=self.on_frame)
         self._stop = threading.Event()
 
     def on_frame(self, pf: ParsedFrame):
         if self.verbose:
             print(f"[RX] Frame: LEN={len(pf.data)}  CRC OK  RAW={hexdump(pf.raw)}")
+        ack = parse_ack(pf.data)
+        if ack is not None:
+            self.acks.put(ack)
+            return
+        page = parse_stats_page(pf.data)
+        if page is not None:
+            self.stats.put(page)
+            return
+        flow = parse_flow(pf.data)
+        if flow is not None:
+            if flow:
+                FLOW.pause()
+            else:
+                FLOW.resume()
+            if self.verbose:
+                print(f"[RX] Flow: {'PAUSE' if flow else 'RESUME'}")
+            return
         seg = self.reasm.try_handle(pf.data)
         if seg is None:
+            recs = tlv_records(pf.data) if self.show_tlv else None
+            if recs:
+                for tid, value in recs:
+                    print(f"[RX] TLV id=0x{tid:02X} len={len(value)}: {hexdump(value)}")
+                return
             try:
                 txt = pf.data.decode('utf-8')
                 print(f"[RX] DATA (text): {txt!r}")
@@ -289,6 +746,11 @@ class RXWorker(threading.Thread):
                 print(f"[RX] Error: {e}", file=sys.stderr)
         print("[RX] Stopped.")
 
+    def send_locked(self, frame: bytes):
+        with self.tx_lock:
+            self.ser.write(frame)
+            self.ser.flush()
+
     def stop(self):
         self._stop.set()
 
@@ -297,29 +759,115 @@ def tx_send_frame(ser: serial.Serial, payload: bytes, delay: float = 0.0, verbos
     frame = build_frame(payload)
     if verbose:
         print(f"[TX] {len(payload)}B -> Frame {len(frame)}B: {hexdump(frame)}")
-    ser.write(frame)
-    ser.flush()
+    write_frame(ser, frame)
     if delay > 0:
         time.sleep(delay)
 
-def tx_send_large(ser: serial.Serial, data: bytes, xid: int = 1, per_frame_delay: float = 0.01, verbose: bool = True):
-    frames = build_large_frames(data, xid=xid)
+def tx_send_large(ser: serial.Serial, data: bytes, xid: int = 1, per_frame_delay: float = 0.01, verbose: bool = True,
+                  lz: bool = False):
+    frames = build_large_frames(data, xid=xid, lz=lz)
     for i, f in enumerate(frames):
         if verbose:
             print(f"[TX] Part {i+1}/{len(frames)}  Frame {len(f)}B: {hexdump(f)}")
-        ser.write(f)
-        ser.flush()
+        write_frame(ser, f)
         if per_frame_delay > 0:
             time.sleep(per_frame_delay)
 
+def tx_send_reliable(ser: serial.Serial, data: bytes, acks: "queue.Queue", xid: int = 1,
+                     window: int = 8, rto: float = 0.2, max_retries: int = 10,
+                     lock: Optional[threading.Lock] = None, verbose: bool = True) -> bool:
+    """
+    Sliding-window segmented send. Up to `window` segments are in flight;
+    cumulative + selective ACKs from the peer retire them and only the missing
+    offsets are retransmitted (on a hole in a SACK, or on RTO).
+    """
+    lock = lock or threading.Lock()
+    total = len(data)
+    nsegs = (total + PAYLOAD_MAX - 1) // PAYLOAD_MAX
+    acked = [False] * nsegs
+    sent_at = [0.0] * nsegs
+    base = nxt = retries = 0
+
+    def send(i: int):
+        off = i * PAYLOAD_MAX
+        chunk = data[off:off + PAYLOAD_MAX]
+        f = build_frame(seg_hdr_write(SEG_TYP_DATA | SEG_F_ACKREQ, xid, total, off, len(chunk)) + chunk)
+        write_frame(ser, f, lock)
+        sent_at[i] = time.monotonic()
+        if verbose:
+            print(f"[TX] Rel seg {i+1}/{nsegs} off={off}")
+
+    while base < nsegs:
+        while nxt < nsegs and nxt < base + window:
+            send(nxt)
+            nxt += 1
+        try:
+            a_xid, a_total, cum_off, sack = acks.get(timeout=rto)
+        except queue.Empty:
+            retries += 1
+            if retries > max_retries:
+                print(f"[TX] Reliable send xid={xid} gave up at segment {base}", file=sys.stderr)
+                return False
+            for i in range(base, nxt):
+                if not acked[i]:
+                    send(i)
+            continue
+        if a_xid != xid or a_total != total:
+            continue
+        cum = nsegs if cum_off >= total else cum_off // PAYLOAD_MAX
+        high = cum
+        for i in range(cum):
+            acked[i] = True
+        for b in range(32):
+            if sack & (1 << b) and cum + 1 + b < nsegs:
+                acked[cum + 1 + b] = True
+                high = cum + 1 + b
+        old = base
+        while base < nsegs and acked[base]:
+            base += 1
+        if base != old:
+            retries = 0
+        now = time.monotonic()
+        for i in range(base, min(high, nxt)):
+            if not acked[i] and now - sent_at[i] >= rto / 2:
+                send(i)
+    if verbose:
+        print(f"[TX] Reliable send xid={xid} complete ({total} bytes)")
+    return True
+
+def query_stats(ser: serial.Serial, replies: "queue.Queue", timeout: float = 0.5,
+                retries: int = 2, verbose: bool = True) -> Optional[List[int]]:
+    """Read every stats page; each page is requested until it answers."""
+    words: List[int] = []
+    page, npages = 0, 1
+    while page < npages:
+        for _ in range(retries + 1):
+            write_frame(ser, build_frame(bytes([STATS_TLV_ID, 1, page])))
+            try:
+                while True:
+                    p, n, total, w = replies.get(timeout=timeout)
+                    if p == page:
+                        break
+            except queue.Empty:
+                continue
+            break
+        else:
+            print(f"[STATS] no reply for page {page}", file=sys.stderr)
+            return None
+        npages = n
+        words += w
+        page += 1
+    if verbose:
+        print(f"[STATS] {npages} pages, {len(words)}/{total} words")
+    return words
+
 def tx_send_buffer(ser: serial.Serial, data: bytes, per_frame_delay: float = 0.01, verbose: bool = True):
-    """Send long data by raw slicing into <=64B frames (no segmentation header)."""
+    """Send long data by raw slicing into <=64B frames (<= JUMBO_MAX_SIZE with --jumbo), no segmentation header."""
     frames = build_buffer_frames(data)
     for i, f in enumerate(frames):
         if verbose:
             print(f"[TX] Slice {i+1}/{len(frames)}  Frame {len(f)}B: {hexdump(f)}")
-        ser.write(f)
-        ser.flush()
+        write_frame(ser, f)
         if per_frame_delay > 0:
             time.sleep(per_frame_delay)
 
@@ -332,29 +880,67 @@ def parse_args(argv=None):
     ap.add_argument("--send", help="Send a UTF-8 string as a single frame")
     ap.add_argument("--send-hex", help="Send hex bytes as a single frame (e.g., '01 02 AA')")
     ap.add_argument("--send-file", help="Send file contents using segmentation (multiple frames)")
+    ap.add_argument("--send-tlv", action="append", type=parse_tlv_arg, metavar="ID:HEX",
+                    help="TLV record to send (repeatable); records are packed into as few frames as fit")
+    ap.add_argument("--tlv", action="store_true", help="Print received DATA as TLV records when it parses as such")
     ap.add_argument("--xid", type=int, default=1, help="Segment transfer ID (default: 1)")
-    ap.add_argument("--repeat", type=int, default=1, help="Repeat count for --send/--send-hex (default: 1)")
+    ap.add_argument("--repeat", type=int, default=1, help="Repeat count for --send/--send-hex/--send-tlv (default: 1)")
     ap.add_argument("--per-frame-delay", type=float, default=0.01, help="Delay between frames in seconds (default: 0.01)")
+    ap.add_argument("--reliable", action="store_true", help="Segmented sends use sliding-window ACK/retransmit")
+    ap.add_argument("--window", type=int, default=8, help="Reliable mode segments in flight (default: 8, max 32)")
+    ap.add_argument("--rto", type=float, default=0.2, help="Reliable mode retransmission timeout in seconds (default: 0.2)")
+    ap.add_argument("--retries", type=int, default=10, help="Reliable mode timeouts without progress before giving up (default: 10)")
     ap.add_argument("--buffer-mode", action="store_true", help="If payload exceeds 64B, slice into multiple frames WITHOUT segmentation header")
+    ap.add_argument("--cobs", action="store_true", help="COBS framing (firmware built with CONFIG_CUSTOM_UART_COBS)")
+    ap.add_argument("--jumbo", action="store_true", help="Jumbo frames/segments above 64B (firmware built with CONFIG_CUSTOM_UART_JUMBO)")
+    ap.add_argument("--jumbo-max", type=int, default=JUMBO_MAX_SIZE, help=f"CONFIG_CUSTOM_UART_JUMBO_MAX_SIZE of the firmware (default: {JUMBO_MAX_SIZE})")
+    ap.add_argument("--lz", action="store_true", help="Compress segmented sends, not --reliable ones (firmware built with CONFIG_CUSTOM_UART_LZ)")
+    ap.add_argument("--rtscts", action="store_true", help="Hardware RTS/CTS flow control on the host port")
+    ap.add_argument("--no-flow", action="store_true", help="Ignore the device's in-band PAUSE/RESUME frames")
+    ap.add_argument("--pause-timeout", type=float, default=0.5, help="Max seconds a PAUSE holds TX without refresh (default: 0.5)")
+    ap.add_argument("--stats", action="store_true", help="Query and print the device's counters (CONFIG_CUSTOM_UART_STATS_TLV)")
+    ap.add_argument("--stats-id", type=lambda v: int(v, 0), default=STATS_TLV_ID, help=f"Stats query TLV id (default: {STATS_TLV_ID:#04x})")
     ap.add_argument("--quiet", action="store_true", help="Less verbose output")
     ap.add_argument("--exit-after-send", action="store_true", help="Exit after sending instead of staying in RX loop")
     return ap.parse_args(argv)
 
 def main(argv=None):
+    global USE_COBS, USE_JUMBO, JUMBO_MAX_SIZE, STATS_TLV_ID
     args = parse_args(argv)
     verbose = not args.quiet
+    if args.jumbo and args.cobs:
+        print("[ERR] --jumbo needs SYNC framing, not --cobs", file=sys.stderr)
+        return 2
+    if args.jumbo and not (256 <= args.jumbo_max <= 4096):
+        print("[ERR] --jumbo-max must be 256..4096", file=sys.stderr)
+        return 2
+    USE_COBS = args.cobs
+    USE_JUMBO = args.jumbo
+    JUMBO_MAX_SIZE = args.jumbo_max
+    STATS_TLV_ID = args.stats_id
+    FLOW.timeout = args.pause_timeout
+    FLOW.enabled = not args.no_flow
 
     # Open serial
     try:
-        ser = serial.Serial(args.port, args.baud, timeout=0.05, write_timeout=1.0)
+        ser = serial.Serial(args.port, args.baud, timeout=0.05, write_timeout=1.0, rtscts=args.rtscts)
     except Exception as e:
         print(f"[ERR] Could not open {args.port} at {args.baud}: {e}", file=sys.stderr)
         return 2
 
-    reasm = SegmentReassembler()
-    rx = RXWorker(ser, reasm, verbose=verbose)
+    reasm = SegmentReassembler(window=args.window)
+    rx = RXWorker(ser, reasm, verbose=verbose, show_tlv=args.tlv)
+    reasm.ack_cb = lambda ack: rx.send_locked(build_frame(ack))
     rx.start()
 
+    def send_segmented(data: bytes):
+        if args.reliable:
+            tx_send_reliable(ser, data, rx.acks, xid=args.xid, window=min(args.window, 32),
+                             rto=args.rto, max_retries=args.retries, lock=rx.tx_lock, verbose=verbose)
+        else:
+            tx_send_large(ser, data, xid=args.xid, per_frame_delay=args.per_frame_delay, verbose=verbose,
+                          lz=args.lz)
+
     try:
         if not args.rx_only:
             # Handle file first (segmented)
@@ -367,7 +953,7 @@ def main(argv=None):
                     return 3
                 if verbose:
                     print(f"[TX] Sending file {args.send_file} ({len(data)} bytes) xid={args.xid}")
-                tx_send_large(ser, data, xid=args.xid, per_frame_delay=args.per_frame_delay, verbose=verbose)
+                send_segmented(data)
 
             # Handle single-frame sends (string or hex)
             if args.send or args.send_hex:
@@ -381,17 +967,30 @@ def main(argv=None):
                         return 4
 
                 for i in range(args.repeat):
-                    if len(payload) <= UART_MAX_PACKET_SIZE:
+                    if len(payload) <= frame_len_max():
                         tx_send_frame(ser, payload, delay=args.per_frame_delay, verbose=verbose)
                     else:
                         if args.buffer_mode:
                             if verbose:
-                                print(f"[TX] Payload {len(payload)}B > {UART_MAX_PACKET_SIZE}. Using buffer-mode slicing.")
+                                print(f"[TX] Payload {len(payload)}B > {frame_len_max()}. Using buffer-mode slicing.")
                             tx_send_buffer(ser, payload, per_frame_delay=args.per_frame_delay, verbose=verbose)
                         else:
                             if verbose:
-                                print(f"[TX] Payload {len(payload)}B > {UART_MAX_PACKET_SIZE}. Using segmented transfer xid={args.xid}.")
-                            tx_send_large(ser, payload, xid=args.xid, per_frame_delay=args.per_frame_delay, verbose=verbose)
+                                print(f"[TX] Payload {len(payload)}B > {frame_len_max()}. Using segmented transfer xid={args.xid}.")
+                            send_segmented(payload)
+
+            if args.send_tlv:
+                payloads = tlv_pack(args.send_tlv)
+                if verbose:
+                    print(f"[TX] {len(args.send_tlv)} TLV records in {len(payloads)} frame(s)")
+                for _ in range(args.repeat):
+                    for payload in payloads:
+                        tx_send_frame(ser, payload, delay=args.per_frame_delay, verbose=verbose)
+
+            if args.stats:
+                words = query_stats(ser, rx.stats, verbose=verbose)
+                if words is not None:
+                    print_stats(words)
 
             if args.exit_after_send and not args.rx_only:
                 return 0